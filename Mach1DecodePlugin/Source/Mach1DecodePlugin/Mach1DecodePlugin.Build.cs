@@ -15,6 +15,10 @@ namespace UnrealBuildTool.Rules
         {
             PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
             
+            // The deterministic decode kernels must be the first to parse the glm headers they inline,
+            // inside their floating point region (Mach1DeterministicMath.h), which unity blobs would break
+            bUseUnity = false;
+
             PublicIncludePaths.Add("Developer/TargetPlatform/Public");
 
             // Add GLM include paths from ThirdParty
@@ -25,7 +29,7 @@ namespace UnrealBuildTool.Rules
             PublicDependencyModuleNames.AddRange(
                 new string[]
                 {
-                    "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "XRBase"
+                    "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "XRBase", "AudioMixer"
                 }
             );
         }
@@ -3,7 +3,10 @@
 //
 
 #include "M1DecodeActor.h"
+#include "M1DecodeWorldSubsystem.h"
+#include "M1DecodeDebugSubsystem.h"
 #include "Camera/CameraActor.h"
+#include "Sound/SoundWave.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #include "Mach1DecodePluginPrivatePCH.h"
@@ -49,7 +52,7 @@ void AM1DecodeActor::InitComponents(int32 MaxSpatialInputChannels)
 	RightChannelsMain.SetNum(MAX_INPUT_CHANNELS);
 
 	Volume = 1;
-	for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++) GainCoeffs.Add(1);
+	GainCoeffs.Init(1, MAX_INPUT_CHANNELS * 2);
 
 	m1Positional.setPlatformType(Mach1PlatformType::Mach1PlatformUE);
 	
@@ -87,26 +90,45 @@ void AM1DecodeActor::Init()
 			NullAttenuation->Attenuation.bAttenuate = false;
 			NullAttenuation->Attenuation.bSpatialize = true;
 
-			for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+			listenerAttachComponent = cameraComponent;
+
+			if (UsesSingleVoiceDecode())
+			{
+				decodeVoices.InitSingleVoice(this, listenerAttachComponent);
+			}
+			else
 			{
-				LeftChannelsMain[i] = NewObject <UAudioComponent>(cameraComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_L_%d"), GetUniqueID(), i)));
-				RightChannelsMain[i] = NewObject <UAudioComponent>(cameraComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_R_%d"), GetUniqueID(), i)));
+				InitIndividualChannels();
+			}
+
+			isInited = true;
+		}
+	}
+}
+
+void AM1DecodeActor::InitIndividualChannels()
+{
+	for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+	{
+		if (LeftChannelsMain[i])
+		{
+			continue; // already created for this channel count
+		}
 
-				LeftChannelsMain[i]->RegisterComponent(); // only for runtime
-				RightChannelsMain[i]->RegisterComponent(); // only for runtime
+		LeftChannelsMain[i] = NewObject <UAudioComponent>(listenerAttachComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_L_%d"), GetUniqueID(), i)));
+		RightChannelsMain[i] = NewObject <UAudioComponent>(listenerAttachComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_R_%d"), GetUniqueID(), i)));
 
-				LeftChannelsMain[i]->SetRelativeLocation(FVector(0, -1, 0));
-				RightChannelsMain[i]->SetRelativeLocation(FVector(0, 1, 0));
+		LeftChannelsMain[i]->RegisterComponent(); // only for runtime
+		RightChannelsMain[i]->RegisterComponent(); // only for runtime
 
-				LeftChannelsMain[i]->AttenuationSettings = NullAttenuation;
-				RightChannelsMain[i]->AttenuationSettings = NullAttenuation;
+		LeftChannelsMain[i]->SetRelativeLocation(FVector(0, -1, 0));
+		RightChannelsMain[i]->SetRelativeLocation(FVector(0, 1, 0));
 
-				LeftChannelsMain[i]->AttachToComponent(cameraComponent, FAttachmentTransformRules::KeepRelativeTransform); // AttachToComponent(Root, FAttachmentTransformRules::KeepRelativeTransform);//   AttachTo(sceneComponent);
-				RightChannelsMain[i]->AttachToComponent(cameraComponent, FAttachmentTransformRules::KeepRelativeTransform);
-			}
+		LeftChannelsMain[i]->AttenuationSettings = NullAttenuation;
+		RightChannelsMain[i]->AttenuationSettings = NullAttenuation;
 
-			isInited = true;
-		}
+		LeftChannelsMain[i]->AttachToComponent(listenerAttachComponent, FAttachmentTransformRules::KeepRelativeTransform); // AttachToComponent(Root, FAttachmentTransformRules::KeepRelativeTransform);//   AttachTo(sceneComponent);
+		RightChannelsMain[i]->AttachToComponent(listenerAttachComponent, FAttachmentTransformRules::KeepRelativeTransform);
 	}
 }
 
@@ -126,57 +148,64 @@ void AM1DecodeActor::SetSoundSet()
 		{
 		}
 
-		// MULTI-MONO MODE: Use individual mono files (now the only mode)
+		decodeVoices.IsSingleVoiceActive = UsesSingleVoiceDecode();
+		if (decodeVoices.IsSingleVoiceActive)
+		{
+			// SINGLE-VOICE MODE: one multichannel bed, decoded by the source effect
+			decodeVoices.InitSingleVoice(this, listenerAttachComponent);
+			SetupSingleVoicePlayback();
+		}
+		else
 		{
 			// INDIVIDUAL MONO CHANNELS MODE: Use separate mono files
+			InitIndividualChannels();
 			SetupIndividualChannelPlayback();
 		}
 	}
 }
 
-void AM1DecodeActor::Play()
+void AM1DecodeActor::QueueSynchronizedStart(FM1DecodeSyncStart& SyncStart, float startTime, float fadeIn)
+{
+	decodeLOD.StartPlayback(startTime, GetWorld()->GetAudioTimeSeconds());
+	decodeVoices.QueueSynchronizedStart(SyncStart, LeftChannelsMain, RightChannelsMain, MAX_INPUT_CHANNELS, startTime, fadeIn);
+}
+
+void AM1DecodeActor::PlayWith(FM1DecodeSyncStart& SyncStart)
 {
 	if (isInited)
 	{
-		// Multi-mono playbook: Perfect synchronization for all channels
-		// First, prepare all components
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Stop();
-				RightChannelsMain[i]->Stop();
-			}
-		}
-		
-		// Small delay to ensure all components are stopped
-		FPlatformProcess::Sleep(0.01f);
-		
-		// Now start all components simultaneously
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->FadeIn(fadeInDuration);
-				RightChannelsMain[i]->FadeIn(fadeInDuration);
-			}
-		}
-		
-		if (Debug)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, 
-				FString::Printf(TEXT("Playing Multi-Mono audio - Synchronized start (%d channels)"), GetRequiredChannelCount()));
-		}
+		QueueSynchronizedStart(SyncStart, 0, fadeInDuration);
 	}
-
-	if (!isInited)
+	else
 	{
 		needToPlayAfterInit = true;
 	}
 }
 
+void AM1DecodeActor::Play()
+{
+	// All voices are queued on the shared Quartz clock and begin on the same audio render block
+	FM1DecodeSyncStart SyncStart(this);
+	PlayWith(SyncStart);
+	SyncStart.Start();
+
+	if (Debug && isInited && !decodeVoices.IsSingleVoiceActive)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, 
+			FString::Printf(TEXT("Playing Multi-Mono audio - Synchronized start (%d channels)"), GetRequiredChannelCount()));
+	}
+}
+
 void AM1DecodeActor::Pause()
 {
+	decodeLOD.SetPaused(true);
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->SetPaused(true);
+		return;
+	}
+
 	if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
@@ -189,6 +218,14 @@ void AM1DecodeActor::Pause()
 
 void AM1DecodeActor::Resume()
 {
+	decodeLOD.SetPaused(false);
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->SetPaused(false);
+		return;
+	}
+
 	if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
@@ -201,31 +238,24 @@ void AM1DecodeActor::Resume()
 
 void AM1DecodeActor::Seek(float timeInSeconds)
 {
-	if (isInited)
+	if (isInited && decodeLOD.IsVirtualized() && decodeLOD.IsPlaybackStarted())
 	{
-		// For perfect synchronization, stop all first, then start all at the same time point
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Stop();
-				RightChannelsMain[i]->Stop();
-			}
-		}
-		
-		// Small delay to ensure synchronization
-		FPlatformProcess::Sleep(0.005f);
-		
-		// Start all at the exact same time position
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+		// nothing to restart: the voices pick up the new position once devirtualized
+		decodeLOD.SetPlaybackTime(timeInSeconds, GetWorld()->GetAudioTimeSeconds());
+
+		if (Debug)
 		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Play(timeInSeconds);
-				RightChannelsMain[i]->Play(timeInSeconds);
-			}
+			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Blue, 
+				FString::Printf(TEXT("Virtualized seek to %.2fs"), timeInSeconds));
 		}
-		
+	}
+	else if (isInited)
+	{
+		// Restart every voice at the same position on the same audio render block
+		FM1DecodeSyncStart SyncStart(this);
+		QueueSynchronizedStart(SyncStart, timeInSeconds, 0);
+		SyncStart.Start();
+
 		if (Debug)
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Blue, 
@@ -236,7 +266,13 @@ void AM1DecodeActor::Seek(float timeInSeconds)
 
 void AM1DecodeActor::Stop()
 {
-	if (isInited)
+	decodeLOD.StopPlayback();
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->FadeOut(fadeOutDuration, 0);
+	}
+	else if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
 		{
@@ -260,7 +296,26 @@ void AM1DecodeActor::BeginPlay()
 			SetSoundSet();
 			if (autoplay || needToPlayAfterInit) Play();
 		}
+
+		// Let the world subsystem tick this decoder with the listener it resolves once for all decoders
+		if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+		{
+			decodeSubsystem->RegisterDecoder(this);
+			SetActorTickEnabled(false);
+		}
+	}
+}
+
+void AM1DecodeActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+	{
+		decodeSubsystem->UnregisterDecoder(this);
 	}
+
+	decodeVoices.Release();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -268,11 +323,19 @@ void AM1DecodeActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	EvaluateDecode(UM1DecodeWorldSubsystem::ResolveListenerFrame(GetWorld()));
+	ApplyDecodeGains();
+}
+
+void AM1DecodeActor::EvaluateDecode(const FM1ListenerFrame& Listener)
+{
+	AdvancePlaybackTime(Listener.AudioTimeSeconds);
+
 	if (GEngine && Root->IsActive())
 	{
-		if (APlayerController* player = GetWorld()->GetFirstPlayerController())
+		if (Listener.PlayerController)
 		{
-			if (APawn* playerPawn = player->GetPawn())
+			if (Listener.PlayerPawn)
 			{
 				Collision->SetHiddenInGame(!Debug);
 				Billboard->SetHiddenInGame(!Debug);
@@ -284,20 +347,17 @@ void AM1DecodeActor::Tick(float DeltaTime)
 
 				if (manualPawn != nullptr)
 				{
-					TArray<UCameraComponent*> CameraComponents;
-					manualPawn->GetComponents<UCameraComponent>(CameraComponents);
-
-					for (UCameraComponent* CameraComp : CameraComponents)
+					UCameraComponent* CameraComp = useManualPawnCamera ? listenerBinding.Resolve(manualPawn) : nullptr;
+					if (CameraComp != nullptr)
 					{
-						if (CameraComp->IsActive())
-						{
-							PlayerRotation = CameraComp->GetComponentRotation().Quaternion();
-							PlayerPosition = CameraComp->GetComponentLocation();
-						}
+						PlayerRotation = CameraComp->GetComponentRotation().Quaternion();
+						PlayerPosition = CameraComp->GetComponentLocation();
+					}
+					else
+					{
+						PlayerRotation = manualPawn->GetControlRotation().Quaternion();
+						PlayerPosition = manualPawn->GetActorLocation();
 					}
-
-					PlayerRotation = manualPawn->GetControlRotation().Quaternion();
-					PlayerPosition = manualPawn->GetActorLocation();
 				}
 				else if (manualActor != nullptr)
 				{
@@ -309,52 +369,45 @@ void AM1DecodeActor::Tick(float DeltaTime)
 					PlayerRotation = manualCameraActor->GetCameraComponent()->GetComponentRotation().Quaternion();
 					PlayerPosition = manualCameraActor->GetCameraComponent()->GetComponentLocation();
 				}
-				else if (ForceHMDRotation && UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled())
+				else if (ForceHMDRotation && Listener.HasHMD)
 				{
-					FRotator hmdRotator;
-					FVector hmdPosition;
-					UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(hmdRotator, hmdPosition);
-
-					PlayerRotation = hmdRotator.Quaternion();
-					PlayerPosition = hmdPosition;
+					PlayerRotation = Listener.HMDRotation;
+					PlayerPosition = Listener.HMDPosition;
 				}
 				else
 				{
-					APlayerCameraManager* playerCameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
-					FRotator cameraRotator = playerCameraManager->GetCameraRotation();
-					FVector cameraPosition = playerCameraManager->GetCameraLocation();
-
-					PlayerRotation = cameraRotator.Quaternion();
-					PlayerPosition = cameraPosition;
+					PlayerRotation = Listener.CameraRotation;
+					PlayerPosition = Listener.CameraPosition;
 				}
 
 				PlayerRotation = PlayerRotation * FQuat::MakeFromEuler(cameraManualAngleOffset);
 
+				FM1DecodeLODSettings lodSettings = FM1DecodeLODSettings::From(*this);
+				bool shouldEvaluate = decodeLOD.Update(lodSettings, FVector::Dist(PlayerPosition, GetActorLocation()), Listener.DeltaSeconds, m1Positional);
+				UpdateVirtualization(lodSettings, Listener.DeltaSeconds);
+				if (!shouldEvaluate)
+				{
+					return; // far or quiet, keep the last gains until the next LOD interval
+				}
+
 				FVector scale = Collision->GetScaledBoxExtent(); 
 
 				// M1 Reference object pos/rot
 				if (useReferenceObjectPosition) ObjPosition = GetActorLocation();
 				if (useDecodeRotationOffset) ObjRotation = GetActorRotation().Quaternion();
 
-				if (Debug) {
-					std::string info;
-
-					info = "Camera Rotation:  " + M1Common::toDebugString(PlayerRotation.Euler());
-					M1Common::PrintDebug(info.c_str());
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
-
-					info = "Camera Position:  " + M1Common::toDebugString(PlayerPosition);
-					M1Common::PrintDebug(info.c_str());
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
-
-					info = "Actor Rotation:  " + M1Common::toDebugString(ObjRotation.Euler());
-					M1Common::PrintDebug(info.c_str());
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
-
-					info = "Actor Position:  " + M1Common::toDebugString(ObjPosition);
-					M1Common::PrintDebug(info.c_str());
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
+#if M1_DEBUG_OVERLAY
+				UM1DecodeDebugSubsystem* debugOverlay = Debug ? GetWorld()->GetSubsystem<UM1DecodeDebugSubsystem>() : nullptr;
+				if (debugOverlay)
+				{
+					const FVector playerEuler = PlayerRotation.Euler();
+					const FVector objEuler = ObjRotation.Euler();
+					debugOverlay->AddLine(FColor::Green, TEXT("Camera Rotation:  (%.2f, %.2f, %.2f)"), playerEuler.X, playerEuler.Y, playerEuler.Z);
+					debugOverlay->AddLine(FColor::Green, TEXT("Camera Position:  (%.2f, %.2f, %.2f)"), PlayerPosition.X, PlayerPosition.Y, PlayerPosition.Z);
+					debugOverlay->AddLine(FColor::Green, TEXT("Actor Rotation:  (%.2f, %.2f, %.2f)"), objEuler.X, objEuler.Y, objEuler.Z);
+					debugOverlay->AddLine(FColor::Green, TEXT("Actor Position:  (%.2f, %.2f, %.2f)"), ObjPosition.X, ObjPosition.Y, ObjPosition.Z);
 				}
+#endif
 
 				float masterGain = Volume;
  
@@ -386,22 +439,32 @@ void AM1DecodeActor::Tick(float DeltaTime)
 	            }
 				m1Positional.setDecoderAlgoScale(M1Common::ConvertToMach1Point3D(scale));
 
-				m1Positional.evaluatePositionResults();
-
 				if (useFalloff)
 				{
-					m1Positional.setAttenuationCurve(attenuationCurve ? attenuationCurve->GetFloatValue(m1Positional.getDist()) : 1);
+					UpdateAttenuationModel();
 				}
 
-				float coeffs[MAX_INPUT_CHANNELS * 2];
-				m1Positional.getCoefficients(coeffs);
-				for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++)
+				float occlusionGain = 1.0f;
+				if (useOcclusion)
 				{
-					GainCoeffs[i] = coeffs[i];
+					if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+					{
+						occlusionGain = decodeSubsystem->EvaluateOcclusion(PlayerPosition, GetActorLocation());
+					}
 				}
-				SetVolumeMain(1.0);
+				m1Positional.setOcclusionGain(occlusionGain);
 
-				if (Debug) {
+				m1Positional.evaluatePositionResults();
+
+				// GainCoeffs is sized to the decode mode in UpdateDecodeConfiguration()
+				m1Positional.getCoefficients(GainCoeffs.GetData());
+
+				decodeLOD.SetPeakGain(GainCoeffs);
+				hasPendingGains = true;
+
+#if M1_DEBUG_OVERLAY
+				if (debugOverlay)
+				{
 					Mach1Point3D points[] = {
 					   {-1, 1, 1},
 					   {1, 1, 1},
@@ -414,40 +477,100 @@ void AM1DecodeActor::Tick(float DeltaTime)
 					};
 
 					FQuat quat = FQuat::MakeFromEuler(FVector(m1Positional.getPositionalRotation().x, m1Positional.getPositionalRotation().y, m1Positional.getPositionalRotation().z));
-					DrawDebugBox(GetWorld(), PlayerPosition, FVector(scale), quat, FColor::Red);
+					debugOverlay->AddBox(PlayerPosition, FVector(scale), quat, FColor::Red);
 
-					for (int i = 0; i < 8; i++)
+					for (int i = 0; i < FMath::Min(8, GainCoeffs.Num() / 2); i++)
 					{
 						Mach1Point3D p = points[i];
 						(std::swap)(p.y, p.z); // convert to glm
 						FVector point = FVector(p.z, p.x, p.y); // convertion to platfrom
 
-						DrawDebugString(GetWorld(), PlayerPosition + quat * (point * scale), FString(std::to_string(i).c_str()), 0, FColor::White, 0);
-						DrawDebugSphere(GetWorld(), PlayerPosition + quat * ((point + FVector(-0.1, 0, 0)) * scale), 10 * coeffs[i * 2 + 0], 16, FColor::Red, false, 0.5f);
-						DrawDebugSphere(GetWorld(), PlayerPosition + quat * ((point + FVector(+0.1, 0, 0)) * scale), 10 * coeffs[i * 2 + 1], 16, FColor::Blue, false, 0.5f);
+						debugOverlay->AddIndexLabel(PlayerPosition + quat * (point * scale), i);
+						debugOverlay->AddSphere(PlayerPosition + quat * ((point + FVector(-0.1, 0, 0)) * scale), 10 * GainCoeffs[i * 2 + 0], FColor::Red);
+						debugOverlay->AddSphere(PlayerPosition + quat * ((point + FVector(+0.1, 0, 0)) * scale), 10 * GainCoeffs[i * 2 + 1], FColor::Blue);
 					}
+
+					const Mach1Point3D libAngle = m1Positional.getCurrentAngleInternal();
+					debugOverlay->AddLine(FColor::Purple, TEXT("Lib Distance:  %.2f"), m1Positional.getDist());
+					debugOverlay->AddLine(FColor::Yellow, TEXT("Lib Euler Angles:    %.2f , %.2f , %.2f"), libAngle.x, libAngle.y, libAngle.z);
+					debugOverlay->AddValues(FColor::Green, TEXT("Coeffs:  "), GainCoeffs.GetData(), GainCoeffs.Num());
 				}
+#endif
+			}
+		}
+	}
+}
 
-				if (Debug)
-				{
-					std::string info;
-					info = "Lib Distance:  " + M1Common::toDebugString(m1Positional.getDist());
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Purple, info.c_str());
+float AM1DecodeActor::GetCullDistance(const FM1ListenerFrame& Listener)
+{
+	// same conditions under which EvaluateDecode() measures the LOD distance from the listener camera
+	bool usesListenerCamera = !manualPawn && !manualActor && !manualCameraActor && !(ForceHMDRotation && Listener.HasHMD);
+	if (!useLOD || !usesListenerCamera || !Listener.PlayerController || !Listener.PlayerPawn || !Root->IsActive())
+	{
+		return 0;
+	}
+	return lodVirtualDistance;
+}
 
-					std::string str = "Lib Euler Angles:    " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().x) + " , " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().y) + " , " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().z);
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Yellow, str.c_str());
+void AM1DecodeActor::EvaluateCulled(const FM1ListenerFrame& Listener)
+{
+	AdvancePlaybackTime(Listener.AudioTimeSeconds);
 
+	FM1DecodeLODSettings lodSettings = FM1DecodeLODSettings::From(*this);
+	decodeLOD.SetLOD(EM1DecodeLODLevel::Virtual, lodSettings, m1Positional);
+	UpdateVirtualization(lodSettings, Listener.DeltaSeconds);
+}
 
-					info = "Coeffs:  ";
-					for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++)
-					{
-						info += M1Common::toDebugString(coeffs[i]) + ", ";
-					}
-					GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
+void AM1DecodeActor::ApplyDecodeGains(FM1VolumeBatch* VolumeBatch)
+{
+	if (hasPendingGains)
+	{
+		PendingVolumeBatch = VolumeBatch;
+		SetVolumeMain(1.0);
+		PendingVolumeBatch = nullptr;
+		hasPendingGains = false;
+	}
+}
+
+TEnumAsByte<EMach1DecodeLOD> AM1DecodeActor::GetCurrentLOD()
+{
+	return static_cast<EMach1DecodeLOD>(decodeLOD.GetLOD());
+}
+
+void AM1DecodeActor::AdvancePlaybackTime(double audioTime)
+{
+	decodeLOD.AdvancePlaybackTime(audioTime, decodeVoices.IsSingleVoiceActive ? MultichannelBed : (SoundsMain.Num() > 0 ? SoundsMain[0] : nullptr));
+}
+
+void AM1DecodeActor::UpdateVirtualization(const FM1DecodeLODSettings& lodSettings, float deltaSeconds)
+{
+	decodeLOD.UpdateVirtualization(lodSettings, deltaSeconds,
+		[this]()
+		{
+			for (UAudioComponent* component : GetAudioComponentsMain())
+			{
+				if (component)
+				{
+					component->Stop();
 				}
 			}
-		}
-	}
+		},
+		[this](float startTime, float fadeIn)
+		{
+			FM1DecodeSyncStart SyncStart(this);
+			QueueSynchronizedStart(SyncStart, startTime, fadeIn);
+			SyncStart.Start();
+		});
+}
+
+bool AM1DecodeActor::IsVirtualized()
+{
+	return decodeLOD.IsVirtualized();
+}
+
+float AM1DecodeActor::GetPlaybackTime()
+{
+	return decodeLOD.GetPlaybackTime();
 }
 
 #if WITH_EDITOR
@@ -462,11 +585,17 @@ void AM1DecodeActor::PostEditChangeProperty(FPropertyChangedEvent & PropertyChan
 			Collision->SetHiddenInGame(!Debug);
 			Billboard->SetHiddenInGame(!Debug);
 		}
-		
+
+		if (PropertyName == TEXT("attenuationCurve"))
+		{
+			isAttenuationBaked = false;
+		}
+
 		// Refresh configuration if decode-related properties changed
 		if (PropertyName.Contains("DecodeMode") || 
 			PropertyName.Contains("InputMode") || 
-			PropertyName.Contains("Channel"))
+			PropertyName.Contains("Channel") ||
+			PropertyName.Contains("SingleVoice"))
 		{
 			RefreshDecodeConfiguration();
 		}
@@ -476,42 +605,66 @@ void AM1DecodeActor::PostEditChangeProperty(FPropertyChangedEvent & PropertyChan
 #endif
 
 
+void AM1DecodeActor::UpdateAttenuationModel()
+{
+	uint32 curveHash = 0;
+#if WITH_EDITOR
+	// edits to the curve asset keep the pointer, so compare its keys as well; cooked curves never change
+	curveHash = attenuationCurve ? M1Common::GetAttenuationCurveHash(attenuationCurve) : 0;
+#endif
+	if (isAttenuationBaked && bakedAttenuationCurve == attenuationCurve && bakedAttenuationCurveHash == curveHash)
+	{
+		return;
+	}
+
+	if (attenuationCurve)
+	{
+		M1Common::BakeAttenuationCurve(attenuationCurve, m1Positional);
+	}
+	else
+	{
+		m1Positional.setAttenuationModel(Mach1AttenuationCurve);
+		m1Positional.setAttenuationCurve(1);
+	}
+
+	bakedAttenuationCurve = attenuationCurve;
+	bakedAttenuationCurveHash = curveHash;
+	isAttenuationBaked = true;
+}
+
 void AM1DecodeActor::SetVolumeMain(float volume)
 {
 	if (isInited)
 	{
 		float masterGain = FMath::Max(MIN_SOUND_VOLUME, this->Volume * volume);
 		
-		// MULTI-MONO MODE: Apply per-channel spatial processing (now the only mode)
-		SetVolumeIndividualChannels(masterGain);
+		if (decodeVoices.IsSingleVoiceActive)
+		{
+			// SINGLE-VOICE MODE: gains are applied on the audio render thread
+			decodeVoices.SetSingleVoiceGains(GainCoeffs, masterGain, MAX_INPUT_CHANNELS);
+		}
+		else
+		{
+			// MULTI-MONO MODE: Apply per-channel spatial processing
+			SetVolumeIndividualChannels(masterGain);
+		}
 	}
 }
 
 void AM1DecodeActor::SetVolumeIndividualChannels(float masterGain)
 {
-	// Individual channel processing - each channel gets its own spatial coefficient
-	float newVolume = 0;
-	
-	for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-	{
-		newVolume = GainCoeffs[i * 2] * masterGain;
-		newVolume = FMath::Max(MIN_SOUND_VOLUME, newVolume);
-		LeftChannelsMain[i]->SetVolumeMultiplier(newVolume);
+	// PendingVolumeBatch collects the volumes of every decoder driven by UM1DecodeWorldSubsystem
+	decodeVoices.SetChannelVolumes(GainCoeffs, masterGain, volumeUpdateThresholdDb, LeftChannelsMain, RightChannelsMain, MAX_INPUT_CHANNELS, PendingVolumeBatch);
 
-		newVolume = GainCoeffs[i * 2 + 1] * masterGain;
-		newVolume = FMath::Max(MIN_SOUND_VOLUME, newVolume);
-		RightChannelsMain[i]->SetVolumeMultiplier(newVolume);
-	}
-	
-	if (Debug)
+#if M1_DEBUG_OVERLAY
+	UM1DecodeDebugSubsystem* debugOverlay = Debug ? GetWorld()->GetSubsystem<UM1DecodeDebugSubsystem>() : nullptr;
+	if (debugOverlay)
 	{
-		FString CoeffInfo = TEXT("Individual Channels: ");
-		for (int i = 0; i < FMath::Min(4, MAX_INPUT_CHANNELS); i++) // Show first 4 channels
-		{
-			CoeffInfo += FString::Printf(TEXT("Ch%d[L=%.2f,R=%.2f] "), i, GainCoeffs[i * 2], GainCoeffs[i * 2 + 1]);
-		}
-		GEngine->AddOnScreenDebugMessage(-1, 0.1f, FColor::Orange, CoeffInfo);
+		// Show first 4 channels
+		debugOverlay->AddLine(FColor::Orange, TEXT("Individual Channels: Ch0[L=%.2f,R=%.2f] Ch1[L=%.2f,R=%.2f] Ch2[L=%.2f,R=%.2f] Ch3[L=%.2f,R=%.2f] Suppressed=%d"),
+			GainCoeffs[0], GainCoeffs[1], GainCoeffs[2], GainCoeffs[3], GainCoeffs[4], GainCoeffs[5], GainCoeffs[6], GainCoeffs[7], decodeVoices.SuppressedVolumeUpdates);
 	}
+#endif
 }
 
 void AM1DecodeActor::SetSoundsMain()
@@ -533,6 +686,10 @@ TArray<UAudioComponent*> AM1DecodeActor::GetAudioComponentsMain()
 	for (UAudioComponent* componentR : RightChannelsMain) {
 		arrayOfAllPlayerComponents.Add(componentR);
 	}
+
+	if (decodeVoices.SingleVoiceMain) {
+		arrayOfAllPlayerComponents.Add(decodeVoices.SingleVoiceMain);
+	}
 	return arrayOfAllPlayerComponents;
 }
 
@@ -547,6 +704,10 @@ void AM1DecodeActor::UpdateDecodeConfiguration()
 	// Update the required channel count
 	int requiredChannels = GetRequiredChannelCount();
 	this->MAX_INPUT_CHANNELS = requiredChannels;
+
+	// Preallocate the coefficient store for the selected mode so EvaluateDecode can write into it directly
+	GainCoeffs.SetNumZeroed(FMath::Max(m1Positional.getFormatCoeffCount(), requiredChannels * 2));
+	decodeVoices.ResetAppliedChannelVolumes(MAX_INPUT_CHANNELS);
 	
 	// Resize audio component arrays if needed
 	if (LeftChannelsMain.Num() < requiredChannels)
@@ -637,6 +798,11 @@ int AM1DecodeActor::GetCurrentChannelCount()
 	return GetRequiredChannelCount();
 }
 
+int AM1DecodeActor::GetSuppressedVolumeUpdateCount()
+{
+	return decodeVoices.SuppressedVolumeUpdates;
+}
+
 void AM1DecodeActor::RefreshDecodeConfiguration()
 {
 	UpdateDecodeConfiguration();
@@ -669,6 +835,12 @@ void AM1DecodeActor::StopAllAudioComponents()
 			RightChannelsMain[i]->SetSound(nullptr);
 		}
 	}
+
+	if (decodeVoices.SingleVoiceMain)
+	{
+		decodeVoices.SingleVoiceMain->Stop();
+		decodeVoices.SingleVoiceMain->SetSound(nullptr);
+	}
 }
 
 void AM1DecodeActor::SetupIndividualChannelPlayback()
@@ -709,5 +881,29 @@ void AM1DecodeActor::SetupIndividualChannelPlayback()
 	M1Common::PrintDebug(TCHAR_TO_ANSI(*FString::Printf(TEXT("Individual channels: %d/%d assigned"), validChannels, GetRequiredChannelCount())));
 }
 
+bool AM1DecodeActor::UsesSingleVoiceDecode()
+{
+	return useSingleVoiceDecode && MultichannelBed != nullptr && GetRequiredChannelCount() <= M1_SINGLE_VOICE_MAX_CHANNELS;
+}
+
+void AM1DecodeActor::SetupSingleVoicePlayback()
+{
+#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 23) || ENGINE_MAJOR_VERSION == 5
+	MultichannelBed->VirtualizationMode = EVirtualizationMode::PlayWhenSilent;
+#else
+	MultichannelBed->bVirtualizeWhenSilent = true;
+#endif
+
+	decodeVoices.SingleVoiceMain->SetSound(MultichannelBed);
+
+	if (Debug)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, 
+			FString::Printf(TEXT("Single-Voice Decode: %d channel bed on 1 voice"), GetRequiredChannelCount()));
+	}
+
+	M1Common::PrintDebug(TCHAR_TO_ANSI(*FString::Printf(TEXT("Single-voice decode: %d channel bed on 1 voice"), GetRequiredChannelCount())));
+}
+
 // ========== MULTICHANNEL PROCESSING REMOVED ==========
 // All multichannel complexity has been removed for cleaner, more reliable multi-mono processing
@@ -3,7 +3,10 @@
 //
 
 #include "M1DecodeComponent.h"
+#include "M1DecodeWorldSubsystem.h"
+#include "M1DecodeDebugSubsystem.h"
 #include "Camera/CameraActor.h"
+#include "Sound/SoundWave.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #include "Mach1DecodePluginPrivatePCH.h"
@@ -34,7 +37,7 @@ void UM1DecodeComponent::InitComponents(int32 MaxSpatialInputChannels)
 	RightChannelsMain.SetNum(MAX_INPUT_CHANNELS);
 
 	Volume = 1;
-	for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++) GainCoeffs.Add(1);
+	GainCoeffs.Init(1, MAX_INPUT_CHANNELS * 2);
 
 	m1Positional.setPlatformType(Mach1PlatformType::Mach1PlatformUE);
 	
@@ -85,26 +88,43 @@ void UM1DecodeComponent::Init()
 			NullAttenuation->Attenuation.bAttenuate = false;
 			NullAttenuation->Attenuation.bSpatialize = true;
 
-			for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+			if (UsesSingleVoiceDecode())
 			{
-				LeftChannelsMain[i] = NewObject <UAudioComponent>(listenerReferenceComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_L_%d"), GetUniqueID(), i)));
-				RightChannelsMain[i] = NewObject <UAudioComponent>(listenerReferenceComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_R_%d"), GetUniqueID(), i)));
+				decodeVoices.InitSingleVoice(this, listenerReferenceComponent);
+			}
+			else
+			{
+				InitIndividualChannels();
+			}
 
-				LeftChannelsMain[i]->RegisterComponent(); // only for runtime
-				RightChannelsMain[i]->RegisterComponent(); // only for runtime
+			isInited = true;
+		}
+	}
+}
 
-				LeftChannelsMain[i]->SetRelativeLocation(FVector(0, -1, 0));
-				RightChannelsMain[i]->SetRelativeLocation(FVector(0, 1, 0));
+void UM1DecodeComponent::InitIndividualChannels()
+{
+	for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+	{
+		if (LeftChannelsMain[i])
+		{
+			continue; // already created for this channel count
+		}
 
-				LeftChannelsMain[i]->AttenuationSettings = NullAttenuation;
-				RightChannelsMain[i]->AttenuationSettings = NullAttenuation;
+		LeftChannelsMain[i] = NewObject <UAudioComponent>(listenerReferenceComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_L_%d"), GetUniqueID(), i)));
+		RightChannelsMain[i] = NewObject <UAudioComponent>(listenerReferenceComponent, FName(*FString::Printf(TEXT("SoundCubeWalls %d_R_%d"), GetUniqueID(), i)));
 
-				LeftChannelsMain[i]->AttachToComponent(listenerReferenceComponent, FAttachmentTransformRules::KeepRelativeTransform); // AttachToComponent(Root, FAttachmentTransformRules::KeepRelativeTransform);//   AttachTo(sceneComponent);
-				RightChannelsMain[i]->AttachToComponent(listenerReferenceComponent, FAttachmentTransformRules::KeepRelativeTransform);
-			}
+		LeftChannelsMain[i]->RegisterComponent(); // only for runtime
+		RightChannelsMain[i]->RegisterComponent(); // only for runtime
 
-			isInited = true;
-		}
+		LeftChannelsMain[i]->SetRelativeLocation(FVector(0, -1, 0));
+		RightChannelsMain[i]->SetRelativeLocation(FVector(0, 1, 0));
+
+		LeftChannelsMain[i]->AttenuationSettings = NullAttenuation;
+		RightChannelsMain[i]->AttenuationSettings = NullAttenuation;
+
+		LeftChannelsMain[i]->AttachToComponent(listenerReferenceComponent, FAttachmentTransformRules::KeepRelativeTransform); // AttachToComponent(Root, FAttachmentTransformRules::KeepRelativeTransform);//   AttachTo(sceneComponent);
+		RightChannelsMain[i]->AttachToComponent(listenerReferenceComponent, FAttachmentTransformRules::KeepRelativeTransform);
 	}
 }
 
@@ -120,47 +140,58 @@ void UM1DecodeComponent::SetSoundSet()
 		// Use the new configuration-based sound setup
 		SetSoundsBasedOnConfiguration();
 
-        // INDIVIDUAL MONO CHANNELS MODE: Use separate mono files
-        SetupIndividualChannelPlayback();
+		decodeVoices.IsSingleVoiceActive = UsesSingleVoiceDecode();
+		if (decodeVoices.IsSingleVoiceActive)
+		{
+			// SINGLE-VOICE MODE: one multichannel bed, decoded by the source effect
+			decodeVoices.InitSingleVoice(this, listenerReferenceComponent);
+			SetupSingleVoicePlayback();
+		}
+		else
+		{
+			// INDIVIDUAL MONO CHANNELS MODE: Use separate mono files
+			InitIndividualChannels();
+			SetupIndividualChannelPlayback();
+		}
 	}
 }
 
-void UM1DecodeComponent::Play()
+void UM1DecodeComponent::QueueSynchronizedStart(FM1DecodeSyncStart& SyncStart, float startTime, float fadeIn)
+{
+	decodeLOD.StartPlayback(startTime, GetWorld()->GetAudioTimeSeconds());
+	decodeVoices.QueueSynchronizedStart(SyncStart, LeftChannelsMain, RightChannelsMain, MAX_INPUT_CHANNELS, startTime, fadeIn);
+}
+
+void UM1DecodeComponent::PlayWith(FM1DecodeSyncStart& SyncStart)
 {
 	if (isInited)
 	{
-		// For perfect synchronization, stop all first
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Stop();
-				RightChannelsMain[i]->Stop();
-			}
-		}
-		
-		// Small delay to ensure all components are stopped
-		FPlatformProcess::Sleep(0.01f);
-		
-		// Now start all components simultaneously
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->FadeIn(fadeInDuration);
-				RightChannelsMain[i]->FadeIn(fadeInDuration);
-			}
-		}
+		QueueSynchronizedStart(SyncStart, 0, fadeInDuration);
 	}
-
-	if (!isInited)
+	else
 	{
 		needToPlayAfterInit = true;
 	}
 }
 
+void UM1DecodeComponent::Play()
+{
+	// All voices are queued on the shared Quartz clock and begin on the same audio render block
+	FM1DecodeSyncStart SyncStart(this);
+	PlayWith(SyncStart);
+	SyncStart.Start();
+}
+
 void UM1DecodeComponent::Pause()
 {
+	decodeLOD.SetPaused(true);
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->SetPaused(true);
+		return;
+	}
+
 	if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
@@ -173,6 +204,14 @@ void UM1DecodeComponent::Pause()
 
 void UM1DecodeComponent::Resume()
 {
+	decodeLOD.SetPaused(false);
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->SetPaused(false);
+		return;
+	}
+
 	if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
@@ -185,31 +224,24 @@ void UM1DecodeComponent::Resume()
 
 void UM1DecodeComponent::Seek(float time)
 {
-	if (isInited)
+	if (isInited && decodeLOD.IsVirtualized() && decodeLOD.IsPlaybackStarted())
 	{
-		// For perfect synchronization, stop all first
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Stop();
-				RightChannelsMain[i]->Stop();
-			}
-		}
-		
-		// Small delay to ensure synchronization
-		FPlatformProcess::Sleep(0.005f);
-		
-		// Start all at the exact same time position
-		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
+		// nothing to restart: the voices pick up the new position once devirtualized
+		decodeLOD.SetPlaybackTime(time, GetWorld()->GetAudioTimeSeconds());
+
+		if (Debug)
 		{
-			if (LeftChannelsMain[i]->GetSound())
-			{
-				LeftChannelsMain[i]->Play(time);
-				RightChannelsMain[i]->Play(time);
-			}
+			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Blue, 
+				FString::Printf(TEXT("Component Virtualized seek to %.2fs"), time));
 		}
-		
+	}
+	else if (isInited)
+	{
+		// Restart every voice at the same position on the same audio render block
+		FM1DecodeSyncStart SyncStart(this);
+		QueueSynchronizedStart(SyncStart, time, 0);
+		SyncStart.Start();
+
 		if (Debug)
 		{
 			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Blue, 
@@ -220,7 +252,13 @@ void UM1DecodeComponent::Seek(float time)
 
 void UM1DecodeComponent::Stop()
 {
-	if (isInited)
+	decodeLOD.StopPlayback();
+
+	if (isInited && decodeVoices.IsSingleVoiceActive)
+	{
+		decodeVoices.SingleVoiceMain->FadeOut(fadeOutDuration, 0);
+	}
+	else if (isInited)
 	{
 		for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
 		{
@@ -244,28 +282,52 @@ void UM1DecodeComponent::BeginPlay()
 			SetSoundSet();
 			if (autoplay || needToPlayAfterInit) Play();
 		}
+
+		// Let the world subsystem tick this decoder with the listener it resolves once for all decoders
+		if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+		{
+			decodeSubsystem->RegisterDecoder(this);
+			SetComponentTickEnabled(false);
+		}
+	}
+}
+
+void UM1DecodeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+	{
+		decodeSubsystem->UnregisterDecoder(this);
 	}
+
+	decodeVoices.Release();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
 void UM1DecodeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	EvaluateDecode(UM1DecodeWorldSubsystem::ResolveListenerFrame(GetWorld()));
+	ApplyDecodeGains();
+}
+
+void UM1DecodeComponent::EvaluateDecode(const FM1ListenerFrame& Listener)
+{
+	AdvancePlaybackTime(Listener.AudioTimeSeconds);
+
 	if (manualPawn != nullptr)
 	{
-		TArray<UCameraComponent*> CameraComponents;
-		manualPawn->GetComponents<UCameraComponent>(CameraComponents);
-
-		for (UCameraComponent* CameraComp : CameraComponents)
+		UCameraComponent* CameraComp = useManualPawnCamera ? listenerBinding.Resolve(manualPawn) : nullptr;
+		if (CameraComp != nullptr)
 		{
-			if (CameraComp->IsActive())
-			{
-				if (useReferenceObjectRotation) PlayerRotation = CameraComp->GetComponentRotation().Quaternion();
-				if (useReferenceObjectPosition) PlayerPosition = CameraComp->GetComponentLocation();
-			}
+			if (useReferenceObjectRotation) PlayerRotation = CameraComp->GetComponentRotation().Quaternion();
+			if (useReferenceObjectPosition) PlayerPosition = CameraComp->GetComponentLocation();
+		}
+		else
+		{
+			if (useReferenceObjectRotation) PlayerRotation = manualPawn->GetControlRotation().Quaternion();
+			if (useReferenceObjectPosition) PlayerPosition = manualPawn->GetActorLocation();
 		}
-
-		if (useReferenceObjectRotation) PlayerRotation = manualPawn->GetControlRotation().Quaternion();
-		if (useReferenceObjectPosition) PlayerPosition = manualPawn->GetActorLocation();
 	}
 	else if (manualActor != nullptr)
 	{
@@ -279,30 +341,22 @@ void UM1DecodeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 	}
 	else if (AttachToPlayerPawnCamera) 
 	{
-		if (UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled())
+		if (Listener.HasHMD)
 		{
-			FRotator hmdRotator;
-			FVector hmdPosition;
-			UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(hmdRotator, hmdPosition);
-
-			PlayerRotation = hmdRotator.Quaternion();
-			PlayerPosition = hmdPosition;
+			PlayerRotation = Listener.HMDRotation;
+			PlayerPosition = Listener.HMDPosition;
 		}
-		else if (APlayerController* player = GetWorld()->GetFirstPlayerController()) 
+		else if (Listener.PlayerController) 
 		{
-			if (APawn* playerPawn = player->GetPawn()) 
+			if (Listener.PlayerPawn) 
 			{
 				PlayerRotation = FQuat::Identity;
 				PlayerPosition = FVector(0, 0, 0);
 			}
 			else
 			{
-				APlayerCameraManager* playerCameraManager = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
-				FRotator cameraRotator = playerCameraManager->GetCameraRotation();
-				FVector cameraPosition = playerCameraManager->GetCameraLocation();
-
-				PlayerRotation = cameraRotator.Quaternion();
-				PlayerPosition = cameraPosition;
+				PlayerRotation = Listener.CameraRotation;
+				PlayerPosition = Listener.CameraPosition;
 			}
 		}
 		else 
@@ -319,21 +373,27 @@ void UM1DecodeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 
 	PlayerRotation = PlayerRotation * FQuat::MakeFromEuler(cameraManualAngleOffset);
 
-	if (Debug) {
-		std::string info;
-
-		info = "Listener Rotation:  " + M1Common::toDebugString(PlayerRotation.Euler());
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
-
-		info = "Listener Position:  " + M1Common::toDebugString(PlayerPosition);
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
-
-		info = "Reference Rotation:  " + M1Common::toDebugString(GetComponentRotation().Quaternion().Euler());
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
+	FM1DecodeLODSettings lodSettings = FM1DecodeLODSettings::From(*this);
+	bool shouldEvaluate = decodeLOD.Update(lodSettings, FVector::Dist(PlayerPosition, GetComponentLocation()), Listener.DeltaSeconds, m1Positional);
+	UpdateVirtualization(lodSettings, Listener.DeltaSeconds);
+	if (!shouldEvaluate)
+	{
+		return; // far or quiet, keep the last gains until the next LOD interval
+	}
 
-		info = "Reference Position:  " + M1Common::toDebugString(GetComponentLocation());
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
+#if M1_DEBUG_OVERLAY
+	UM1DecodeDebugSubsystem* debugOverlay = Debug ? GetWorld()->GetSubsystem<UM1DecodeDebugSubsystem>() : nullptr;
+	if (debugOverlay)
+	{
+		const FVector playerEuler = PlayerRotation.Euler();
+		const FVector referenceEuler = GetComponentRotation().Quaternion().Euler();
+		const FVector referencePosition = GetComponentLocation();
+		debugOverlay->AddLine(FColor::Green, TEXT("Listener Rotation:  (%.2f, %.2f, %.2f)"), playerEuler.X, playerEuler.Y, playerEuler.Z);
+		debugOverlay->AddLine(FColor::Green, TEXT("Listener Position:  (%.2f, %.2f, %.2f)"), PlayerPosition.X, PlayerPosition.Y, PlayerPosition.Z);
+		debugOverlay->AddLine(FColor::Green, TEXT("Reference Rotation:  (%.2f, %.2f, %.2f)"), referenceEuler.X, referenceEuler.Y, referenceEuler.Z);
+		debugOverlay->AddLine(FColor::Green, TEXT("Reference Position:  (%.2f, %.2f, %.2f)"), referencePosition.X, referencePosition.Y, referencePosition.Z);
 	}
+#endif
 
 	float masterGain = Volume;
 
@@ -357,22 +417,32 @@ void UM1DecodeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 
 	m1Positional.setDecoderAlgoScale(M1Common::ConvertToMach1Point3D(GetComponentScale()));
 
-	m1Positional.evaluatePositionResults();
-
 	if (useAttenuation)
 	{
-		m1Positional.setAttenuationCurve(attenuationCurve ? attenuationCurve->GetFloatValue(m1Positional.getDist()) : 1);
+		UpdateAttenuationModel();
 	}
 
-	float coeffs[18];
-	m1Positional.getCoefficients(coeffs);
-	for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++)
+	float occlusionGain = 1.0f;
+	if (useOcclusion)
 	{
-		GainCoeffs[i] = coeffs[i];
+		if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+		{
+			occlusionGain = decodeSubsystem->EvaluateOcclusion(PlayerPosition, GetComponentLocation());
+		}
 	}
-	SetVolumeMain(1.0);
+	m1Positional.setOcclusionGain(occlusionGain);
+
+	m1Positional.evaluatePositionResults();
 
-	if (Debug) {
+	// GainCoeffs is sized to the decode mode in UpdateDecodeConfiguration()
+	m1Positional.getCoefficients(GainCoeffs.GetData());
+
+	decodeLOD.SetPeakGain(GainCoeffs);
+	hasPendingGains = true;
+
+#if M1_DEBUG_OVERLAY
+	if (debugOverlay)
+	{
 		Mach1Point3D points[] = {
 		   {-1, 1, 1},
 		   {1, 1, 1},
@@ -386,35 +456,123 @@ void UM1DecodeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAc
 
 		FQuat quat = FQuat::MakeFromEuler(FVector(m1Positional.getPositionalRotation().x, m1Positional.getPositionalRotation().y, m1Positional.getPositionalRotation().z));
 
-		for (int i = 0; i < 8; i++)
+		for (int i = 0; i < FMath::Min(8, GainCoeffs.Num() / 2); i++)
 		{
 			Mach1Point3D p = points[i];
 			(std::swap)(p.y, p.z); // convert to glm
 			FVector point = FVector(p.z, p.x, p.y); // convertion to platfrom
 
-			DrawDebugString(GetWorld(), PlayerPosition + quat * (point * GetComponentScale()), FString(std::to_string(i).c_str()), 0, FColor::White, 0);
-			DrawDebugSphere(GetWorld(), PlayerPosition + quat * ((point + FVector(-0.1, 0, 0)) * GetComponentScale()), 10 * coeffs[i * 2 + 0], 16, FColor::Red, false, 0.5f);
-			DrawDebugSphere(GetWorld(), PlayerPosition + quat * ((point + FVector(+0.1, 0, 0)) * GetComponentScale()), 10 * coeffs[i * 2 + 1], 16, FColor::Blue, false, 0.5f);
+			debugOverlay->AddIndexLabel(PlayerPosition + quat * (point * GetComponentScale()), i);
+			debugOverlay->AddSphere(PlayerPosition + quat * ((point + FVector(-0.1, 0, 0)) * GetComponentScale()), 10 * GainCoeffs[i * 2 + 0], FColor::Red);
+			debugOverlay->AddSphere(PlayerPosition + quat * ((point + FVector(+0.1, 0, 0)) * GetComponentScale()), 10 * GainCoeffs[i * 2 + 1], FColor::Blue);
 		}
+
+		const Mach1Point3D libAngle = m1Positional.getCurrentAngleInternal();
+		debugOverlay->AddLine(FColor::Purple, TEXT("Lib Distance:  %.2f"), m1Positional.getDist());
+		debugOverlay->AddLine(FColor::Yellow, TEXT("Lib Euler Angles:    %.2f , %.2f , %.2f"), libAngle.x, libAngle.y, libAngle.z);
+		debugOverlay->AddValues(FColor::Green, TEXT("Coeffs:  "), GainCoeffs.GetData(), GainCoeffs.Num());
+	}
+#endif
+}
+
+float UM1DecodeComponent::GetCullDistance(const FM1ListenerFrame& Listener)
+{
+	// only the player camera branch of EvaluateDecode() measures the LOD distance from the listener camera
+	bool usesListenerCamera = !manualPawn && !manualActor && !manualCameraActor && AttachToPlayerPawnCamera
+		&& !Listener.HasHMD && Listener.PlayerController && !Listener.PlayerPawn;
+	if (!useLOD || !usesListenerCamera)
+	{
+		return 0;
 	}
+	return lodVirtualDistance;
+}
 
-	if (Debug)
+void UM1DecodeComponent::EvaluateCulled(const FM1ListenerFrame& Listener)
+{
+	AdvancePlaybackTime(Listener.AudioTimeSeconds);
+
+	FM1DecodeLODSettings lodSettings = FM1DecodeLODSettings::From(*this);
+	decodeLOD.SetLOD(EM1DecodeLODLevel::Virtual, lodSettings, m1Positional);
+	UpdateVirtualization(lodSettings, Listener.DeltaSeconds);
+}
+
+void UM1DecodeComponent::ApplyDecodeGains(FM1VolumeBatch* VolumeBatch)
+{
+	if (hasPendingGains)
 	{
-		std::string info;
-		info = "Lib Distance:  " + M1Common::toDebugString(m1Positional.getDist());
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Purple, info.c_str());
+		PendingVolumeBatch = VolumeBatch;
+		SetVolumeMain(1.0);
+		PendingVolumeBatch = nullptr;
+		hasPendingGains = false;
+	}
+}
 
-		std::string str = "Lib Euler Angles:    " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().x) + " , " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().y) + " , " + M1Common::toDebugString(m1Positional.getCurrentAngleInternal().z);
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Yellow, str.c_str());
+TEnumAsByte<EMach1DecodeLODComponent> UM1DecodeComponent::GetCurrentLOD()
+{
+	return static_cast<EMach1DecodeLODComponent>(decodeLOD.GetLOD());
+}
 
+void UM1DecodeComponent::AdvancePlaybackTime(double audioTime)
+{
+	decodeLOD.AdvancePlaybackTime(audioTime, decodeVoices.IsSingleVoiceActive ? MultichannelBed : (SoundsMain.Num() > 0 ? SoundsMain[0] : nullptr));
+}
 
-		info = "Coeffs:  ";
-		for (int i = 0; i < MAX_INPUT_CHANNELS * 2; i++)
+void UM1DecodeComponent::UpdateVirtualization(const FM1DecodeLODSettings& lodSettings, float deltaSeconds)
+{
+	decodeLOD.UpdateVirtualization(lodSettings, deltaSeconds,
+		[this]()
 		{
-			info += M1Common::toDebugString(coeffs[i]) + ", ";
-		}
-		GEngine->AddOnScreenDebugMessage(-1, -1, FColor::Green, info.c_str());
+			for (UAudioComponent* component : GetAudioComponentsMain())
+			{
+				if (component)
+				{
+					component->Stop();
+				}
+			}
+		},
+		[this](float startTime, float fadeIn)
+		{
+			FM1DecodeSyncStart SyncStart(this);
+			QueueSynchronizedStart(SyncStart, startTime, fadeIn);
+			SyncStart.Start();
+		});
+}
+
+bool UM1DecodeComponent::IsVirtualized()
+{
+	return decodeLOD.IsVirtualized();
+}
+
+float UM1DecodeComponent::GetPlaybackTime()
+{
+	return decodeLOD.GetPlaybackTime();
+}
+
+void UM1DecodeComponent::UpdateAttenuationModel()
+{
+	uint32 curveHash = 0;
+#if WITH_EDITOR
+	// edits to the curve asset keep the pointer, so compare its keys as well; cooked curves never change
+	curveHash = attenuationCurve ? M1Common::GetAttenuationCurveHash(attenuationCurve) : 0;
+#endif
+	if (isAttenuationBaked && bakedAttenuationCurve == attenuationCurve && bakedAttenuationCurveHash == curveHash)
+	{
+		return;
+	}
+
+	if (attenuationCurve)
+	{
+		M1Common::BakeAttenuationCurve(attenuationCurve, m1Positional);
 	}
+	else
+	{
+		m1Positional.setAttenuationModel(Mach1AttenuationCurve);
+		m1Positional.setAttenuationCurve(1);
+	}
+
+	bakedAttenuationCurve = attenuationCurve;
+	bakedAttenuationCurveHash = curveHash;
+	isAttenuationBaked = true;
 }
 
 void UM1DecodeComponent::SetVolumeMain(float volume)
@@ -423,36 +581,33 @@ void UM1DecodeComponent::SetVolumeMain(float volume)
 	{
 		float masterGain = FMath::Max(MIN_SOUND_VOLUME, this->Volume * volume);
 		
-        // INDIVIDUAL MONO CHANNELS MODE: Apply per-channel spatial processing
-        SetVolumeIndividualChannels(masterGain);
+		if (decodeVoices.IsSingleVoiceActive)
+		{
+			// SINGLE-VOICE MODE: gains are applied on the audio render thread
+			decodeVoices.SetSingleVoiceGains(GainCoeffs, masterGain, MAX_INPUT_CHANNELS);
+		}
+		else
+		{
+			// MULTI-MONO MODE: Apply per-channel spatial processing
+			SetVolumeIndividualChannels(masterGain);
+		}
 	}
 }
 
 void UM1DecodeComponent::SetVolumeIndividualChannels(float masterGain)
 {
-	// Individual channel processing - each channel gets its own spatial coefficient
-	float newVolume = 0;
-	
-	for (int i = 0; i < MAX_INPUT_CHANNELS; i++)
-	{
-		newVolume = GainCoeffs[i * 2] * masterGain;
-		newVolume = FMath::Max(MIN_SOUND_VOLUME, newVolume);
-		LeftChannelsMain[i]->SetVolumeMultiplier(newVolume);
+	// PendingVolumeBatch collects the volumes of every decoder driven by UM1DecodeWorldSubsystem
+	decodeVoices.SetChannelVolumes(GainCoeffs, masterGain, volumeUpdateThresholdDb, LeftChannelsMain, RightChannelsMain, MAX_INPUT_CHANNELS, PendingVolumeBatch);
 
-		newVolume = GainCoeffs[i * 2 + 1] * masterGain;
-		newVolume = FMath::Max(MIN_SOUND_VOLUME, newVolume);
-		RightChannelsMain[i]->SetVolumeMultiplier(newVolume);
-	}
-	
-	if (Debug)
+#if M1_DEBUG_OVERLAY
+	UM1DecodeDebugSubsystem* debugOverlay = Debug ? GetWorld()->GetSubsystem<UM1DecodeDebugSubsystem>() : nullptr;
+	if (debugOverlay)
 	{
-		FString CoeffInfo = TEXT("Component Individual Channels: ");
-		for (int i = 0; i < FMath::Min(4, MAX_INPUT_CHANNELS); i++) // Show first 4 channels
-		{
-			CoeffInfo += FString::Printf(TEXT("Ch%d[L=%.2f,R=%.2f] "), i, GainCoeffs[i * 2], GainCoeffs[i * 2 + 1]);
-		}
-		GEngine->AddOnScreenDebugMessage(-1, 0.1f, FColor::Orange, CoeffInfo);
+		// Show first 4 channels
+		debugOverlay->AddLine(FColor::Orange, TEXT("Component Individual Channels: Ch0[L=%.2f,R=%.2f] Ch1[L=%.2f,R=%.2f] Ch2[L=%.2f,R=%.2f] Ch3[L=%.2f,R=%.2f] Suppressed=%d"),
+			GainCoeffs[0], GainCoeffs[1], GainCoeffs[2], GainCoeffs[3], GainCoeffs[4], GainCoeffs[5], GainCoeffs[6], GainCoeffs[7], decodeVoices.SuppressedVolumeUpdates);
 	}
+#endif
 }
 
 void UM1DecodeComponent::StopAllAudioComponents()
@@ -475,6 +630,12 @@ void UM1DecodeComponent::StopAllAudioComponents()
 			RightChannelsMain[i]->SetSound(nullptr);
 		}
 	}
+
+	if (decodeVoices.SingleVoiceMain)
+	{
+		decodeVoices.SingleVoiceMain->Stop();
+		decodeVoices.SingleVoiceMain->SetSound(nullptr);
+	}
 }
 
 void UM1DecodeComponent::SetupIndividualChannelPlayback()
@@ -514,6 +675,30 @@ void UM1DecodeComponent::SetupIndividualChannelPlayback()
 	M1Common::PrintDebug(TCHAR_TO_ANSI(*FString::Printf(TEXT("Component individual channels: %d/%d assigned"), validChannels, GetRequiredChannelCount())));
 }
 
+bool UM1DecodeComponent::UsesSingleVoiceDecode()
+{
+	return useSingleVoiceDecode && MultichannelBed != nullptr && GetRequiredChannelCount() <= M1_SINGLE_VOICE_MAX_CHANNELS;
+}
+
+void UM1DecodeComponent::SetupSingleVoicePlayback()
+{
+#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 23) || ENGINE_MAJOR_VERSION == 5
+	MultichannelBed->VirtualizationMode = EVirtualizationMode::PlayWhenSilent;
+#else
+	MultichannelBed->bVirtualizeWhenSilent = true;
+#endif
+
+	decodeVoices.SingleVoiceMain->SetSound(MultichannelBed);
+
+	if (Debug)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, 
+			FString::Printf(TEXT("Component Single-Voice Decode: %d channel bed on 1 voice"), GetRequiredChannelCount()));
+	}
+
+	M1Common::PrintDebug(TCHAR_TO_ANSI(*FString::Printf(TEXT("component Single-voice decode: %d channel bed on 1 voice"), GetRequiredChannelCount())));
+}
+
 void UM1DecodeComponent::SetSoundsMain()
 {
 }
@@ -533,6 +718,10 @@ TArray<UAudioComponent*> UM1DecodeComponent::GetAudioComponentsMain()
 	for (UAudioComponent* componentR : RightChannelsMain) {
 		arrayOfAllPlayerComponents.Add(componentR);
 	}
+
+	if (decodeVoices.SingleVoiceMain) {
+		arrayOfAllPlayerComponents.Add(decodeVoices.SingleVoiceMain);
+	}
 	return arrayOfAllPlayerComponents;
 }
 
@@ -547,6 +736,10 @@ void UM1DecodeComponent::UpdateDecodeConfiguration()
 	// Update the required channel count
 	int requiredChannels = GetRequiredChannelCount();
 	this->MAX_INPUT_CHANNELS = requiredChannels;
+
+	// Preallocate the coefficient store for the selected mode so EvaluateDecode can write into it directly
+	GainCoeffs.SetNumZeroed(FMath::Max(m1Positional.getFormatCoeffCount(), requiredChannels * 2));
+	decodeVoices.ResetAppliedChannelVolumes(MAX_INPUT_CHANNELS);
 	
 	// Resize audio component arrays if needed
 	if (LeftChannelsMain.Num() < requiredChannels)
@@ -637,6 +830,11 @@ int UM1DecodeComponent::GetCurrentChannelCount()
 	return GetRequiredChannelCount();
 }
 
+int UM1DecodeComponent::GetSuppressedVolumeUpdateCount()
+{
+	return decodeVoices.SuppressedVolumeUpdates;
+}
+
 void UM1DecodeComponent::RefreshDecodeConfiguration()
 {
 	UpdateDecodeConfiguration();
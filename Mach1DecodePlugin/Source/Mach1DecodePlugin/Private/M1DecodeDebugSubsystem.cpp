@@ -0,0 +1,184 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeDebugSubsystem.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+#if M1_DEBUG_OVERLAY
+#include "Debug/DebugDrawService.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "SceneInterface.h"
+#include "SceneView.h"
+#endif
+
+void UM1DecodeDebugSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if M1_DEBUG_OVERLAY
+	Lines.Reserve(M1_DEBUG_OVERLAY_MAX_LINES);
+	Shapes.Reserve(M1_DEBUG_OVERLAY_MAX_SHAPES);
+	DrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &UM1DecodeDebugSubsystem::Draw));
+#endif
+}
+
+void UM1DecodeDebugSubsystem::Deinitialize()
+{
+#if M1_DEBUG_OVERLAY
+	UDebugDrawService::Unregister(DrawHandle);
+	DrawHandle.Reset();
+#endif
+
+	Super::Deinitialize();
+}
+
+#if M1_DEBUG_OVERLAY
+void UM1DecodeDebugSubsystem::AddValues(const FColor& Color, const TCHAR* Label, const float* Values, int32 NumValues)
+{
+	TCHAR* Text = AddLineBuffer(Color);
+	if (!Text)
+	{
+		return;
+	}
+
+	int32 Length = FCString::Snprintf(Text, M1_DEBUG_OVERLAY_LINE_LENGTH, TEXT("%s"), Label);
+	for (int32 i = 0; i < NumValues && Length >= 0 && Length < M1_DEBUG_OVERLAY_LINE_LENGTH - 1; i++)
+	{
+		int32 Written = FCString::Snprintf(Text + Length, M1_DEBUG_OVERLAY_LINE_LENGTH - Length, TEXT("%.2f, "), Values[i]);
+		if (Written < 0)
+		{
+			break; // line is full
+		}
+		Length += Written;
+	}
+}
+
+void UM1DecodeDebugSubsystem::AddSphere(const FVector& Center, float Radius, const FColor& Color)
+{
+	if (FShape* Shape = AddShape(EShape::Sphere, Color))
+	{
+		Shape->Center = Center;
+		Shape->Extent = FVector(Radius, 0, 0);
+	}
+}
+
+void UM1DecodeDebugSubsystem::AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color)
+{
+	if (FShape* Shape = AddShape(EShape::Box, Color))
+	{
+		Shape->Center = Center;
+		Shape->Extent = Extent;
+		Shape->Rotation = Rotation;
+	}
+}
+
+void UM1DecodeDebugSubsystem::AddIndexLabel(const FVector& Location, int32 Index)
+{
+	if (FShape* Shape = AddShape(EShape::IndexLabel, FColor::White))
+	{
+		Shape->Center = Location;
+		Shape->Index = Index;
+	}
+}
+
+void UM1DecodeDebugSubsystem::BeginFrameIfNeeded()
+{
+	if (BufferFrame != GFrameCounter)
+	{
+		// Reset() keeps the reserved storage
+		Lines.Reset();
+		Shapes.Reset();
+		BufferFrame = GFrameCounter;
+		DroppedCount = 0;
+	}
+}
+
+TCHAR* UM1DecodeDebugSubsystem::AddLineBuffer(const FColor& Color)
+{
+	BeginFrameIfNeeded();
+
+	if (Lines.Num() >= M1_DEBUG_OVERLAY_MAX_LINES)
+	{
+		DroppedCount++;
+		return nullptr;
+	}
+
+	FLine& Line = Lines[Lines.AddUninitialized()];
+	Line.Color = Color;
+	Line.Text[0] = 0;
+	return Line.Text;
+}
+
+UM1DecodeDebugSubsystem::FShape* UM1DecodeDebugSubsystem::AddShape(EShape Type, const FColor& Color)
+{
+	BeginFrameIfNeeded();
+
+	if (Shapes.Num() >= M1_DEBUG_OVERLAY_MAX_SHAPES)
+	{
+		DroppedCount++;
+		return nullptr;
+	}
+
+	FShape& Shape = Shapes[Shapes.AddUninitialized()];
+	Shape.Type = Type;
+	Shape.Color = Color;
+	Shape.Rotation = FQuat::Identity;
+	Shape.Index = 0;
+	return &Shape;
+}
+
+void UM1DecodeDebugSubsystem::Draw(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	// Only draw into viewports of this world, and only while decoders keep recording
+	if (!Canvas || !Canvas->Canvas || !Canvas->SceneView || !Canvas->SceneView->Family || !Canvas->SceneView->Family->Scene
+		|| Canvas->SceneView->Family->Scene->GetWorld() != GetWorld() || GFrameCounter - BufferFrame > 1)
+	{
+		return;
+	}
+
+	UFont* Font = GEngine->GetSmallFont();
+
+	for (const FShape& Shape : Shapes)
+	{
+		switch (Shape.Type)
+		{
+		case EShape::Sphere:
+			DrawDebugCanvasWireSphere(Canvas, Shape.Center, Shape.Color, Shape.Extent.X, 16);
+			break;
+		case EShape::Box:
+			DrawDebugCanvasWireBox(Canvas, FTransform(Shape.Rotation, Shape.Center).ToMatrixNoScale(), FBox(-Shape.Extent, Shape.Extent), Shape.Color);
+			break;
+		case EShape::IndexLabel:
+		{
+			const FVector ScreenPosition = Canvas->Project(Shape.Center);
+			if (ScreenPosition.Z > 0)
+			{
+				TCHAR Label[12];
+				FCString::Snprintf(Label, 12, TEXT("%d"), Shape.Index);
+				Canvas->Canvas->DrawShadowedString(ScreenPosition.X, ScreenPosition.Y, Label, Font, Shape.Color);
+			}
+			break;
+		}
+		}
+	}
+
+	float Y = 50;
+	const float LineHeight = Font->GetMaxCharHeight() + 2;
+	for (const FLine& Line : Lines)
+	{
+		Canvas->Canvas->DrawShadowedString(10, Y, Line.Text, Font, Line.Color);
+		Y += LineHeight;
+	}
+
+	if (DroppedCount > 0)
+	{
+		TCHAR Dropped[64];
+		FCString::Snprintf(Dropped, 64, TEXT("Mach1 debug overlay full, %d entries dropped"), DroppedCount);
+		Canvas->Canvas->DrawShadowedString(10, Y, Dropped, Font, FColor::Red);
+	}
+}
+#endif
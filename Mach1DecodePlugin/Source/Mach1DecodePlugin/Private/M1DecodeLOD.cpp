@@ -0,0 +1,184 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeLOD.h"
+#include "M1Common.h"
+#include "Engine/Engine.h"
+#include "Sound/SoundWave.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+bool FM1DecodeLOD::Update(const FM1DecodeLODSettings& Settings, float Distance, float DeltaSeconds, Mach1DecodePositional& Positional)
+{
+	if (!Settings.UseLOD)
+	{
+		SetLOD(EM1DecodeLODLevel::Full, Settings, Positional);
+		return true;
+	}
+
+	// thresholds are 10% closer on the way back to avoid flapping at the boundary
+	float reducedDistance = (LOD != EM1DecodeLODLevel::Full) ? Settings.ReducedDistance * 0.9f : Settings.ReducedDistance;
+	float virtualDistance = (LOD == EM1DecodeLODLevel::Virtual) ? Settings.VirtualDistance * 0.9f : Settings.VirtualDistance;
+
+	// the quiet test has its own band and hold time, a decoder hovering around the threshold would otherwise restart its voices every evaluation
+	float quietThresholdDb = (LOD == EM1DecodeLODLevel::Virtual) ? Settings.QuietThresholdDb + Settings.QuietHysteresisDb : Settings.QuietThresholdDb;
+	bool isBelowQuiet = PeakGain * Settings.Volume < FMath::Pow(10.0f, quietThresholdDb / 20.0f);
+	QuietTime = isBelowQuiet ? QuietTime + DeltaSeconds : 0;
+	bool isQuiet = isBelowQuiet && (LOD == EM1DecodeLODLevel::Virtual || QuietTime >= Settings.QuietHoldTime);
+
+	EM1DecodeLODLevel lod = EM1DecodeLODLevel::Full;
+	if (Distance > virtualDistance || isQuiet)
+	{
+		lod = EM1DecodeLODLevel::Virtual;
+	}
+	else if (Distance > reducedDistance)
+	{
+		lod = EM1DecodeLODLevel::Reduced;
+	}
+
+	if (lod != LOD)
+	{
+		SetLOD(lod, Settings, Positional);
+		return true;
+	}
+
+	float interval = 0;
+	if (LOD == EM1DecodeLODLevel::Reduced) interval = Settings.ReducedInterval;
+	if (LOD == EM1DecodeLODLevel::Virtual) interval = Settings.VirtualInterval;
+
+	TimeSinceEvaluate += DeltaSeconds;
+	if (TimeSinceEvaluate < interval)
+	{
+		return false;
+	}
+	TimeSinceEvaluate = 0;
+	return true;
+}
+
+void FM1DecodeLOD::SetLOD(EM1DecodeLODLevel InLOD, const FM1DecodeLODSettings& Settings, Mach1DecodePositional& Positional)
+{
+	if (InLOD == LOD)
+	{
+		return;
+	}
+
+	// Reduced decodes one mode lower than the bed, Virtual only tracks the listener with Spatial 4
+	Mach1DecodeMode reducedMode = M1DecodeSpatial_14;
+	if (InLOD == EM1DecodeLODLevel::Reduced)
+	{
+		reducedMode = static_cast<Mach1DecodeMode>(FMath::Max(0, Settings.DecodeMode - 1));
+	}
+	else if (InLOD == EM1DecodeLODLevel::Virtual)
+	{
+		reducedMode = M1DecodeSpatial_4;
+	}
+	Positional.setReducedDecodeMode(reducedMode);
+
+	if (Settings.Debug && GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Cyan, FString::Printf(TEXT("LOD %d -> %d"), (int)LOD, (int)InLOD));
+	}
+
+	LOD = InLOD;
+	TimeSinceEvaluate = 0;
+}
+
+void FM1DecodeLOD::SetPeakGain(const TArray<float>& GainCoeffs)
+{
+	PeakGain = 0;
+	for (float coeff : GainCoeffs)
+	{
+		PeakGain = FMath::Max(PeakGain, coeff);
+	}
+}
+
+void FM1DecodeLOD::StartPlayback(float StartTime, double AudioTime)
+{
+	PlaybackTime = StartTime;
+	PlaybackAudioTime = AudioTime;
+	PlaybackStarted = true;
+	PlaybackPaused = false;
+	Virtualized = false;
+}
+
+void FM1DecodeLOD::StopPlayback()
+{
+	PlaybackStarted = false;
+	Virtualized = false;
+}
+
+void FM1DecodeLOD::SetPaused(bool Paused)
+{
+	PlaybackPaused = Paused;
+}
+
+void FM1DecodeLOD::SetPlaybackTime(float Time, double AudioTime)
+{
+	PlaybackTime = Time;
+	PlaybackAudioTime = AudioTime;
+}
+
+void FM1DecodeLOD::AdvancePlaybackTime(double AudioTime, USoundBase* Sound)
+{
+	float deltaSeconds = FMath::Max(0.0f, (float)(AudioTime - PlaybackAudioTime));
+	PlaybackAudioTime = AudioTime;
+
+	if (!PlaybackStarted || PlaybackPaused)
+	{
+		return;
+	}
+
+	PlaybackTime += deltaSeconds;
+
+	USoundWave* wave = Cast<USoundWave>(Sound);
+	if (wave && wave->Duration > 0 && PlaybackTime >= wave->Duration)
+	{
+		if (wave->bLooping)
+		{
+			PlaybackTime = FMath::Fmod(PlaybackTime, wave->Duration);
+		}
+		else
+		{
+			// finished, a virtualized bed has nothing left to restart
+			PlaybackStarted = false;
+			Virtualized = false;
+		}
+	}
+}
+
+void FM1DecodeLOD::UpdateVirtualization(const FM1DecodeLODSettings& Settings, float DeltaSeconds, TFunctionRef<void()> StopVoices, TFunctionRef<void(float, float)> RestartVoices)
+{
+	if (PeakGain * Settings.Volume < FMath::Pow(10.0f, Settings.VirtualizeThresholdDb / 20.0f))
+	{
+		InaudibleTime += DeltaSeconds;
+	}
+	else
+	{
+		InaudibleTime = 0;
+	}
+
+	bool shouldVirtualize = (LOD == EM1DecodeLODLevel::Virtual) || (Settings.UseVirtualization && InaudibleTime >= Settings.VirtualizeDelay);
+
+	if (shouldVirtualize && !Virtualized && PlaybackStarted)
+	{
+		StopVoices();
+		Virtualized = true;
+
+		if (Settings.Debug && GEngine)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Cyan, FString::Printf(TEXT("Virtualized at %.2fs"), PlaybackTime));
+		}
+	}
+	else if (!shouldVirtualize && Virtualized && PlaybackStarted && !PlaybackPaused)
+	{
+		// every channel restarts together at the position playback would have reached
+		RestartVoices(PlaybackTime, DEVIRTUALIZE_FADE_DURATION);
+		Virtualized = false;
+
+		if (Settings.Debug && GEngine)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::Cyan, FString::Printf(TEXT("Devirtualized at %.2fs"), PlaybackTime));
+		}
+	}
+}
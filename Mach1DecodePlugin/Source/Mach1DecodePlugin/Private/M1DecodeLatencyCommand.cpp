@@ -0,0 +1,66 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "Mach1DecodePluginPrivatePCH.h"
+#include "HAL/IConsoleManager.h"
+
+#include "Mach1DecodeLatencyHarness.h"
+
+#if !UE_BUILD_SHIPPING
+
+// Sweeps the configurations that matter for the VR latency budget and logs one line per configuration.
+// "tick" delivers orientation once per game frame before the next block, like the decode actor and component.
+// "queue" pushes tracker samples into a Mach1OrientationQueue consumed at their sample offsets.
+static void MeasureDecodeLatency(const TArray<FString>& Args)
+{
+	int steps = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+	float sampleRate = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 48000;
+
+	const float filterSpeeds[] = { 1.0f, 0.95f, 0.9f };
+	const int bufferSizes[] = { 256, 512, 1024 };
+	const int rampLengths[] = { 0, 64 };
+
+	struct FDelivery
+	{
+		const TCHAR* Name;
+		float UpdateInterval;
+		bool UseQueue;
+	};
+	const FDelivery deliveries[] = { { TEXT("tick 60Hz"), 1 / 60.0f, false }, { TEXT("tick 90Hz"), 1 / 90.0f, false }, { TEXT("queue 1kHz"), 0.001f, true } };
+
+	UE_LOG(LogTemp, Log, TEXT("Mach1 decode latency, %d steps at %.0f Hz, milliseconds from orientation step to half gain change"), steps, sampleRate);
+
+	for (const FDelivery& delivery : deliveries)
+	{
+		for (float filterSpeed : filterSpeeds)
+		{
+			for (int bufferSize : bufferSizes)
+			{
+				for (int rampLength : rampLengths)
+				{
+					Mach1DecodeLatencyConfig config;
+					config.filterSpeed = filterSpeed;
+					config.bufferSize = bufferSize;
+					config.rampLength = rampLength;
+					config.sampleRate = sampleRate;
+					config.updateInterval = delivery.UpdateInterval;
+					config.useOrientationQueue = delivery.UseQueue;
+					config.steps = steps;
+
+					Mach1DecodeLatencyResult result = Mach1DecodeLatencyHarness::measure(config);
+
+					UE_LOG(LogTemp, Log, TEXT("%-10s filter %.2f buffer %4d ramp %3d : p50 %6.2f p95 %6.2f p99 %6.2f max %6.2f (%d detected, %d missed)"),
+						delivery.Name, filterSpeed, bufferSize, rampLength, result.p50, result.p95, result.p99, result.max, result.detected, result.missed);
+				}
+			}
+		}
+	}
+}
+
+static FAutoConsoleCommand MeasureDecodeLatencyCommand(
+	TEXT("m1.MeasureDecodeLatency"),
+	TEXT("Measure Mach1 decode motion-to-gain latency percentiles offline. Usage: m1.MeasureDecodeLatency [Steps] [SampleRate]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&MeasureDecodeLatency));
+
+#endif
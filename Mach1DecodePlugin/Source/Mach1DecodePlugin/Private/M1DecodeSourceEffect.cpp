@@ -0,0 +1,164 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeSourceEffect.h"
+#include "Misc/ScopeLock.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+static FCriticalSection& GetHandoffRegistryLock()
+{
+	static FCriticalSection Lock;
+	return Lock;
+}
+
+static TMap<int32, TWeakPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe>>& GetHandoffRegistry()
+{
+	static TMap<int32, TWeakPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe>> Registry;
+	return Registry;
+}
+
+FM1DecodeGainHandoff::FM1DecodeGainHandoff()
+	: Middle(1)
+	, WriteIndex(0)
+	, ReadIndex(2)
+{
+	FMemory::Memzero(Buffers, sizeof(Buffers));
+	FMemory::Memzero(Counts, sizeof(Counts));
+}
+
+void FM1DecodeGainHandoff::Publish(const float* Gains, int32 NumGains)
+{
+	NumGains = FMath::Clamp(NumGains, 0, MaxGains);
+	FMemory::Memcpy(Buffers[WriteIndex], Gains, NumGains * sizeof(float));
+	Counts[WriteIndex] = NumGains;
+
+	// hand the filled buffer over and take back whichever one was waiting
+	WriteIndex = Middle.exchange(WriteIndex | DirtyFlag, std::memory_order_acq_rel) & ~DirtyFlag;
+}
+
+bool FM1DecodeGainHandoff::Acquire(const float*& OutGains, int32& OutNumGains)
+{
+	if ((Middle.load(std::memory_order_relaxed) & DirtyFlag) == 0)
+	{
+		return false;
+	}
+
+	ReadIndex = Middle.exchange(ReadIndex, std::memory_order_acq_rel) & ~DirtyFlag;
+	OutGains = Buffers[ReadIndex];
+	OutNumGains = Counts[ReadIndex];
+	return true;
+}
+
+int32 FM1DecodeGainHandoff::Register(TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> Handoff)
+{
+	static int32 NextHandoffId = 1;
+
+	FScopeLock Lock(&GetHandoffRegistryLock());
+	int32 HandoffId = NextHandoffId++;
+	GetHandoffRegistry().Add(HandoffId, Handoff);
+	return HandoffId;
+}
+
+void FM1DecodeGainHandoff::Unregister(int32 HandoffId)
+{
+	FScopeLock Lock(&GetHandoffRegistryLock());
+	GetHandoffRegistry().Remove(HandoffId);
+}
+
+TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> FM1DecodeGainHandoff::Find(int32 HandoffId)
+{
+	FScopeLock Lock(&GetHandoffRegistryLock());
+	if (TWeakPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe>* Handoff = GetHandoffRegistry().Find(HandoffId))
+	{
+		return Handoff->Pin();
+	}
+	return nullptr;
+}
+
+void FM1DecodeSourceEffect::Init(const FSoundEffectSourceInitData& InitData)
+{
+	NumChannels = InitData.NumSourceChannels;
+	FMemory::Memzero(CurrentGains, sizeof(CurrentGains));
+	FMemory::Memzero(TargetGains, sizeof(TargetGains));
+	HasGains = false;
+}
+
+void FM1DecodeSourceEffect::OnPresetChanged()
+{
+	GET_EFFECT_SETTINGS(M1DecodeSourceEffect);
+
+	// only touches the registry lock when the preset points at a different decoder
+	if (Settings.HandoffId != HandoffId || !Handoff.IsValid())
+	{
+		HandoffId = Settings.HandoffId;
+		Handoff = FM1DecodeGainHandoff::Find(HandoffId);
+	}
+}
+
+void FM1DecodeSourceEffect::ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData)
+{
+	const float* InBuffer = InData.InputSourceEffectBufferPtr;
+	const int32 NumFrames = NumChannels > 0 ? InData.NumSamples / NumChannels : 0;
+	const int32 NumDecodeChannels = FMath::Min(NumChannels, M1_SINGLE_VOICE_MAX_CHANNELS);
+
+	const float* NewGains = nullptr;
+	int32 NumNewGains = 0;
+	if (Handoff.IsValid() && Handoff->Acquire(NewGains, NumNewGains))
+	{
+		FMemory::Memzero(TargetGains, sizeof(TargetGains));
+		FMemory::Memcpy(TargetGains, NewGains, NumNewGains * sizeof(float));
+
+		if (!HasGains)
+		{
+			FMemory::Memcpy(CurrentGains, TargetGains, sizeof(CurrentGains));
+			HasGains = true;
+		}
+	}
+
+	// linear ramp from the previous block's gains to the newest ones
+	float GainSteps[M1_SINGLE_VOICE_MAX_CHANNELS * 2];
+	for (int32 i = 0; i < NumDecodeChannels * 2; i++)
+	{
+		GainSteps[i] = NumFrames > 0 ? (TargetGains[i] - CurrentGains[i]) / NumFrames : 0.0f;
+	}
+
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const float* InFrame = InBuffer + Frame * NumChannels;
+		float* OutFrame = OutAudioBufferData + Frame * NumChannels;
+
+		float Left = 0.0f;
+		float Right = 0.0f;
+		for (int32 Channel = 0; Channel < NumDecodeChannels; Channel++)
+		{
+			CurrentGains[Channel * 2 + 0] += GainSteps[Channel * 2 + 0];
+			CurrentGains[Channel * 2 + 1] += GainSteps[Channel * 2 + 1];
+
+			Left += InFrame[Channel] * CurrentGains[Channel * 2 + 0];
+			Right += InFrame[Channel] * CurrentGains[Channel * 2 + 1];
+		}
+
+		if (NumChannels == 1)
+		{
+			OutFrame[0] = 0.5f * (Left + Right);
+			continue;
+		}
+
+		OutFrame[0] = Left;
+		OutFrame[1] = Right;
+		for (int32 Channel = 2; Channel < NumChannels; Channel++)
+		{
+			OutFrame[Channel] = 0.0f;
+		}
+	}
+
+	// snap to the target so rounding in the ramp never accumulates
+	FMemory::Memcpy(CurrentGains, TargetGains, sizeof(CurrentGains));
+}
+
+void UM1DecodeSourceEffectPreset::SetSettings(const FM1DecodeSourceEffectSettings& InSettings)
+{
+	UpdateSettings(InSettings);
+}
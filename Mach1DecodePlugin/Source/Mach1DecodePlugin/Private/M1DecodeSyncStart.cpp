@@ -0,0 +1,176 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeSyncStart.h"
+#include "M1DecodeWorldSubsystem.h"
+#include "TimerManager.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+#if M1_SYNC_START_QUARTZ
+#include "Quartz/QuartzSubsystem.h"
+#include "Quartz/AudioMixerClockHandle.h"
+#include "Sound/QuartzQuantizationUtilities.h"
+#endif
+
+FM1DecodeSyncStart::FM1DecodeSyncStart(const UObject* WorldContextObject) : WorldContextObject(WorldContextObject)
+{
+}
+
+void FM1DecodeSyncStart::Add(UAudioComponent* Component, float StartTime, float FadeInDuration)
+{
+	if (Component && Component->GetSound())
+	{
+		Entries.Add({ Component, StartTime, FadeInDuration });
+	}
+}
+
+#if M1_SYNC_START_QUARTZ
+UQuartzClockHandle* FM1DecodeSyncStart::GetSyncClock()
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UQuartzSubsystem* Quartz = World ? World->GetSubsystem<UQuartzSubsystem>() : nullptr;
+	if (!Quartz)
+	{
+		return nullptr;
+	}
+
+	FOnQuartzCommandEventBP NoDelegate;
+
+	UQuartzClockHandle* Clock = nullptr;
+	if (Quartz->DoesClockExist(WorldContextObject, M1_SYNC_CLOCK_NAME))
+	{
+		Clock = Quartz->GetHandleForClock(WorldContextObject, M1_SYNC_CLOCK_NAME);
+	}
+	else
+	{
+		Clock = Quartz->CreateNewClock(WorldContextObject, M1_SYNC_CLOCK_NAME, FQuartzClockSettings());
+
+		FQuartzQuantizationBoundary Immediate;
+		Clock->SetTicksPerSecond(WorldContextObject, Immediate, NoDelegate, Clock, M1_SYNC_CLOCK_TICKS_PER_SECOND);
+	}
+
+	// the subsystem query, UQuartzClockHandle::IsClockRunning is not in every engine version with Quartz
+	if (Clock && !Quartz->IsClockRunning(WorldContextObject, M1_SYNC_CLOCK_NAME))
+	{
+		Clock->StartClock(WorldContextObject, Clock);
+
+		// anchors the clock's transport on the world audio timeline for StartAtAudioTime()
+		if (UM1DecodeWorldSubsystem* Subsystem = World->GetSubsystem<UM1DecodeWorldSubsystem>())
+		{
+			Subsystem->SetSyncClockStartAudioTime(World->GetAudioTimeSeconds());
+		}
+	}
+	return Clock;
+}
+
+int FM1DecodeSyncStart::PlayQuantized(UQuartzClockHandle* Clock, FQuartzQuantizationBoundary Boundary)
+{
+	int started = Entries.Num();
+	FOnQuartzCommandEventBP NoDelegate;
+	for (FEntry& Entry : Entries)
+	{
+		Entry.Component->PlayQuantized(WorldContextObject, Clock, Boundary, NoDelegate, Entry.StartTime, Entry.FadeInDuration);
+	}
+	Entries.Reset();
+	return started;
+}
+#endif
+
+int FM1DecodeSyncStart::Start(float DelaySeconds)
+{
+	int started = Entries.Num();
+
+#if M1_SYNC_START_QUARTZ
+	UQuartzClockHandle* Clock = started > 0 ? GetSyncClock() : nullptr;
+	if (Clock)
+	{
+		FQuartzQuantizationBoundary Boundary;
+		Boundary.Quantization = EQuartzCommandQuantization::Tick;
+		if (DelaySeconds > 0)
+		{
+			// Whole ticks after the audio renderer receives the commands; one frame's commands arrive together
+			Boundary.Multiplier = FMath::Max(1.0f, FMath::CeilToFloat(DelaySeconds * M1_SYNC_CLOCK_TICKS_PER_SECOND));
+			Boundary.CountingReferencePoint = EQuarztQuantizationReference::CurrentTimeRelative;
+		}
+		else
+		{
+			// Next tick of the shared clock, counted from the clock's start so commands split across render blocks still align
+			Boundary.Multiplier = 1.0f;
+			Boundary.CountingReferencePoint = EQuarztQuantizationReference::TransportRelative;
+		}
+		return PlayQuantized(Clock, Boundary);
+	}
+#endif
+
+	UWorld* TimerWorld = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (DelaySeconds > 0 && TimerWorld)
+	{
+		TArray<TWeakObjectPtr<UAudioComponent>> Components;
+		TArray<FEntry> Delayed = Entries;
+		for (const FEntry& Entry : Delayed)
+		{
+			Components.Add(Entry.Component);
+		}
+
+		FTimerHandle Handle;
+		TimerWorld->GetTimerManager().SetTimer(Handle, FTimerDelegate::CreateLambda([Components, Delayed]()
+		{
+			for (int i = 0; i < Delayed.Num(); i++)
+			{
+				if (UAudioComponent* Component = Components[i].Get())
+				{
+					Component->FadeIn(Delayed[i].FadeInDuration, 1.0f, Delayed[i].StartTime);
+				}
+			}
+		}), DelaySeconds, false);
+
+		Entries.Reset();
+		return started;
+	}
+
+	for (FEntry& Entry : Entries)
+	{
+		Entry.Component->FadeIn(Entry.FadeInDuration, 1.0f, Entry.StartTime);
+	}
+	Entries.Reset();
+	return started;
+}
+
+int FM1DecodeSyncStart::StartAtAudioTime(double StartAudioTime)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World)
+	{
+		return Start();
+	}
+
+	double delay = StartAudioTime - World->GetAudioTimeSeconds();
+
+#if M1_SYNC_START_QUARTZ
+	UQuartzClockHandle* Clock = Entries.Num() > 0 ? GetSyncClock() : nullptr;
+	UM1DecodeWorldSubsystem* Subsystem = World->GetSubsystem<UM1DecodeWorldSubsystem>();
+	if (Clock && Subsystem && Subsystem->GetSyncClockStartAudioTime() >= 0)
+	{
+		// The start as a tick of the clock's own transport: starts asked for the same audio time land on the
+		// same tick whichever frame queued them, instead of each frame's commands counting from their arrival
+		double clockStart = Subsystem->GetSyncClockStartAudioTime();
+		double targetTick = FMath::CeilToDouble((StartAudioTime - clockStart) * M1_SYNC_CLOCK_TICKS_PER_SECOND);
+		double currentTick = (World->GetAudioTimeSeconds() - clockStart) * M1_SYNC_CLOCK_TICKS_PER_SECOND;
+
+		// the first multiple of targetTick on the transport is targetTick itself, as long as the commands reach the renderer before it
+		if (targetTick > currentTick + M1_SYNC_COMMAND_MARGIN_SECONDS * M1_SYNC_CLOCK_TICKS_PER_SECOND)
+		{
+			FQuartzQuantizationBoundary Boundary;
+			Boundary.Quantization = EQuartzCommandQuantization::Tick;
+			Boundary.Multiplier = (float)targetTick;
+			Boundary.CountingReferencePoint = EQuarztQuantizationReference::TransportRelative;
+			return PlayQuantized(Clock, Boundary);
+		}
+	}
+#endif
+
+	// too close to the clock's timeline to hit a given tick: start as soon as possible
+	return Start(FMath::Max(0.0f, (float)delay));
+}
@@ -0,0 +1,123 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeVoices.h"
+#include "M1Common.h"
+#include "M1DecodeSyncStart.h"
+#include "M1VolumeBatch.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+void FM1DecodeVoices::InitSingleVoice(UObject* Outer, USceneComponent* AttachComponent)
+{
+	if (SingleVoiceMain)
+	{
+		return;
+	}
+
+	// gains published by SetSingleVoiceGains() reach the effect instance through the handoff registry
+	SingleVoiceGains = MakeShared<FM1DecodeGainHandoff, ESPMode::ThreadSafe>();
+	SingleVoiceHandoffId = FM1DecodeGainHandoff::Register(SingleVoiceGains);
+
+	FM1DecodeSourceEffectSettings effectSettings;
+	effectSettings.HandoffId = SingleVoiceHandoffId;
+	SingleVoicePreset = NewObject<UM1DecodeSourceEffectPreset>(Outer);
+	SingleVoicePreset->SetSettings(effectSettings);
+
+	FSourceEffectChainEntry chainEntry;
+	chainEntry.Preset = SingleVoicePreset;
+	chainEntry.bBypass = false;
+	SingleVoiceChain = NewObject<USoundEffectSourcePresetChain>(Outer);
+	SingleVoiceChain->Chain.Add(chainEntry);
+
+	SingleVoiceMain = NewObject <UAudioComponent>(AttachComponent, FName(*FString::Printf(TEXT("SoundCubeBed %d"), Outer->GetUniqueID())));
+	SingleVoiceMain->RegisterComponent(); // only for runtime
+	SingleVoiceMain->bAllowSpatialization = false;
+	SingleVoiceMain->SourceEffectChain = SingleVoiceChain;
+	SingleVoiceMain->AttachToComponent(AttachComponent, FAttachmentTransformRules::KeepRelativeTransform);
+}
+
+void FM1DecodeVoices::Release()
+{
+	if (SingleVoiceHandoffId != 0)
+	{
+		FM1DecodeGainHandoff::Unregister(SingleVoiceHandoffId);
+		SingleVoiceHandoffId = 0;
+	}
+}
+
+void FM1DecodeVoices::QueueSynchronizedStart(FM1DecodeSyncStart& SyncStart, const TArray<UAudioComponent*>& LeftChannels, const TArray<UAudioComponent*>& RightChannels, int NumChannels, float StartTime, float FadeIn) const
+{
+	if (IsSingleVoiceActive)
+	{
+		SyncStart.Add(SingleVoiceMain, StartTime, FadeIn);
+		return;
+	}
+
+	for (int i = 0; i < NumChannels; i++)
+	{
+		if (LeftChannels[i]->GetSound())
+		{
+			LeftChannels[i]->Stop();
+			RightChannels[i]->Stop();
+
+			SyncStart.Add(LeftChannels[i], StartTime, FadeIn);
+			SyncStart.Add(RightChannels[i], StartTime, FadeIn);
+		}
+	}
+}
+
+void FM1DecodeVoices::SetChannelVolumes(const TArray<float>& GainCoeffs, float MasterGain, float ThresholdDb, const TArray<UAudioComponent*>& LeftChannels, const TArray<UAudioComponent*>& RightChannels, int NumChannels, FM1VolumeBatch* Batch)
+{
+	// Individual channel processing - each channel gets its own spatial coefficient
+	float maxRatio = FMath::Pow(10.0f, FMath::Max(0.0f, ThresholdDb) / 20.0f);
+	float minRatio = 1.0f / maxRatio;
+	float newVolume = 0;
+
+	if (AppliedChannelVolumes.Num() < NumChannels * 2)
+	{
+		ResetAppliedChannelVolumes(NumChannels);
+	}
+
+	for (int i = 0; i < NumChannels * 2; i++)
+	{
+		newVolume = GainCoeffs[i] * MasterGain;
+		newVolume = FMath::Max(MIN_SOUND_VOLUME, newVolume);
+
+		float appliedVolume = AppliedChannelVolumes[i];
+		if (appliedVolume > 0 && newVolume >= appliedVolume * minRatio && newVolume <= appliedVolume * maxRatio)
+		{
+			SuppressedVolumeUpdates++;
+			continue;
+		}
+
+		UAudioComponent* channel = (i % 2 == 0) ? LeftChannels[i / 2] : RightChannels[i / 2];
+		if (Batch)
+		{
+			Batch->Add(channel, newVolume);
+		}
+		else
+		{
+			channel->SetVolumeMultiplier(newVolume);
+		}
+		AppliedChannelVolumes[i] = newVolume;
+	}
+}
+
+void FM1DecodeVoices::ResetAppliedChannelVolumes(int NumChannels)
+{
+	AppliedChannelVolumes.Init(-1, NumChannels * 2);
+}
+
+void FM1DecodeVoices::SetSingleVoiceGains(const TArray<float>& GainCoeffs, float MasterGain, int NumChannels)
+{
+	float gains[M1_SINGLE_VOICE_MAX_CHANNELS * 2];
+	int numGains = FMath::Min(NumChannels, M1_SINGLE_VOICE_MAX_CHANNELS) * 2;
+
+	for (int i = 0; i < numGains; i++)
+	{
+		gains[i] = GainCoeffs[i] * MasterGain;
+	}
+	SingleVoiceGains->Publish(gains, numGains);
+}
@@ -0,0 +1,292 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1DecodeWorldSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 18) || ENGINE_MAJOR_VERSION == 5
+#include "HeadMountedDisplay.h"
+#include "HeadMountedDisplayFunctionLibrary.h"
+#elif ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 17
+#include "Kismet/HeadMountedDisplayFunctionLibrary.h"
+#include "Kismet/KismetMathLibrary.h"
+#endif
+
+static FVector GetDecoderLocation(AM1DecodeActor* Decoder)
+{
+	return Decoder->GetActorLocation();
+}
+
+static FVector GetDecoderLocation(UM1DecodeComponent* Decoder)
+{
+	return Decoder->GetComponentLocation();
+}
+
+static glm::vec3 ToIndexPosition(FVector Position)
+{
+	return glm::vec3((float)Position.X, (float)Position.Y, (float)Position.Z);
+}
+
+static glm::quat ToIndexRotation(FQuat Rotation)
+{
+	return glm::quat((float)Rotation.W, (float)Rotation.X, (float)Rotation.Y, (float)Rotation.Z);
+}
+
+template<typename DecoderType>
+static void AddRegisteredDecoder(TArray<TM1RegisteredDecoder<DecoderType>>& Decoders, Mach1PositionalSpatialIndex& Index, DecoderType* Decoder)
+{
+	for (const TM1RegisteredDecoder<DecoderType>& Entry : Decoders)
+	{
+		if (Entry.Decoder.Get() == Decoder)
+		{
+			return;
+		}
+	}
+
+	TM1RegisteredDecoder<DecoderType>& Entry = Decoders.AddDefaulted_GetRef();
+	Entry.Decoder = Decoder;
+	Entry.IndexedLocation = GetDecoderLocation(Decoder);
+	Entry.IndexHandle = Index.insert(ToIndexPosition(Entry.IndexedLocation), glm::vec3(0));
+}
+
+// Removes Decoder, or every destroyed decoder when Decoder is null, together with its index entry
+template<typename DecoderType>
+static void RemoveRegisteredDecoders(TArray<TM1RegisteredDecoder<DecoderType>>& Decoders, Mach1PositionalSpatialIndex& Index, DecoderType* Decoder)
+{
+	Decoders.RemoveAll([&Index, Decoder](const TM1RegisteredDecoder<DecoderType>& Entry)
+	{
+		bool remove = Decoder ? Entry.Decoder.Get() == Decoder : !Entry.Decoder.IsValid();
+		if (remove)
+		{
+			Index.remove(Entry.IndexHandle);
+		}
+		return remove;
+	});
+}
+
+// Moves the index entries of decoders that moved and gathers this frame's cull distances
+template<typename DecoderType>
+static void SyncEmitterIndex(TArray<TM1RegisteredDecoder<DecoderType>>& Decoders, Mach1PositionalSpatialIndex& Index, const FM1ListenerFrame& Listener, float& MaxCullDistance, int32& HandleCount)
+{
+	for (TM1RegisteredDecoder<DecoderType>& Entry : Decoders)
+	{
+		const FVector Location = GetDecoderLocation(Entry.Decoder.Get());
+		if (Location != Entry.IndexedLocation)
+		{
+			Index.update(Entry.IndexHandle, ToIndexPosition(Location), glm::vec3(0));
+			Entry.IndexedLocation = Location;
+		}
+
+		Entry.CullDistance = Entry.Decoder->GetCullDistance(Listener);
+		MaxCullDistance = FMath::Max(MaxCullDistance, Entry.CullDistance);
+		HandleCount = FMath::Max(HandleCount, Entry.IndexHandle + 1);
+	}
+}
+
+template<typename DecoderType>
+static void EvaluateRegisteredDecoders(TArray<TM1RegisteredDecoder<DecoderType>>& Decoders, const TBitArray<>& IsNear, const FM1ListenerFrame& Listener)
+{
+	for (TM1RegisteredDecoder<DecoderType>& Entry : Decoders)
+	{
+		if (Entry.CullDistance > 0 && !IsNear[Entry.IndexHandle])
+		{
+			Entry.Decoder->EvaluateCulled(Listener);
+		}
+		else
+		{
+			Entry.Decoder->EvaluateDecode(Listener);
+		}
+	}
+}
+
+void UM1DecodeWorldSubsystem::RegisterDecoder(AM1DecodeActor* Decoder)
+{
+	AddRegisteredDecoder(DecodeActors, EmitterIndex, Decoder);
+}
+
+void UM1DecodeWorldSubsystem::RegisterDecoder(UM1DecodeComponent* Decoder)
+{
+	AddRegisteredDecoder(DecodeComponents, EmitterIndex, Decoder);
+}
+
+void UM1DecodeWorldSubsystem::UnregisterDecoder(AM1DecodeActor* Decoder)
+{
+	RemoveRegisteredDecoders(DecodeActors, EmitterIndex, Decoder);
+}
+
+void UM1DecodeWorldSubsystem::UnregisterDecoder(UM1DecodeComponent* Decoder)
+{
+	RemoveRegisteredDecoders(DecodeComponents, EmitterIndex, Decoder);
+}
+
+int UM1DecodeWorldSubsystem::GetRegisteredDecoderCount() const
+{
+	return DecodeActors.Num() + DecodeComponents.Num();
+}
+
+void UM1DecodeWorldSubsystem::RegisterOccluder(UM1OccluderComponent* Occluder)
+{
+	for (const FM1RegisteredOccluder& Entry : Occluders)
+	{
+		if (Entry.Occluder.Get() == Occluder)
+		{
+			return;
+		}
+	}
+
+	FM1RegisteredOccluder& Entry = Occluders.AddDefaulted_GetRef();
+	Entry.Occluder = Occluder;
+	Entry.IndexedTransform = Occluder->GetComponentTransform();
+	Entry.IndexedExtent = Occluder->GetScaledBoxExtent();
+	Entry.Handle = Occlusion.addOccluder(ToIndexPosition(Entry.IndexedTransform.GetLocation()), ToIndexRotation(Entry.IndexedTransform.GetRotation()), ToIndexPosition(Entry.IndexedExtent * 2), Occluder->Transmission);
+}
+
+void UM1DecodeWorldSubsystem::UnregisterOccluder(UM1OccluderComponent* Occluder)
+{
+	Occluders.RemoveAll([this, Occluder](const FM1RegisteredOccluder& Entry)
+	{
+		bool remove = Occluder ? Entry.Occluder.Get() == Occluder : !Entry.Occluder.IsValid();
+		if (remove)
+		{
+			Occlusion.removeOccluder(Entry.Handle);
+		}
+		return remove;
+	});
+}
+
+int UM1DecodeWorldSubsystem::GetRegisteredOccluderCount() const
+{
+	return Occluders.Num();
+}
+
+void UM1DecodeWorldSubsystem::SyncOccluders()
+{
+	UnregisterOccluder(nullptr);
+
+	for (FM1RegisteredOccluder& Entry : Occluders)
+	{
+		UM1OccluderComponent* Occluder = Entry.Occluder.Get();
+		const FTransform& Transform = Occluder->GetComponentTransform();
+		const FVector Extent = Occluder->GetScaledBoxExtent();
+
+		if (!Transform.Equals(Entry.IndexedTransform, 0) || Extent != Entry.IndexedExtent)
+		{
+			Occlusion.updateOccluder(Entry.Handle, ToIndexPosition(Transform.GetLocation()), ToIndexRotation(Transform.GetRotation()), ToIndexPosition(Extent * 2));
+			Entry.IndexedTransform = Transform;
+			Entry.IndexedExtent = Extent;
+		}
+		Occlusion.setOccluderTransmission(Entry.Handle, Occluder->Transmission);
+	}
+}
+
+float UM1DecodeWorldSubsystem::EvaluateOcclusion(FVector Listener, FVector Emitter)
+{
+	if (Occluders.Num() == 0)
+	{
+		return 1.0f;
+	}
+	return Occlusion.evaluate(ToIndexPosition(Listener), ToIndexPosition(Emitter));
+}
+
+FM1ListenerFrame UM1DecodeWorldSubsystem::ResolveListenerFrame(UWorld* World)
+{
+	FM1ListenerFrame Listener;
+
+	if (!World)
+	{
+		return Listener;
+	}
+
+	Listener.DeltaSeconds = World->GetDeltaSeconds();
+	Listener.AudioTimeSeconds = World->GetAudioTimeSeconds();
+
+	if (APlayerController* player = World->GetFirstPlayerController())
+	{
+		Listener.PlayerController = player;
+		Listener.PlayerPawn = player->GetPawn();
+	}
+
+	if (UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled())
+	{
+		FRotator hmdRotator;
+		FVector hmdPosition;
+		UHeadMountedDisplayFunctionLibrary::GetOrientationAndPosition(hmdRotator, hmdPosition);
+
+		Listener.HasHMD = true;
+		Listener.HMDRotation = hmdRotator.Quaternion();
+		Listener.HMDPosition = hmdPosition;
+	}
+
+	if (APlayerCameraManager* playerCameraManager = UGameplayStatics::GetPlayerCameraManager(World, 0))
+	{
+		Listener.HasCameraManager = true;
+		Listener.CameraRotation = playerCameraManager->GetCameraRotation().Quaternion();
+		Listener.CameraPosition = playerCameraManager->GetCameraLocation();
+	}
+
+	return Listener;
+}
+
+void UM1DecodeWorldSubsystem::Tick(float DeltaTime)
+{
+	RemoveRegisteredDecoders<AM1DecodeActor>(DecodeActors, EmitterIndex, nullptr);
+	RemoveRegisteredDecoders<UM1DecodeComponent>(DecodeComponents, EmitterIndex, nullptr);
+
+	const FM1ListenerFrame Listener = ResolveListenerFrame(GetWorld());
+
+	// occluders first, decoders query them while they are evaluated
+	SyncOccluders();
+
+	float MaxCullDistance = 0;
+	int32 HandleCount = 0;
+	SyncEmitterIndex(DecodeActors, EmitterIndex, Listener, MaxCullDistance, HandleCount);
+	SyncEmitterIndex(DecodeComponents, EmitterIndex, Listener, MaxCullDistance, HandleCount);
+
+	// one query finds every decoder that can be within its cull distance of the listener
+	IsNear.Init(false, HandleCount);
+	if (MaxCullDistance > 0)
+	{
+		NearHandles.clear();
+		EmitterIndex.query(ToIndexPosition(Listener.CameraPosition), MaxCullDistance, NearHandles);
+		for (int Handle : NearHandles)
+		{
+			IsNear[Handle] = true;
+		}
+	}
+
+	// evaluate every decoder against the same listener frame...
+	EvaluateRegisteredDecoders(DecodeActors, IsNear, Listener);
+	EvaluateRegisteredDecoders(DecodeComponents, IsNear, Listener);
+
+	// ...then push the gains once every decoder has been evaluated, as one audio thread command for all channel volumes
+	FM1VolumeBatch VolumeBatch;
+	for (const TM1RegisteredDecoder<AM1DecodeActor>& Entry : DecodeActors)
+	{
+		Entry.Decoder->ApplyDecodeGains(&VolumeBatch);
+	}
+	for (const TM1RegisteredDecoder<UM1DecodeComponent>& Entry : DecodeComponents)
+	{
+		Entry.Decoder->ApplyDecodeGains(&VolumeBatch);
+	}
+	VolumeBatch.Send();
+}
+
+TStatId UM1DecodeWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UM1DecodeWorldSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UM1DecodeWorldSubsystem::GetTickableTickType() const
+{
+	// the class default object must never tick
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UM1DecodeWorldSubsystem::IsTickable() const
+{
+	return GetRegisteredDecoderCount() > 0;
+}
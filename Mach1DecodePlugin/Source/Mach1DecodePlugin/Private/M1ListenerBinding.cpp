@@ -0,0 +1,68 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1ListenerBinding.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+UCameraComponent* FM1ListenerBinding::Resolve(APawn* InPawn)
+{
+	if (!InPawn)
+	{
+		Reset();
+		return nullptr;
+	}
+
+	bool NeedsResolve = IsStale(InPawn);
+	if (!NeedsResolve && !Camera.Get() && ++CameraRetryCount >= M1_LISTENER_CAMERA_RETRY_INTERVAL)
+	{
+		NeedsResolve = true; // no camera last time, look again
+	}
+
+	if (NeedsResolve)
+	{
+		Pawn = InPawn;
+		Controller = InPawn->GetController();
+		Camera = nullptr;
+		IsBound = true;
+		ResolveCount++;
+		CameraRetryCount = 0;
+
+		TInlineComponentArray<UCameraComponent*> CameraComponents(InPawn);
+		for (UCameraComponent* CameraComp : CameraComponents)
+		{
+			if (CameraComp->IsActive())
+			{
+				Camera = CameraComp;
+			}
+		}
+	}
+
+	return Camera.Get();
+}
+
+void FM1ListenerBinding::Reset()
+{
+	Pawn = nullptr;
+	Controller = nullptr;
+	Camera = nullptr;
+	IsBound = false;
+	CameraRetryCount = 0;
+}
+
+bool FM1ListenerBinding::IsStale(APawn* InPawn) const
+{
+	if (!IsBound || Pawn.Get() != InPawn || Controller.Get() != InPawn->GetController())
+	{
+		return true; // first use, another pawn or possession changed
+	}
+
+	if (Camera.IsStale())
+	{
+		return true; // camera component destroyed
+	}
+
+	UCameraComponent* CameraComp = Camera.Get();
+	return CameraComp && !CameraComp->IsActive();
+}
@@ -0,0 +1,35 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1OccluderComponent.h"
+#include "M1DecodeWorldSubsystem.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+UM1OccluderComponent::UM1OccluderComponent()
+{
+	// only shapes the sound, physical blocking stays with the level geometry
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+}
+
+void UM1OccluderComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+	{
+		decodeSubsystem->RegisterOccluder(this);
+	}
+}
+
+void UM1OccluderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UM1DecodeWorldSubsystem* decodeSubsystem = GetWorld()->GetSubsystem<UM1DecodeWorldSubsystem>())
+	{
+		decodeSubsystem->UnregisterOccluder(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,52 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#include "M1VolumeBatch.h"
+#include "ActiveSound.h"
+#include "AudioDevice.h"
+#include "AudioThread.h"
+
+#include "Mach1DecodePluginPrivatePCH.h"
+
+void FM1VolumeBatch::Add(UAudioComponent* Component, float Volume)
+{
+	FAudioDevice* ComponentDevice = Component->GetAudioDevice();
+	if (!ComponentDevice)
+	{
+		Component->SetVolumeMultiplier(Volume);
+		return;
+	}
+
+	// one command per audio device, e.g. several PIE clients
+	if (AudioDevice && AudioDevice != ComponentDevice)
+	{
+		Send();
+	}
+	AudioDevice = ComponentDevice;
+
+	// the game thread copy is what a restarted sound starts with
+	Component->VolumeMultiplier = Volume;
+	Volumes.Add(Component->GetAudioComponentID(), Volume);
+}
+
+void FM1VolumeBatch::Send()
+{
+	if (Volumes.Num() > 0)
+	{
+		FAudioThread::RunCommandOnAudioThread([Device = AudioDevice, Updates = MoveTemp(Volumes)]()
+		{
+			// what UAudioComponent::SetVolumeMultiplier() does for each component, in one pass over the active sounds
+			for (FActiveSound* ActiveSound : Device->GetActiveSounds())
+			{
+				if (const float* Volume = Updates.Find(ActiveSound->GetAudioComponentID()))
+				{
+					ActiveSound->SetVolume(*Volume);
+				}
+			}
+		});
+	}
+
+	Volumes.Reset();
+	AudioDevice = nullptr;
+}
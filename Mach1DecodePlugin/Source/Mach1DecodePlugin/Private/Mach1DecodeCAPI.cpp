@@ -1,93 +1,245 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#include "Mach1DecodeCAPI.h"
-#include "Mach1DecodeCore.h"
-
-void *Mach1DecodeCAPI_create() {
-    return new M1DecodeCore();
-}
-
-void Mach1DecodeCAPI_delete(void *M1obj) {
-    if (M1obj != nullptr) {
-        delete (M1DecodeCore *)M1obj;
-        M1obj = nullptr;
-    }
-}
-
-void Mach1DecodeCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
-    ((M1DecodeCore *)M1obj)->setDecodeMode(mode);
-}
-
-void Mach1DecodeCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType type) {
-    ((M1DecodeCore *)M1obj)->setPlatformType(type);
-}
-
-Mach1DecodeMode Mach1DecodeCAPI_getDecodeMode(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getDecodeMode();
-}
-
-Mach1PlatformType Mach1DecodeCAPI_getPlatformType(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getPlatformType();
-}
-
-void Mach1DecodeCAPI_decode(void *M1obj, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
-    ((M1DecodeCore *)M1obj)->decode(Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
-}
-
-void Mach1DecodeCAPI_decodeCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex) {
-    ((M1DecodeCore *)M1obj)->decodeCoeffs(result, bufferSize, sampleIndex);
-}
-
-void Mach1DecodeCAPI_decodePannedCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
-    ((M1DecodeCore *)M1obj)->decodePannedCoeffs(result, bufferSize, sampleIndex, applyPanLaw);
-}
-
-void Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex) {
-    ((M1DecodeCore *)M1obj)->decodeCoeffsUsingTranscodeMatrix(M1obj, matrix, channels, result, bufferSize, sampleIndex);
-}
-
-void Mach1DecodeCAPI_setFilterSpeed(void *M1obj, float filterSpeed) {
-    ((M1DecodeCore *)M1obj)->setFilterSpeed(filterSpeed);
-}
-
-int Mach1DecodeCAPI_getFormatChannelCount(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getFormatChannelCount();
-}
-
-int Mach1DecodeCAPI_getFormatCoeffCount(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getFormatCoeffCount();
-}
-
-void Mach1DecodeCAPI_setRotation(void *M1obj, Mach1Point3D newRotationFromMinusOnetoOne) {
-    ((M1DecodeCore *)M1obj)->setRotation({newRotationFromMinusOnetoOne.x, newRotationFromMinusOnetoOne.y, newRotationFromMinusOnetoOne.z});
-}
-
-void Mach1DecodeCAPI_setRotationDegrees(void *M1obj, Mach1Point3D newRotationDegrees) {
-    ((M1DecodeCore *)M1obj)->setRotationDegrees({newRotationDegrees.x, newRotationDegrees.y, newRotationDegrees.z});
-}
-
-void Mach1DecodeCAPI_setRotationRadians(void *M1obj, Mach1Point3D rotation) {
-    ((M1DecodeCore *)M1obj)->setRotationRadians({rotation.x, rotation.y, rotation.z});
-}
-
-void Mach1DecodeCAPI_setRotationQuat(void *M1obj, Mach1Point4D newRotationQuat) {
-    ((M1DecodeCore *)M1obj)->setRotationQuat({newRotationQuat.x, newRotationQuat.y, newRotationQuat.z, newRotationQuat.w});
-}
-
-long Mach1DecodeCAPI_getCurrentTime(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getCurrentTime();
-}
-
-long Mach1DecodeCAPI_getLastCalculationTime(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getLastCalculationTime();
-}
-
-char *Mach1DecodeCAPI_getLog(void *M1obj) {
-    return ((M1DecodeCore *)M1obj)->getLog();
-}
-
-Mach1Point3D Mach1DecodeCAPI_getCurrentAngle(void *M1obj) {
-    Mach1Point3D angle = ((M1DecodeCore *)M1obj)->getCurrentAngle();
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#include "Mach1DecodeCAPI.h"
+#include "Mach1DecodeCore.h"
+#include "Mach1DecodeFilterBank.h"
+#include "Mach1ObjectPool.h"
+
+typedef Mach1ObjectPool<M1DecodeCore> M1DecodeCorePool;
+
+void *Mach1DecodeCAPI_create() {
+    return new M1DecodeCore();
+}
+
+void Mach1DecodeCAPI_delete(void *M1obj) {
+    if (M1obj != nullptr) {
+        delete (M1DecodeCore *)M1obj;
+        M1obj = nullptr;
+    }
+}
+
+void *Mach1DecodeCAPI_createPool(int capacity) {
+    return new M1DecodeCorePool(capacity);
+}
+
+void Mach1DecodeCAPI_deletePool(void *M1pool) {
+    if (M1pool != nullptr) {
+        delete (M1DecodeCorePool *)M1pool;
+        M1pool = nullptr;
+    }
+}
+
+int Mach1DecodeCAPI_poolAcquire(void *M1pool) {
+    return ((M1DecodeCorePool *)M1pool)->acquire();
+}
+
+void Mach1DecodeCAPI_poolRelease(void *M1pool, int index) {
+    ((M1DecodeCorePool *)M1pool)->release(index);
+}
+
+void *Mach1DecodeCAPI_poolGet(void *M1pool, int index) {
+    return ((M1DecodeCorePool *)M1pool)->get(index);
+}
+
+int Mach1DecodeCAPI_poolGetIndex(void *M1pool, void *M1obj) {
+    return ((M1DecodeCorePool *)M1pool)->indexOf(M1obj);
+}
+
+int Mach1DecodeCAPI_poolGetCapacity(void *M1pool) {
+    return ((M1DecodeCorePool *)M1pool)->getCapacity();
+}
+
+int Mach1DecodeCAPI_poolGetActiveCount(void *M1pool) {
+    return ((M1DecodeCorePool *)M1pool)->getActiveCount();
+}
+
+void *Mach1DecodeCAPI_createFilterBank() {
+    return new Mach1DecodeFilterBank();
+}
+
+void Mach1DecodeCAPI_deleteFilterBank(void *M1filterBank) {
+    if (M1filterBank != nullptr) {
+        ((Mach1DecodeFilterBank *)M1filterBank)->clear();
+        delete (Mach1DecodeFilterBank *)M1filterBank;
+        M1filterBank = nullptr;
+    }
+}
+
+int Mach1DecodeCAPI_filterBankAdd(void *M1filterBank, void *M1obj) {
+    return ((Mach1DecodeFilterBank *)M1filterBank)->add((M1DecodeCore *)M1obj);
+}
+
+void Mach1DecodeCAPI_filterBankRemove(void *M1filterBank, void *M1obj) {
+    ((Mach1DecodeFilterBank *)M1filterBank)->remove((M1DecodeCore *)M1obj);
+}
+
+void Mach1DecodeCAPI_filterBankUpdate(void *M1filterBank, long currentTimeMilliseconds) {
+    ((Mach1DecodeFilterBank *)M1filterBank)->update(currentTimeMilliseconds);
+}
+
+int Mach1DecodeCAPI_filterBankGetCount(void *M1filterBank) {
+    return ((Mach1DecodeFilterBank *)M1filterBank)->getCount();
+}
+
+void Mach1DecodeCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
+    ((M1DecodeCore *)M1obj)->setDecodeMode(mode);
+}
+
+void Mach1DecodeCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType type) {
+    ((M1DecodeCore *)M1obj)->setPlatformType(type);
+}
+
+Mach1DecodeMode Mach1DecodeCAPI_getDecodeMode(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getDecodeMode();
+}
+
+void Mach1DecodeCAPI_setReducedDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
+    ((M1DecodeCore *)M1obj)->setReducedDecodeMode(mode);
+}
+
+Mach1DecodeMode Mach1DecodeCAPI_getReducedDecodeMode(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getReducedDecodeMode();
+}
+
+void Mach1DecodeCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation) {
+    ((M1DecodeCore *)M1obj)->setUsePitchForRotation(usePitchForRotation);
+}
+
+bool Mach1DecodeCAPI_getUsePitchForRotation(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getUsePitchForRotation();
+}
+
+void Mach1DecodeCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation) {
+    ((M1DecodeCore *)M1obj)->setUseRollForRotation(useRollForRotation);
+}
+
+bool Mach1DecodeCAPI_getUseRollForRotation(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getUseRollForRotation();
+}
+
+void Mach1DecodeCAPI_setCoeffReuseThreshold(void *M1obj, float thresholdDegrees) {
+    ((M1DecodeCore *)M1obj)->setCoeffReuseThreshold(thresholdDegrees);
+}
+
+float Mach1DecodeCAPI_getCoeffReuseThreshold(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getCoeffReuseThreshold();
+}
+
+float Mach1DecodeCAPI_getCoeffReuseRate(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getCoeffReuseRate();
+}
+
+void Mach1DecodeCAPI_resetCoeffReuseRate(void *M1obj) {
+    ((M1DecodeCore *)M1obj)->resetCoeffReuseRate();
+}
+
+Mach1PlatformType Mach1DecodeCAPI_getPlatformType(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getPlatformType();
+}
+
+void Mach1DecodeCAPI_decode(void *M1obj, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
+    ((M1DecodeCore *)M1obj)->decode(Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
+}
+
+void Mach1DecodeCAPI_decodeCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex) {
+    ((M1DecodeCore *)M1obj)->decodeCoeffs(result, bufferSize, sampleIndex);
+}
+
+void Mach1DecodeCAPI_decodePannedCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
+    ((M1DecodeCore *)M1obj)->decodePannedCoeffs(result, bufferSize, sampleIndex, applyPanLaw);
+}
+
+void Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex) {
+    ((M1DecodeCore *)M1obj)->decodeCoeffsUsingTranscodeMatrix(M1obj, matrix, channels, result, bufferSize, sampleIndex);
+}
+
+void Mach1DecodeCAPI_decodeCoeffsWithGradient(void *M1obj, float *result, float *gradient) {
+    ((M1DecodeCore *)M1obj)->decodeCoeffsWithGradient(result, gradient);
+}
+
+void Mach1DecodeCAPI_setFilterSpeed(void *M1obj, float filterSpeed) {
+    ((M1DecodeCore *)M1obj)->setFilterSpeed(filterSpeed);
+}
+
+int Mach1DecodeCAPI_getFormatChannelCount(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getFormatChannelCount();
+}
+
+int Mach1DecodeCAPI_getFormatCoeffCount(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getFormatCoeffCount();
+}
+
+void Mach1DecodeCAPI_setRotation(void *M1obj, Mach1Point3D newRotationFromMinusOnetoOne) {
+    ((M1DecodeCore *)M1obj)->setRotation({newRotationFromMinusOnetoOne.x, newRotationFromMinusOnetoOne.y, newRotationFromMinusOnetoOne.z});
+}
+
+void Mach1DecodeCAPI_setRotationDegrees(void *M1obj, Mach1Point3D newRotationDegrees) {
+    ((M1DecodeCore *)M1obj)->setRotationDegrees({newRotationDegrees.x, newRotationDegrees.y, newRotationDegrees.z});
+}
+
+void Mach1DecodeCAPI_setRotationRadians(void *M1obj, Mach1Point3D rotation) {
+    ((M1DecodeCore *)M1obj)->setRotationRadians({rotation.x, rotation.y, rotation.z});
+}
+
+void Mach1DecodeCAPI_setRotationQuat(void *M1obj, Mach1Point4D newRotationQuat) {
+    ((M1DecodeCore *)M1obj)->setRotationQuat({newRotationQuat.x, newRotationQuat.y, newRotationQuat.z, newRotationQuat.w});
+}
+
+void Mach1DecodeCAPI_setRotationDegreesAtTime(void *M1obj, Mach1Point3D newRotationDegrees, double timeSeconds) {
+    ((M1DecodeCore *)M1obj)->setRotationDegreesAtTime({newRotationDegrees.x, newRotationDegrees.y, newRotationDegrees.z}, timeSeconds);
+}
+
+void Mach1DecodeCAPI_setPredictionTargetTime(void *M1obj, double timeSeconds) {
+    ((M1DecodeCore *)M1obj)->setPredictionTargetTime(timeSeconds);
+}
+
+void Mach1DecodeCAPI_setPredictionHorizon(void *M1obj, float maxSeconds) {
+    ((M1DecodeCore *)M1obj)->setPredictionHorizon(maxSeconds);
+}
+
+float Mach1DecodeCAPI_getPredictionHorizon(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getPredictionHorizon();
+}
+
+Mach1Point3D Mach1DecodeCAPI_getPredictedRotation(void *M1obj) {
+    Mach1Point3D predicted = ((M1DecodeCore *)M1obj)->getPredictedRotation();
+    return Mach1Point3D{predicted.x, predicted.y, predicted.z};
+}
+
+long Mach1DecodeCAPI_getCurrentTime(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getCurrentTime();
+}
+
+void Mach1DecodeCAPI_setManualTime(void *M1obj, long milliseconds) {
+    ((M1DecodeCore *)M1obj)->setManualTime(milliseconds);
+}
+
+void Mach1DecodeCAPI_clearManualTime(void *M1obj) {
+    ((M1DecodeCore *)M1obj)->clearManualTime();
+}
+
+Mach1FilterClock Mach1DecodeCAPI_swapFilterClock(void *M1obj, Mach1FilterClock clock) {
+    return ((M1DecodeCore *)M1obj)->swapFilterClock(clock);
+}
+
+void Mach1DecodeCAPI_setDeterministic(void *M1obj, bool enable) {
+    ((M1DecodeCore *)M1obj)->setDeterministic(enable);
+}
+
+bool Mach1DecodeCAPI_getDeterministic(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getDeterministic();
+}
+
+long Mach1DecodeCAPI_getLastCalculationTime(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getLastCalculationTime();
+}
+
+char *Mach1DecodeCAPI_getLog(void *M1obj) {
+    return ((M1DecodeCore *)M1obj)->getLog();
+}
+
+Mach1Point3D Mach1DecodeCAPI_getCurrentAngle(void *M1obj) {
+    Mach1Point3D angle = ((M1DecodeCore *)M1obj)->getCurrentAngle();
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
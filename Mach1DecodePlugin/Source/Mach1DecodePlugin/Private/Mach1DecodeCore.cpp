@@ -1,992 +1,1519 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-/*
-DISCLAIMER:
-This file is not an example of use but an decoder that will require periodic
-updates and should not be integrated in sections but remain as an update-able factored file.
-*/
-
-/*
-Internal Orientation Implementation:
-    -  Yaw   [0]+ = rotate right 0-1 [Range: 0->360 | -180->180]
-    -  Yaw   [0]- = rotate left 0-1  [Range: 0->360 | -180->180]
-    -  Pitch [1]+ = rotate up 0-1    [Range: -90->90]
-    -  Pitch [1]- = rotate down 0-1  [Range: -90->90]
-    -  Roll  [2]+ = rotate up 0-1    [Range: -90->90]
-    -  Roll  [2]- = rotate down 0-1  [Range: -90->90]
-
-M1DecodeCore normalizes all input ranges to an unsigned "0 to 1" range for Yaw, Pitch and Roll.
- */
-
-#include "Mach1DecodeCore.h"
-#include <string>
-
-#ifndef __ANDROID__
-// TODO: Remove this and figure out how to get ANDROID builds to accept newer stdlib
-#    define copysign std::copysign
-#endif
-
-#ifndef DEG_TO_RAD
-#    define DEG_TO_RAD (PI / 180.0)
-#endif
-
-#ifndef __FLT_EPSILON__
-#    define __FLT_EPSILON__ 1.19209290e-07F
-#endif
-
-float M1DecodeCore::lerp(float x1, float x2, float t) {
-    return x1 + (x2 - x1) * t;
-}
-
-float M1DecodeCore::mDegToRad(float degrees) {
-    return (float)(degrees * DEG_TO_RAD);
-}
-
-//
-// Map utility
-//
-
-float M1DecodeCore::mmap(float value, float inputMin, float inputMax, float outputMin, float outputMax, bool clamp) {
-
-    if (fabs(inputMin - inputMax) < __FLT_EPSILON__) {
-        return outputMin;
-    } else {
-        float outVal = ((value - inputMin) / (inputMax - inputMin) * (outputMax - outputMin) + outputMin);
-
-        if (clamp) {
-            if (outputMax < outputMin) {
-                if (outVal < outputMax)
-                    outVal = outputMax;
-                else if (outVal > outputMin)
-                    outVal = outputMin;
-            } else {
-                if (outVal > outputMax)
-                    outVal = outputMax;
-                else if (outVal < outputMin)
-                    outVal = outputMin;
-            }
-        }
-        return outVal;
-    }
-}
-
-float M1DecodeCore::clamp(float a, float min, float max) {
-    return (a < min) ? min : ((a > max) ? max : a);
-}
-
-float M1DecodeCore::alignAngle(float a, float min, float max) {
-    if (a > 5000 || a < -5000)
-        return 0;
-
-    while (a < min)
-        a += 360;
-    while (a > max)
-        a -= 360;
-
-    return a;
-}
-
-float M1DecodeCore::radialDistance(float angle1, float angle2) {
-    if ((std::abs(angle2 - angle1)) > (std::abs(std::abs(angle2 - angle1) - 360))) {
-        return std::abs(std::abs(angle2 - angle1) - 360);
-    } else
-        return std::abs(angle2 - angle1);
-}
-
-float M1DecodeCore::targetDirectionMultiplier(float angleCurrent, float angleTarget) {
-    if (((std::abs(angleCurrent - angleTarget)) >
-         (std::abs(angleCurrent - angleTarget + 360))) ||
-        ((std::abs(angleCurrent - angleTarget)) >
-         (std::abs(angleCurrent - angleTarget - 360)))) {
-        if (angleCurrent < angleTarget) {
-            return -1.;
-        }
-        if (angleCurrent > angleTarget) {
-            return 1.;
-        }
-    } else {
-        if (angleCurrent < angleTarget) {
-            return 1.;
-        }
-        if (angleCurrent > angleTarget) {
-            return -1.;
-        }
-    }
-    return 0.;
-}
-
-// Note: Envelope follower feature is defined here, in updateAngles()
-void M1DecodeCore::updateAngles() {
-    targetYaw = fmod(targetYaw, 360);
-    targetPitch = fmod(targetPitch, 360);
-    targetRoll = fmod(targetRoll, 360);
-
-    currentYaw = fmod(currentYaw, 360);
-    currentPitch = fmod(currentPitch, 360);
-    currentRoll = fmod(currentRoll, 360);
-
-    if (filterSpeed >= 1.0f) {
-        currentYaw = targetYaw;
-        currentPitch = targetPitch;
-        currentRoll = targetRoll;
-    } else {
-        float speedAngle = timeLastUpdate ? filterSpeed * 1.0f * (getCurrentTime() - timeLastUpdate) : 0;
-
-        timeLastUpdate = getCurrentTime();
-
-        float distanceYaw = radialDistance(targetYaw, currentYaw);
-        float distancePitch = radialDistance(targetPitch, currentPitch);
-        float distanceRoll = radialDistance(targetRoll, currentRoll);
-
-        float distance = distanceYaw + distancePitch + distanceRoll;
-
-        if (distanceYaw > speedAngle && distance < 360) {
-            currentYaw += speedAngle * targetDirectionMultiplier(currentYaw, targetYaw);
-        } else {
-            currentYaw = targetYaw;
-        }
-
-        if (distancePitch > speedAngle && distance < 360) {
-            currentPitch += speedAngle * targetDirectionMultiplier(currentPitch, targetPitch);
-        } else {
-            currentPitch = targetPitch;
-        }
-
-        if (distanceRoll > speedAngle && distance < 360) {
-            currentRoll += speedAngle * targetDirectionMultiplier(currentRoll, targetRoll);
-        } else {
-            currentRoll = targetRoll;
-        }
-    }
-}
-
-float M1DecodeCore::_dot(const Mach1Point3D &p1, const Mach1Point3D &p2) const {
-    return p1.x * p2.x + p1.y * p2.y + p1.z * p2.z;
-}
-
-bool M1DecodeCore::linePlaneIntersection(Mach1Point3D &contact, Mach1Point3D ray, Mach1Point3D rayOrigin, Mach1Point3D normal, Mach1Point3D coord) {
-    float epsilon = 1e-6f;
-
-    Mach1Point3D u = rayOrigin - ray;
-    float dot = _dot(normal, u);
-
-    if (fabs(dot) > epsilon) {
-        Mach1Point3D w = ray - coord;
-        float fac = -_dot(normal, w) / dot;
-        if (fac >= 0.0 && fac <= 1.0) {
-            u = u * fac;
-            contact = ray + u;
-            return true;
-        }
-    }
-    return false;
-}
-
-void M1DecodeCore::spatialMultichannelAlgo(Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *result) {
-    
-    if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
-        targetYaw = Yaw;
-        targetPitch = Pitch;
-        targetRoll = Roll;
-
-        updateAngles();
-
-        Yaw = currentYaw;
-        Pitch = currentPitch;
-        Roll = currentRoll;
-    } else {
-        targetYaw = Yaw;
-        targetPitch = Pitch;
-        targetRoll = Roll;
-
-        currentYaw = Yaw;
-        currentPitch = Pitch;
-        currentRoll = Roll;
-
-        previousYaw = currentYaw;
-        previousPitch = currentPitch;
-        previousRoll = currentRoll;
-    }
-    
-    Mach1Point3D simulationAngles;
-    simulationAngles.x = Yaw;
-    simulationAngles.y = Pitch;
-    simulationAngles.z = Roll;
-
-    Mach1Point3D fVec_1a = {sin(mDegToRad(simulationAngles[0])), cos(mDegToRad(simulationAngles[0])), 0};
-    fVec_1a.normalize();
-    Mach1Point3D fVec_1b = {sin(mDegToRad(simulationAngles[0] - 90)), cos(mDegToRad(simulationAngles[0] - 90)), 0};
-    fVec_1b.normalize();
-
-    Mach1Point3D fVec_2a = fVec_1a.getRotated(-simulationAngles[1], fVec_1b);
-    Mach1Point3D fVec_2b = fVec_1a.getRotated(-simulationAngles[1] - 90, fVec_1b);
-
-    Mach1Point3D fVecL = fVec_2b.getRotated(simulationAngles[2] - 90, fVec_2a);
-    Mach1Point3D fVecR = fVec_2b.getRotated(simulationAngles[2] + 90, fVec_2a);
-
-    Mach1Point3D contactL = fVecL + fVec_2a;
-    Mach1Point3D contactR = fVecR + fVec_2a;
-
-    float d = sqrtf(5); // 100*100+200*200
-
-    std::vector<float> vL(numChannelPoints);
-    std::vector<float> vR(numChannelPoints);
-
-    std::vector<float> vL_clamped(numChannelPoints);
-    std::vector<float> vR_clamped(numChannelPoints);
-
-    // Calculate pitch influence (0 = horizontal plane, 1 = directly up, -1 = directly down)
-    float pitchInfluence = sin(mDegToRad(Pitch));  // -1 to +1
-
-    for (int i = 0; i < numChannelPoints; i++) {
-        // Calculate vertical attenuation
-        // When looking up (+pitch), attenuate lower channels
-        // When looking down (-pitch), attenuate upper channels
-        float verticalAttenuation;
-        if (pitchInfluence >= 0) {
-            // Looking up - attenuate lower channels
-            verticalAttenuation = channelPoints[i].z < 0 ? (1.0f - pitchInfluence) : 1.0f;
-        } else {
-            // Looking down - attenuate upper channels
-            verticalAttenuation = channelPoints[i].z > 0 ? (1.0f + pitchInfluence) : 1.0f;
-        }
-
-        Mach1Point3D qL = (contactL - channelPoints[i]);
-        Mach1Point3D qR = (contactR - channelPoints[i]);
-
-        vL[i] = qL.length();
-        vR[i] = qR.length();
-
-        vL_clamped[i] = M1DecodeCore::clamp(M1DecodeCore::mmap(vL[i], 0, d, 1.f, 0.f, false), 0, 1);
-        vR_clamped[i] = M1DecodeCore::clamp(M1DecodeCore::mmap(vR[i], 0, d, 1.f, 0.f, false), 0, 1);
-
-        // Combine horizontal and vertical influences
-        result[i * 2 + 0] = vL_clamped[i] * verticalAttenuation;
-        result[i * 2 + 1] = vR_clamped[i] * verticalAttenuation;
-    }
-
-    // Gain normalizer v2.0
-    float sumL = 0, sumR = 0;
-    for (int i = 0; i < numChannelPoints; i++) {
-        sumL += result[i * 2];
-        sumR += result[i * 2 + 1];
-    }
-    for (int i = 0; i < numChannelPoints; i++) {
-        result[i * 2 + 0] /= sumL;
-        result[i * 2 + 1] /= sumR;
-    }
-}
-
-/*
- Defined multichannel spatial layouts
-
- Mach1 XYZ Coordinate Expectation:
- X (left -> right | where -X is left)
- Y (front -> back | where -Y is back)
- Z (top -> bottom | where -Z is bottom)
-
- */
-
-void M1DecodeCore::spatialAlgo_4(float Yaw, float Pitch, float Roll, float *result) {
-    const int numChannelPoints = 4;
-
-    // Ideally Z should be 0, but this results in unexpected results from a lack of a 3D shape
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
-}
-
-std::vector<float> M1DecodeCore::spatialAlgo_4(float Yaw, float Pitch, float Roll) {
-    const int numChannelPoints = 4;
-
-    std::vector<float> result;
-    result.resize(numChannelPoints * 2);
-
-    // Ideally Z should be 0, but this results in unexpected results from a lack of a 3D shape
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result.data());
-
-    return result;
-}
-
-void M1DecodeCore::spatialAlgo_8(float Yaw, float Pitch, float Roll, float *result) {
-    const int numChannelPoints = 8;
-
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-
-            {-1, 1, -1},
-            {1, 1, -1},
-            {-1, -1, -1},
-            {1, -1, -1},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
-}
-
-std::vector<float> M1DecodeCore::spatialAlgo_8(float Yaw, float Pitch, float Roll) {
-    const int numChannelPoints = 8;
-
-    std::vector<float> result;
-    result.resize(numChannelPoints * 2);
-
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-
-            {-1, 1, -1},
-            {1, 1, -1},
-            {-1, -1, -1},
-            {1, -1, -1},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result.data());
-
-    return result;
-}
-
-void M1DecodeCore::spatialAlgo_14(float Yaw, float Pitch, float Roll, float *result) {
-    const int numChannelPoints = 8 + 4 + 2;
-
-    float diag = sqrtf(2);
-
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-
-            {-1, 1, -1},
-            {1, 1, -1},
-            {-1, -1, -1},
-            {1, -1, -1},
-
-            {0, diag, 0},
-            {diag, 0, 0},
-            {0, -diag, 0},
-            {-diag, 0, 0},
-
-            {0, 0, diag},
-            {0, 0, -diag},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
-}
-
-std::vector<float> M1DecodeCore::spatialAlgo_14(float Yaw, float Pitch, float Roll) {
-    const int numChannelPoints = 8 + 4 + 2;
-
-    float diag = sqrtf(2);
-
-    std::vector<float> result;
-    result.resize(numChannelPoints * 2);
-
-    Mach1Point3D channelPoints[numChannelPoints] =
-        {
-            {-1, 1, 1},
-            {1, 1, 1},
-            {-1, -1, 1},
-            {1, -1, 1},
-
-            {-1, 1, -1},
-            {1, 1, -1},
-            {-1, -1, -1},
-            {1, -1, -1},
-
-            {0, diag, 0},
-            {diag, 0, 0},
-            {0, -diag, 0},
-            {-diag, 0, 0},
-
-            {0, 0, diag},
-            {0, 0, -diag},
-        };
-
-    spatialMultichannelAlgo(channelPoints, numChannelPoints, Yaw, Pitch, Roll, result.data());
-
-    return result;
-}
-
-// Angular settings functions
-void M1DecodeCore::convertAnglesToMach1(Mach1PlatformType platformType, float *Y, float *P, float *R) {
-    float _Y = 0, _P = 0, _R = 0;
-
-    switch (platformType) {
-    case Mach1PlatformDefault:
-        *Y = *Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOS:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOSTableTop_ZVertical:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOSPortraitHandheld_YVertical:
-        // TODO: add this!
-        break;
-
-    case Mach1PlatformiOSPortrait_YawOnly:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        if (*R < 0 && *Y < 0) {
-            *Y = 360 - (-1 * (*Y + *R));
-        } else {
-            *Y = *Y + *R;
-        }
-        break;
-
-    case Mach1PlatformUnity:
-        // P Y R -> Y P R
-        _P = *Y;
-        _Y = *P;
-        _R = *R;
-        *Y = _Y;
-        *P = -_P;
-        *R = -_R;
-        break;
-
-    case Mach1PlatformUE:
-        // R P Y -> Y P R
-        _R = *Y;
-        _P = *P;
-        _Y = *R;
-        *Y = _Y;
-        *P = _P;
-        *R = _R;
-        break;
-
-    case Mach1PlatformOfEasyCam:
-        *Y = *Y;
-        *P = -*P;
-        *R = -*R;
-        break;
-
-    case Mach1PlatformAndroid:
-        // P Y R -> Y -P R
-        _P = *Y;
-        _Y = *P;
-        _R = *R;
-        *Y = _Y;
-        *P = -_P;
-        *R = _R;
-        break;
-
-    default:
-        break;
-    }
-}
-
-void M1DecodeCore::convertAnglesToPlatform(Mach1PlatformType platformType, float *Y, float *P, float *R) {
-    float _Y = 0, _P = 0, _R = 0;
-
-    switch (platformType) {
-    case Mach1PlatformDefault:
-        *Y = *Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOS:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOSTableTop_ZVertical:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        break;
-
-    case Mach1PlatformiOSPortraitHandheld_YVertical:
-        // TODO: add this!
-        break;
-
-    case Mach1PlatformiOSPortrait_YawOnly:
-        *Y = -*Y;
-        *P = *P;
-        *R = *R;
-        if (*R < 0 && *Y < 0) {
-            *Y = 360 - (-1 * (*Y + *R));
-        } else {
-            *Y = *Y + *R;
-        }
-        break;
-
-    case Mach1PlatformUnity:
-        // Y P R -> P Y R
-        _Y = *Y;
-        _P = -*P;
-        _R = -*R;
-        *Y = _P;
-        *P = _Y;
-        *R = _R;
-        break;
-
-    case Mach1PlatformUE:
-        // Y P -R -> R P Y
-        _Y = *Y;
-        _P = *P;
-        _R = *R;
-        *Y = _R;
-        *P = _P;
-        *R = _Y;
-        break;
-
-    case Mach1PlatformOfEasyCam:
-        *Y = *Y;
-        *P = -*P;
-        *R = -*R;
-        break;
-
-    case Mach1PlatformAndroid:
-        *Y = -*Y;
-        *P = -*P;
-        *R = *R;
-        std::swap(*P, *Y);
-        break;
-
-    default:
-        break;
-    }
-}
-
-Mach1Point3D M1DecodeCore::getCurrentAngle() {
-    Mach1Point3D angle = {currentYaw, currentPitch, currentRoll};
-    return angle;
-}
-
-void M1DecodeCore::addToLog(std::string str, int maxCount) {
-    if (strLog.size() > maxCount)
-        strLog.erase(strLog.begin() + maxCount, strLog.begin() + strLog.size() - 1);
-
-    strLog.push_back(str);
-}
-
-char *M1DecodeCore::getLog() {
-    std::vector<std::string> _strLog = strLog;
-    strLog.clear();
-
-    static char log[100000] = "";
-
-    log[0] = '\0';
-    /*
-    for (int i = 0; i<_strLog.size(); i++) strcat(log, _strLog[i].c_str());
-     */
-    return log;
-}
-
-M1DecodeCore::M1DecodeCore() {
-    currentYaw = 0;
-    currentPitch = 0;
-    currentRoll = 0;
-
-    targetYaw = 0;
-    targetPitch = 0;
-    targetRoll = 0;
-
-    previousYaw = 0;
-    previousPitch = 0;
-    previousRoll = 0;
-
-    filterSpeed = 0.9f;
-    timeLastUpdate = 0;
-    timeLastCalculation = 0;
-
-    platformType = Mach1PlatformDefault;
-    decodeMode = M1DecodeSpatial_8;
-
-    ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-
-    strLog.resize(0);
-}
-
-long M1DecodeCore::getCurrentTime() {
-    return (long)(duration_cast<milliseconds>(system_clock::now().time_since_epoch()) - ms).count();
-}
-
-long M1DecodeCore::getLastCalculationTime() {
-    return timeLastCalculation;
-}
-
-void M1DecodeCore::setPlatformType(Mach1PlatformType type) {
-    platformType = type;
-}
-
-Mach1PlatformType M1DecodeCore::getPlatformType() {
-    return platformType;
-}
-
-int M1DecodeCore::getFormatChannelCount() {
-    switch (decodeMode) {
-    case M1DecodeSpatial_4:
-        return 4;
-    case M1DecodeSpatial_8:
-        return 8;
-    case M1DecodeSpatial_14:
-        return 14;
-    }
-    return 0;
-}
-
-int M1DecodeCore::getFormatCoeffCount() {
-    switch (decodeMode) {
-    case M1DecodeSpatial_4:
-        return (4 * 2);
-    case M1DecodeSpatial_8:
-        return (8 * 2);
-    case M1DecodeSpatial_14:
-        return (14 * 2);
-    }
-    return 0;
-}
-
-void M1DecodeCore::setRotation(Mach1Point3D newRotationFromMinusOnetoOne) {
-    rotation = newRotationFromMinusOnetoOne * 360.0;
-}
-
-void M1DecodeCore::setRotationDegrees(Mach1Point3D newRotationDegrees) {
-    rotation = newRotationDegrees;
-}
-
-void M1DecodeCore::setRotationRadians(Mach1Point3D newRotationRadians) {
-    rotation = newRotationRadians * (180.0 / PI);
-}
-
-void M1DecodeCore::setRotationQuat(Mach1Point4D newRotationQuat) {
-    Mach1Point3D angles;
-
-    // roll (x-axis rotation)
-    float sinr_cosp = 2 * (newRotationQuat.w * newRotationQuat.x + newRotationQuat.y * newRotationQuat.z);
-    float cosr_cosp = 1 - 2 * (newRotationQuat.x * newRotationQuat.x + newRotationQuat.y * newRotationQuat.y);
-    angles.x = atan2f(sinr_cosp, cosr_cosp);
-
-    // pitch (y-axis rotation)
-    float sinp = 2 * (newRotationQuat.w * newRotationQuat.y - newRotationQuat.z * newRotationQuat.x);
-    if (std::abs(sinp) >= 1) {
-        angles.y = copysignf(PI / 2, sinp); // use 90 degrees if out of range
-    } else {
-        angles.y = asinf(sinp);
-    }
-
-    // yaw (z-axis rotation)
-    float siny_cosp = 2 * (newRotationQuat.w * newRotationQuat.z + newRotationQuat.x * newRotationQuat.y);
-    float cosy_cosp = 1 - 2 * (newRotationQuat.y * newRotationQuat.y + newRotationQuat.z * newRotationQuat.z);
-    angles.z = atan2f(siny_cosp, cosy_cosp);
-
-    setRotationRadians(angles);
-}
-
-void M1DecodeCore::setFilterSpeed(float newFilterSpeed) {
-    filterSpeed = newFilterSpeed;
-}
-
-//--------------------------------------------------
-
-void M1DecodeCore::setDecodeMode(Mach1DecodeMode mode) {
-    decodeMode = mode;
-}
-
-Mach1DecodeMode M1DecodeCore::getDecodeMode() {
-    return decodeMode;
-}
-
-std::vector<float> M1DecodeCore::decode(float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
-    setRotationDegrees({Yaw, Pitch, Roll});
-    return decodeCoeffs(bufferSize, sampleIndex);
-}
-
-std::vector<float> M1DecodeCore::decodeCoeffs(int bufferSize, int sampleIndex) {
-    long tStart = getCurrentTime();
-    std::vector<float> coeffs;
-
-    float yaw = fmod(rotation.x, 360.0); // protect a 360 cycle
-    float pitch = fmod(rotation.y, 360.0);
-    float roll = fmod(rotation.z, 360.0);
-    
-    switch (decodeMode) {
-    case M1DecodeSpatial_4:
-        coeffs = processSample(&M1DecodeCore::spatialAlgo_4, yaw, pitch, roll, bufferSize, sampleIndex);
-        break;
-
-    case M1DecodeSpatial_8:
-        coeffs = processSample(&M1DecodeCore::spatialAlgo_8, yaw, pitch, roll, bufferSize, sampleIndex);
-        break;
-
-    case M1DecodeSpatial_14:
-        coeffs = processSample(&M1DecodeCore::spatialAlgo_14, yaw, pitch, roll, bufferSize, sampleIndex);
-        break;
-
-    default:
-        break;
-    }
-    
-    timeLastCalculation = getCurrentTime() - tStart;
-    return coeffs;
-}
-
-// Return decode Coeffs for audio players that support pan & gain functions to reduce verbosity of the client side spatial mixer
-std::vector<float> M1DecodeCore::decodePannedCoeffs(int bufferSize, int sampleIndex, bool applyPanLaw) {
-    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
-
-    bool panLaw = applyPanLaw;
-    std::vector<float> pannedCoeffs;
-
-    for (int i = 0; i < (coeffs.size() - 2) / 2; i++) {
-        float l = coeffs[i * 2];
-        float r = coeffs[i * 2 + 1];
-        float gain = 0.0;
-        float pan = 0.0;
-
-        if (l > r) {
-            pan = -(1 - r / l);
-            if (panLaw) {
-                gain = l * (sqrt(2) / 2);
-            } else {
-                gain = l;
-            }
-        } else {
-            pan = (1 - l / r);
-            if (panLaw) {
-                gain = r * (sqrt(2) / 2);
-            } else {
-                gain = r;
-            }
-        }
-        // if gain is 0 reset pan
-        if (gain == 0) {
-            pan = 0;
-        }
-        // if pan is NaN reset pan
-        if (std::isnan(pan)) {
-            pan = 0.0;
-        }
-        pannedCoeffs.push_back(gain);
-        pannedCoeffs.push_back(pan);
-    }
-    return pannedCoeffs;
-}
-
-// Decode using the current algorithm type in a more efficient way
-void M1DecodeCore::decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
-    setRotationDegrees({Yaw, Pitch, Roll});
-    decodeCoeffs(result, bufferSize, sampleIndex);
-}
-
-void M1DecodeCore::decodeCoeffs(float *result, int bufferSize, int sampleIndex) {
-    long tStart = getCurrentTime();
-
-    float Yaw = fmod(rotation.x, 360.0); // protect a 360 cycle
-    float Pitch = fmod(rotation.y, 360.0);
-    float Roll = fmod(rotation.z, 360.0);
-
-    switch (decodeMode) {
-    case M1DecodeSpatial_4:
-        processSample(&M1DecodeCore::spatialAlgo_4, Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
-        break;
-
-    case M1DecodeSpatial_8:
-        processSample(&M1DecodeCore::spatialAlgo_8, Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
-        break;
-
-    case M1DecodeSpatial_14:
-        processSample(&M1DecodeCore::spatialAlgo_14, Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
-        break;
-
-    default:
-        break;
-    }
-    
-    timeLastCalculation = getCurrentTime() - tStart;
-}
-
-void M1DecodeCore::decodePannedCoeffs(float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
-    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
-
-    bool panLaw = applyPanLaw;
-
-    for (int i = 0; i < (coeffs.size() - 2) / 2; i++) {
-        float l = coeffs[i * 2];
-        float r = coeffs[i * 2 + 1];
-        float gain = 0.0;
-        float pan = 0.0;
-
-        if (l > r) {
-            pan = -(1 - r / l);
-            if (panLaw) {
-                gain = l * (sqrt(2) / 2);
-            } else {
-                gain = l;
-            }
-        } else {
-            pan = (1 - l / r);
-            if (panLaw) {
-                gain = r * (sqrt(2) / 2);
-            } else {
-                gain = r;
-            }
-        }
-        // if gain is 0 reset pan
-        if (gain == 0) {
-            pan = 0;
-        }
-        // if pan is NaN reset pan
-        if (std::isnan(pan)) {
-            pan = 0.0;
-        }
-        result[i * 2] = gain;
-        result[i * 2 + 1] = pan;
-    }
-}
-
-void M1DecodeCore::decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex) {
-    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
-
-    int inChans = channels;
-    int outChans = getFormatCoeffCount();
-    int outStereoDecodeChans = 2;
-
-    for (int i = 0; i < inChans; i++) {
-        for (int j = 0; j < outStereoDecodeChans; j++) {
-            result[i * outStereoDecodeChans + j] = 0;
-            for (int k = 0; k < outChans; k++) {
-                result[i * outStereoDecodeChans + j] += matrix[k * inChans + i] * coeffs[k * outStereoDecodeChans + j];
-            }
-        }
-    }
-}
-
-void M1DecodeCore::processSample(processSampleForMultichannelPtr _processSampleForMultichannelPtr, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
-    convertAnglesToMach1(platformType, &Yaw, &Pitch, &Roll);
-    
-    targetYaw = Yaw;
-    targetPitch = Pitch;
-    targetRoll = Roll;
-
-    if (bufferSize > 0) {
-        // we're in per sample mode
-        // returning values from right here!
-
-        std::vector<float> gainsL(getFormatCoeffCount());
-        std::vector<float> gainsR(getFormatCoeffCount());
-        (this->*_processSampleForMultichannelPtr)(currentYaw, currentPitch, currentRoll, gainsL.data());
-        (this->*_processSampleForMultichannelPtr)(currentYaw, currentPitch, currentRoll, gainsR.data());
-        float phase = (float)sampleIndex / (float)bufferSize;
-
-        std::vector<float> gains_lerp(getFormatCoeffCount());
-        for (int i = 0; i < gains_lerp.size(); i++) {
-            gains_lerp[i] = gainsL[i] * (1 - phase) + gainsR[i] * phase;
-            result[i] = gains_lerp[i];
-        }
-        return;
-    } else {
-        // Filtering per-buffer
-        if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
-            targetYaw = Yaw;
-            targetPitch = Pitch;
-            targetRoll = Roll;
-
-            updateAngles();
-
-            Yaw = currentYaw;
-            Pitch = currentPitch;
-            Roll = currentRoll;
-        } else {
-            targetYaw = Yaw;
-            targetPitch = Pitch;
-            targetRoll = Roll;
-
-            currentYaw = Yaw;
-            currentPitch = Pitch;
-            currentRoll = Roll;
-
-            previousYaw = currentYaw;
-            previousPitch = currentPitch;
-            previousRoll = currentRoll;
-        }
-    }
-
-    // printf("%f, %f, %f\r\n", Yaw, Pitch, Roll);
-
-    (this->*_processSampleForMultichannelPtr)(Yaw, Pitch, Roll, result);
-}
-
-std::vector<float> M1DecodeCore::processSample(processSampleForMultichannel _processSampleForMultichannel, float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
-    convertAnglesToMach1(platformType, &Yaw, &Pitch, &Roll);
-    
-    targetYaw = Yaw;
-    targetPitch = Pitch;
-    targetRoll = Roll;
-
-    if (bufferSize > 0) {
-        // we're in per sample mode
-        // returning values from right here!
-        std::vector<float> gainsL = (this->*_processSampleForMultichannel)(currentYaw, currentPitch, currentRoll);
-        std::vector<float> gainsR = (this->*_processSampleForMultichannel)(currentYaw, currentPitch, currentRoll);
-        float phase = (float)sampleIndex / (float)bufferSize;
-        std::vector<float> gains_lerp;
-        gains_lerp.resize(gainsL.size());
-        for (int i = 0; i < gainsL.size(); i++) {
-            gains_lerp[i] = gainsL[i] * (1 - phase) + gainsR[i] * phase;
-        }
-        return gains_lerp;
-    } else {
-        // Filtering per-buffer
-        if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
-            targetYaw = Yaw;
-            targetPitch = Pitch;
-            targetRoll = Roll;
-
-            updateAngles();
-
-            Yaw = currentYaw;
-            Pitch = currentPitch;
-            Roll = currentRoll;
-        } else {
-            targetYaw = Yaw;
-            targetPitch = Pitch;
-            targetRoll = Roll;
-
-            currentYaw = Yaw;
-            currentPitch = Pitch;
-            currentRoll = Roll;
-
-            previousYaw = currentYaw;
-            previousPitch = currentPitch;
-            previousRoll = currentRoll;
-        }
-    }
-    return (this->*_processSampleForMultichannel)(Yaw, Pitch, Roll);
-}
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+/*
+Internal Orientation Implementation:
+    -  Yaw   [0]+ = rotate right 0-1 [Range: 0->360 | -180->180]
+    -  Yaw   [0]- = rotate left 0-1  [Range: 0->360 | -180->180]
+    -  Pitch [1]+ = rotate up 0-1    [Range: -90->90]
+    -  Pitch [1]- = rotate down 0-1  [Range: -90->90]
+    -  Roll  [2]+ = rotate up 0-1    [Range: -90->90]
+    -  Roll  [2]- = rotate down 0-1  [Range: -90->90]
+
+M1DecodeCore normalizes all input ranges to an unsigned "0 to 1" range for Yaw, Pitch and Roll.
+ */
+
+#include "Mach1DecodeCore.h"
+#include "Mach1DecodeFilterBank.h"
+#include "Mach1DeterministicMath.h"
+#include <algorithm>
+#include <string>
+
+#ifndef __ANDROID__
+// TODO: Remove this and figure out how to get ANDROID builds to accept newer stdlib
+#    define copysign std::copysign
+#endif
+
+#ifndef DEG_TO_RAD
+#    define DEG_TO_RAD (PI / 180.0)
+#endif
+
+#ifndef __FLT_EPSILON__
+#    define __FLT_EPSILON__ 1.19209290e-07F
+#endif
+
+// kernels below keep their written floating point evaluation order, see Mach1DeterministicMath.h
+M1_DETERMINISTIC_FP_BEGIN
+
+float M1DecodeCore::lerp(float x1, float x2, float t) {
+    return x1 + (x2 - x1) * t;
+}
+
+float M1DecodeCore::mDegToRad(float degrees) {
+    return (float)(degrees * DEG_TO_RAD);
+}
+
+void M1DecodeCore::sinCosDegrees(float degrees, float &s, float &c) {
+    if (deterministic) {
+        m1DetSinCos(mDegToRad(degrees), s, c);
+    } else {
+        s = sinf(mDegToRad(degrees));
+        c = cosf(mDegToRad(degrees));
+    }
+}
+
+//
+// Map utility
+//
+
+float M1DecodeCore::mmap(float value, float inputMin, float inputMax, float outputMin, float outputMax, bool clamp) {
+
+    if (fabs(inputMin - inputMax) < __FLT_EPSILON__) {
+        return outputMin;
+    } else {
+        float outVal = ((value - inputMin) / (inputMax - inputMin) * (outputMax - outputMin) + outputMin);
+
+        if (clamp) {
+            if (outputMax < outputMin) {
+                if (outVal < outputMax)
+                    outVal = outputMax;
+                else if (outVal > outputMin)
+                    outVal = outputMin;
+            } else {
+                if (outVal > outputMax)
+                    outVal = outputMax;
+                else if (outVal < outputMin)
+                    outVal = outputMin;
+            }
+        }
+        return outVal;
+    }
+}
+
+float M1DecodeCore::clamp(float a, float min, float max) {
+    return (a < min) ? min : ((a > max) ? max : a);
+}
+
+float M1DecodeCore::alignAngle(float a, float min, float max) {
+    if (a > 5000 || a < -5000)
+        return 0;
+
+    while (a < min)
+        a += 360;
+    while (a > max)
+        a -= 360;
+
+    return a;
+}
+
+float M1DecodeCore::radialDistance(float angle1, float angle2) {
+    if ((std::abs(angle2 - angle1)) > (std::abs(std::abs(angle2 - angle1) - 360))) {
+        return std::abs(std::abs(angle2 - angle1) - 360);
+    } else
+        return std::abs(angle2 - angle1);
+}
+
+float M1DecodeCore::targetDirectionMultiplier(float angleCurrent, float angleTarget) {
+    if (((std::abs(angleCurrent - angleTarget)) >
+         (std::abs(angleCurrent - angleTarget + 360))) ||
+        ((std::abs(angleCurrent - angleTarget)) >
+         (std::abs(angleCurrent - angleTarget - 360)))) {
+        if (angleCurrent < angleTarget) {
+            return -1.;
+        }
+        if (angleCurrent > angleTarget) {
+            return 1.;
+        }
+    } else {
+        if (angleCurrent < angleTarget) {
+            return 1.;
+        }
+        if (angleCurrent > angleTarget) {
+            return -1.;
+        }
+    }
+    return 0.;
+}
+
+// Note: Envelope follower feature is defined here, in updateAngles()
+void M1DecodeCore::updateAngles() {
+    targetYaw = fmod(targetYaw, 360);
+    targetPitch = fmod(targetPitch, 360);
+    targetRoll = fmod(targetRoll, 360);
+
+    currentYaw = fmod(currentYaw, 360);
+    currentPitch = fmod(currentPitch, 360);
+    currentRoll = fmod(currentRoll, 360);
+
+    if (filterSpeed >= 1.0f) {
+        currentYaw = targetYaw;
+        currentPitch = targetPitch;
+        currentRoll = targetRoll;
+    } else {
+        float speedAngle = timeLastUpdate ? filterSpeed * 1.0f * (getCurrentTime() - timeLastUpdate) : 0;
+
+        timeLastUpdate = getCurrentTime();
+
+        float distanceYaw = radialDistance(targetYaw, currentYaw);
+        float distancePitch = radialDistance(targetPitch, currentPitch);
+        float distanceRoll = radialDistance(targetRoll, currentRoll);
+
+        float distance = distanceYaw + distancePitch + distanceRoll;
+
+        if (distanceYaw > speedAngle && distance < 360) {
+            currentYaw += speedAngle * targetDirectionMultiplier(currentYaw, targetYaw);
+        } else {
+            currentYaw = targetYaw;
+        }
+
+        if (distancePitch > speedAngle && distance < 360) {
+            currentPitch += speedAngle * targetDirectionMultiplier(currentPitch, targetPitch);
+        } else {
+            currentPitch = targetPitch;
+        }
+
+        if (distanceRoll > speedAngle && distance < 360) {
+            currentRoll += speedAngle * targetDirectionMultiplier(currentRoll, targetRoll);
+        } else {
+            currentRoll = targetRoll;
+        }
+    }
+}
+
+float M1DecodeCore::_dot(const Mach1Point3D &p1, const Mach1Point3D &p2) const {
+    return p1.x * p2.x + p1.y * p2.y + p1.z * p2.z;
+}
+
+bool M1DecodeCore::linePlaneIntersection(Mach1Point3D &contact, Mach1Point3D ray, Mach1Point3D rayOrigin, Mach1Point3D normal, Mach1Point3D coord) {
+    float epsilon = 1e-6f;
+
+    Mach1Point3D u = rayOrigin - ray;
+    float dot = _dot(normal, u);
+
+    if (fabs(dot) > epsilon) {
+        Mach1Point3D w = ray - coord;
+        float fac = -_dot(normal, w) / dot;
+        if (fac >= 0.0 && fac <= 1.0) {
+            u = u * fac;
+            contact = ray + u;
+            return true;
+        }
+    }
+    return false;
+}
+
+void M1DecodeCore::lockAngles(float &Pitch, float &Roll) {
+    if (!usePitchForRotation) Pitch = 0;
+    if (!useRollForRotation) Roll = 0;
+}
+
+void M1DecodeCore::filterAngles(float &Yaw, float &Pitch, float &Roll) {
+    if (filterBank != nullptr) { // already filtered by the bank, only wrap like updateAngles() does on a repeated target
+        if (filterSpeed <= 1.0f && filterSpeed > 0.0f) {
+            currentYaw = Yaw = fmod(Yaw, 360);
+            currentPitch = Pitch = fmod(Pitch, 360);
+            currentRoll = Roll = fmod(Roll, 360);
+        }
+        return;
+    }
+
+    if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
+        targetYaw = Yaw;
+        targetPitch = Pitch;
+        targetRoll = Roll;
+
+        updateAngles();
+
+        Yaw = currentYaw;
+        Pitch = currentPitch;
+        Roll = currentRoll;
+    } else {
+        targetYaw = Yaw;
+        targetPitch = Pitch;
+        targetRoll = Roll;
+
+        currentYaw = Yaw;
+        currentPitch = Pitch;
+        currentRoll = Roll;
+
+        previousYaw = currentYaw;
+        previousPitch = currentPitch;
+        previousRoll = currentRoll;
+    }
+}
+
+void M1DecodeCore::spatialMultichannelAlgo(const Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *result) {
+    // Listener basis from one sin/cos per angle. This is the closed form of the previous
+    // chain of getRotated() calls:
+    //   fVec_2a = fVec_1a rotated by -Pitch around fVec_1b  = ( sy*cp,  cy*cp, sp)  (forward)
+    //   fVec_2b = fVec_1a rotated by -Pitch-90 around fVec_1b = (-sy*sp, -cy*sp, cp)  (up)
+    //   fVec_2a x fVec_2b = (cy, -sy, 0)
+    //   fVecL/fVecR = fVec_2b rotated by Roll -/+ 90 around fVec_2a = +/-(sr * fVec_2b - cr * (cy, -sy, 0))
+    float sy, cy, sp, cp, sr, cr;
+    sinCosDegrees(Yaw, sy, cy);
+    sinCosDegrees(Pitch, sp, cp);
+    sinCosDegrees(Roll, sr, cr);
+
+    Mach1Point3D fVec_2a = {sy * cp, cy * cp, sp};
+    Mach1Point3D fVecL = {-sr * sy * sp - cr * cy, -sr * cy * sp + cr * sy, sr * cp};
+
+    // contactL = fVec_2a + fVecL and contactR = fVec_2a - fVecL are mirror images about fVec_2a.
+    // Both have a squared length of 2 (fVec_2a and fVecL are orthogonal unit vectors), so
+    //   |contactL/R - p|^2 = (2 + |p|^2 - 2 * dot(fVec_2a, p)) -/+ 2 * dot(fVecL, p)
+    // The ears share the first term and differ only in the sign of the second one.
+
+    float d = sqrtf(5); // 100*100+200*200
+
+    // Calculate pitch influence (0 = horizontal plane, 1 = directly up, -1 = directly down)
+    float pitchInfluence = sp;  // -1 to +1
+
+    for (int i = 0; i < numChannelPoints; i++) {
+        const Mach1Point3D &p = channelPoints[i];
+
+        // Calculate vertical attenuation
+        // When looking up (+pitch), attenuate lower channels
+        // When looking down (-pitch), attenuate upper channels
+        float verticalAttenuation;
+        if (pitchInfluence >= 0) {
+            // Looking up - attenuate lower channels
+            verticalAttenuation = p.z < 0 ? (1.0f - pitchInfluence) : 1.0f;
+        } else {
+            // Looking down - attenuate upper channels
+            verticalAttenuation = p.z > 0 ? (1.0f + pitchInfluence) : 1.0f;
+        }
+
+        float shared = 2 + p.x * p.x + p.y * p.y + p.z * p.z - 2 * (fVec_2a.x * p.x + fVec_2a.y * p.y + fVec_2a.z * p.z);
+        float ear = 2 * (fVecL.x * p.x + fVecL.y * p.y + fVecL.z * p.z);
+
+        float vL = sqrtf(fmaxf(shared - ear, 0));
+        float vR = sqrtf(fmaxf(shared + ear, 0));
+
+        // Combine horizontal and vertical influences
+        result[i * 2 + 0] = M1DecodeCore::clamp(M1DecodeCore::mmap(vL, 0, d, 1.f, 0.f, false), 0, 1) * verticalAttenuation;
+        result[i * 2 + 1] = M1DecodeCore::clamp(M1DecodeCore::mmap(vR, 0, d, 1.f, 0.f, false), 0, 1) * verticalAttenuation;
+    }
+
+    // Gain normalizer v2.0
+    float sumL = 0, sumR = 0;
+    for (int i = 0; i < numChannelPoints; i++) {
+        sumL += result[i * 2];
+        sumR += result[i * 2 + 1];
+    }
+    for (int i = 0; i < numChannelPoints; i++) {
+        result[i * 2 + 0] /= sumL;
+        result[i * 2 + 1] /= sumR;
+    }
+}
+
+// Yaw-only kernel for the cube corner layouts (Spatial_4 and Spatial_8) with a level listener.
+// Both ears then lie in the z = 0 plane at (sy -/+ cy, cy +/- sy, 0), so |contact - corner|^2 = 5 - 2 * dot(contact, corner)
+// and the 8 ear/corner distances reduce to 4 values: 5 -/+ 4 * cy and 5 -/+ 4 * sy.
+// The right ear gets the left ear gains permuted, both ears share one normalizer, and the lower
+// corners get the same gains as the upper ones (the vertical attenuation is 1 at zero pitch).
+void M1DecodeCore::spatialAlgoYaw_Corners(float Yaw, int numLayers, float *result) {
+    float sy, cy;
+    sinCosDegrees(Yaw, sy, cy);
+    float d = sqrtf(5); // 100*100+200*200
+
+    float gFront = M1DecodeCore::clamp(1 - sqrtf(5 - 4 * cy) / d, 0, 1);
+    float gBack = M1DecodeCore::clamp(1 - sqrtf(5 + 4 * cy) / d, 0, 1);
+    float gRight = M1DecodeCore::clamp(1 - sqrtf(5 - 4 * sy) / d, 0, 1);
+    float gLeft = M1DecodeCore::clamp(1 - sqrtf(5 + 4 * sy) / d, 0, 1);
+
+    // Gain normalizer v2.0
+    float norm = 1.0f / (numLayers * (gFront + gBack + gRight + gLeft));
+    gFront *= norm;
+    gBack *= norm;
+    gRight *= norm;
+    gLeft *= norm;
+
+    for (int layer = 0; layer < numLayers; layer++) {
+        float *r = result + layer * 8;
+        r[0] = gFront; // {-1, 1}
+        r[1] = gLeft;
+        r[2] = gRight; // {1, 1}
+        r[3] = gFront;
+        r[4] = gLeft;  // {-1, -1}
+        r[5] = gBack;
+        r[6] = gBack;  // {1, -1}
+        r[7] = gRight;
+    }
+}
+
+bool M1DecodeCore::reuseCachedCoeffs(int numChannelPoints, float Yaw, float Pitch, float Roll, float *result) {
+    if (coeffReuseThreshold <= 0 || cachedNumChannelPoints != numChannelPoints ||
+        radialDistance(Yaw, cachedAngles[0]) >= coeffReuseThreshold ||
+        radialDistance(Pitch, cachedAngles[1]) >= coeffReuseThreshold ||
+        radialDistance(Roll, cachedAngles[2]) >= coeffReuseThreshold) {
+        coeffEvaluateCount++;
+        return false;
+    }
+
+    for (int i = 0; i < numChannelPoints * 2; i++) {
+        result[i] = cachedCoeffs[i];
+    }
+    coeffReuseCount++;
+    return true;
+}
+
+void M1DecodeCore::storeCachedCoeffs(int numChannelPoints, float Yaw, float Pitch, float Roll, const float *result) {
+    if (coeffReuseThreshold <= 0) {
+        return;
+    }
+
+    // compared against the last evaluated orientation, so slow drift still triggers an update once it adds up to the threshold
+    cachedNumChannelPoints = numChannelPoints;
+    cachedAngles[0] = Yaw;
+    cachedAngles[1] = Pitch;
+    cachedAngles[2] = Roll;
+    for (int i = 0; i < numChannelPoints * 2; i++) {
+        cachedCoeffs[i] = result[i];
+    }
+}
+
+/*
+ Defined multichannel spatial layouts
+
+ Mach1 XYZ Coordinate Expectation:
+ X (left -> right | where -X is left)
+ Y (front -> back | where -Y is back)
+ Z (top -> bottom | where -Z is bottom)
+
+ */
+
+// Spatial_8 cube corners followed by the Spatial_14 mid points
+// Spatial_4 uses the first 4 (upper) corners, Spatial_8 the first 8 points
+static const float spatialDiag = sqrtf(2);
+static const Mach1Point3D spatialChannelPoints[8 + 4 + 2] =
+    {
+        {-1, 1, 1},
+        {1, 1, 1},
+        {-1, -1, 1},
+        {1, -1, 1},
+
+        {-1, 1, -1},
+        {1, 1, -1},
+        {-1, -1, -1},
+        {1, -1, -1},
+
+        {0, spatialDiag, 0},
+        {spatialDiag, 0, 0},
+        {0, -spatialDiag, 0},
+        {-spatialDiag, 0, 0},
+
+        {0, 0, spatialDiag},
+        {0, 0, -spatialDiag},
+    };
+
+void M1DecodeCore::spatialAlgo_4(float Yaw, float Pitch, float Roll, float *result) {
+    const int numChannelPoints = 4;
+
+    filterAngles(Yaw, Pitch, Roll);
+    if (reuseCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result)) {
+        return;
+    }
+
+    if (Pitch == 0 && Roll == 0) {
+        spatialAlgoYaw_Corners(Yaw, 1, result);
+        storeCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result);
+        return;
+    }
+
+    // Ideally Z should be 0, but this results in unexpected results from a lack of a 3D shape
+    spatialMultichannelAlgo(spatialChannelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
+    storeCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result);
+}
+
+std::vector<float> M1DecodeCore::spatialAlgo_4(float Yaw, float Pitch, float Roll) {
+    const int numChannelPoints = 4;
+
+    std::vector<float> result;
+    result.resize(numChannelPoints * 2);
+
+    spatialAlgo_4(Yaw, Pitch, Roll, result.data());
+
+    return result;
+}
+
+void M1DecodeCore::spatialAlgo_8(float Yaw, float Pitch, float Roll, float *result) {
+    const int numChannelPoints = 8;
+
+    filterAngles(Yaw, Pitch, Roll);
+    if (reuseCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result)) {
+        return;
+    }
+
+    if (Pitch == 0 && Roll == 0) {
+        spatialAlgoYaw_Corners(Yaw, 2, result);
+        storeCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result);
+        return;
+    }
+
+    spatialMultichannelAlgo(spatialChannelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
+    storeCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result);
+}
+
+std::vector<float> M1DecodeCore::spatialAlgo_8(float Yaw, float Pitch, float Roll) {
+    const int numChannelPoints = 8;
+
+    std::vector<float> result;
+    result.resize(numChannelPoints * 2);
+
+    spatialAlgo_8(Yaw, Pitch, Roll, result.data());
+
+    return result;
+}
+
+void M1DecodeCore::spatialAlgo_14(float Yaw, float Pitch, float Roll, float *result) {
+    const int numChannelPoints = 8 + 4 + 2;
+
+    filterAngles(Yaw, Pitch, Roll);
+    if (reuseCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result)) {
+        return;
+    }
+
+    spatialMultichannelAlgo(spatialChannelPoints, numChannelPoints, Yaw, Pitch, Roll, result);
+    storeCachedCoeffs(numChannelPoints, Yaw, Pitch, Roll, result);
+}
+
+std::vector<float> M1DecodeCore::spatialAlgo_14(float Yaw, float Pitch, float Roll) {
+    const int numChannelPoints = 8 + 4 + 2;
+
+    std::vector<float> result;
+    result.resize(numChannelPoints * 2);
+
+    spatialAlgo_14(Yaw, Pitch, Roll, result.data());
+
+    return result;
+}
+
+// Derivatives of the spatialMultichannelAlgo() gains per degree of yaw, pitch and roll.
+// Follows the same steps: ear contact points, clamped distance gain, vertical attenuation, then the
+// per-ear normalization (quotient rule). Gains at the clamp limits have a zero derivative.
+// The vertical attenuation switches between the lower and the upper points at pitch 0, so the gains have
+// a kink there: at exactly pitch 0 d/dPitch is the one-sided derivative towards positive pitch.
+void M1DecodeCore::spatialMultichannelGradient(const Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *gradient) {
+    const float k = (float)DEG_TO_RAD;
+    float sy, cy, sp, cp, sr, cr;
+    sinCosDegrees(Yaw, sy, cy);
+    sinCosDegrees(Pitch, sp, cp);
+    sinCosDegrees(Roll, sr, cr);
+
+    Mach1Point3D fVec_2a = {sy * cp, cy * cp, sp};
+    Mach1Point3D fVecL = {-sr * sy * sp - cr * cy, -sr * cy * sp + cr * sy, sr * cp};
+
+    // d/dYaw, d/dPitch, d/dRoll of fVec_2a and fVecL; locked axes stay at zero
+    Mach1Point3D dForward[3] = {
+        {cy * cp * k, -sy * cp * k, 0},
+        {-sy * sp * k, -cy * sp * k, cp * k},
+        {0, 0, 0},
+    };
+    Mach1Point3D dEar[3] = {
+        {(-sr * cy * sp + cr * sy) * k, (sr * sy * sp + cr * cy) * k, 0},
+        {-sr * sy * cp * k, -sr * cy * cp * k, -sr * sp * k},
+        {(-cr * sy * sp + sr * cy) * k, (-cr * cy * sp - sr * sy) * k, cr * cp * k},
+    };
+    if (!usePitchForRotation) {
+        dForward[1] = {0, 0, 0};
+        dEar[1] = {0, 0, 0};
+    }
+    if (!useRollForRotation) {
+        dEar[2] = {0, 0, 0};
+    }
+
+    float d = sqrtf(5); // 100*100+200*200
+    int numCoeffs = numChannelPoints * 2;
+
+    float raw[14 * 2];
+    float sum[2] = {0, 0};
+    float dSum[3][2] = {{0, 0}, {0, 0}, {0, 0}};
+
+    for (int i = 0; i < numChannelPoints; i++) {
+        const Mach1Point3D &p = channelPoints[i];
+
+        float verticalAttenuation = 1.0f, dVerticalAttenuation = 0;
+        if (sp >= 0) {
+            if (p.z < 0) {
+                verticalAttenuation = 1.0f - sp;
+                dVerticalAttenuation = usePitchForRotation ? -cp * k : 0;
+            }
+        } else {
+            if (p.z > 0) {
+                verticalAttenuation = 1.0f + sp;
+                dVerticalAttenuation = usePitchForRotation ? cp * k : 0;
+            }
+        }
+
+        for (int ear = 0; ear < 2; ear++) {
+            float side = ear == 0 ? 1.0f : -1.0f;
+            Mach1Point3D q = {fVec_2a.x + side * fVecL.x - p.x, fVec_2a.y + side * fVecL.y - p.y, fVec_2a.z + side * fVecL.z - p.z};
+            float dist = q.length();
+            float gain = M1DecodeCore::clamp(1 - dist / d, 0, 1);
+            bool inRange = gain > 0 && gain < 1 && dist > 0;
+
+            int c = i * 2 + ear;
+            raw[c] = gain * verticalAttenuation;
+            sum[ear] += raw[c];
+
+            for (int axis = 0; axis < 3; axis++) {
+                Mach1Point3D dq = {dForward[axis].x + side * dEar[axis].x, dForward[axis].y + side * dEar[axis].y, dForward[axis].z + side * dEar[axis].z};
+                float dGain = inRange ? -(q.x * dq.x + q.y * dq.y + q.z * dq.z) / (dist * d) : 0;
+                float dRaw = dGain * verticalAttenuation + (axis == 1 ? gain * dVerticalAttenuation : 0);
+
+                gradient[axis * numCoeffs + c] = dRaw;
+                dSum[axis][ear] += dRaw;
+            }
+        }
+    }
+
+    // d(raw / sum) = (dRaw - raw / sum * dSum) / sum
+    for (int axis = 0; axis < 3; axis++) {
+        for (int c = 0; c < numCoeffs; c++) {
+            int ear = c % 2;
+            gradient[axis * numCoeffs + c] = (gradient[axis * numCoeffs + c] - raw[c] / sum[ear] * dSum[axis][ear]) / sum[ear];
+        }
+    }
+}
+
+// Angular settings functions
+void M1DecodeCore::convertAnglesToMach1(Mach1PlatformType platformType, float *Y, float *P, float *R) {
+    float _Y = 0, _P = 0, _R = 0;
+
+    switch (platformType) {
+    case Mach1PlatformDefault:
+        *Y = *Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOS:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOSTableTop_ZVertical:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOSPortraitHandheld_YVertical:
+        // TODO: add this!
+        break;
+
+    case Mach1PlatformiOSPortrait_YawOnly:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        if (*R < 0 && *Y < 0) {
+            *Y = 360 - (-1 * (*Y + *R));
+        } else {
+            *Y = *Y + *R;
+        }
+        break;
+
+    case Mach1PlatformUnity:
+        // P Y R -> Y P R
+        _P = *Y;
+        _Y = *P;
+        _R = *R;
+        *Y = _Y;
+        *P = -_P;
+        *R = -_R;
+        break;
+
+    case Mach1PlatformUE:
+        // R P Y -> Y P R
+        _R = *Y;
+        _P = *P;
+        _Y = *R;
+        *Y = _Y;
+        *P = _P;
+        *R = _R;
+        break;
+
+    case Mach1PlatformOfEasyCam:
+        *Y = *Y;
+        *P = -*P;
+        *R = -*R;
+        break;
+
+    case Mach1PlatformAndroid:
+        // P Y R -> Y -P R
+        _P = *Y;
+        _Y = *P;
+        _R = *R;
+        *Y = _Y;
+        *P = -_P;
+        *R = _R;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void M1DecodeCore::convertAnglesToPlatform(Mach1PlatformType platformType, float *Y, float *P, float *R) {
+    float _Y = 0, _P = 0, _R = 0;
+
+    switch (platformType) {
+    case Mach1PlatformDefault:
+        *Y = *Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOS:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOSTableTop_ZVertical:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        break;
+
+    case Mach1PlatformiOSPortraitHandheld_YVertical:
+        // TODO: add this!
+        break;
+
+    case Mach1PlatformiOSPortrait_YawOnly:
+        *Y = -*Y;
+        *P = *P;
+        *R = *R;
+        if (*R < 0 && *Y < 0) {
+            *Y = 360 - (-1 * (*Y + *R));
+        } else {
+            *Y = *Y + *R;
+        }
+        break;
+
+    case Mach1PlatformUnity:
+        // Y P R -> P Y R
+        _Y = *Y;
+        _P = -*P;
+        _R = -*R;
+        *Y = _P;
+        *P = _Y;
+        *R = _R;
+        break;
+
+    case Mach1PlatformUE:
+        // Y P -R -> R P Y
+        _Y = *Y;
+        _P = *P;
+        _R = *R;
+        *Y = _R;
+        *P = _P;
+        *R = _Y;
+        break;
+
+    case Mach1PlatformOfEasyCam:
+        *Y = *Y;
+        *P = -*P;
+        *R = -*R;
+        break;
+
+    case Mach1PlatformAndroid:
+        *Y = -*Y;
+        *P = -*P;
+        *R = *R;
+        std::swap(*P, *Y);
+        break;
+
+    default:
+        break;
+    }
+}
+
+Mach1Point3D M1DecodeCore::getCurrentAngle() {
+    Mach1Point3D angle = {currentYaw, currentPitch, currentRoll};
+    return angle;
+}
+
+void M1DecodeCore::addToLog(std::string str, int maxCount) {
+    if (strLog.size() > maxCount)
+        strLog.erase(strLog.begin() + maxCount, strLog.begin() + strLog.size() - 1);
+
+    strLog.push_back(str);
+}
+
+char *M1DecodeCore::getLog() {
+    std::vector<std::string> _strLog = strLog;
+    strLog.clear();
+
+    static char log[100000] = "";
+
+    log[0] = '\0';
+    /*
+    for (int i = 0; i<_strLog.size(); i++) strcat(log, _strLog[i].c_str());
+     */
+    return log;
+}
+
+M1DecodeCore::M1DecodeCore() {
+    filterBank = nullptr;
+    reset();
+}
+
+M1DecodeCore::~M1DecodeCore() {
+    if (filterBank != nullptr) {
+        filterBank->remove(this);
+    }
+}
+
+M1DecodeCore::M1DecodeCore(const M1DecodeCore &other) {
+    filterBank = nullptr;
+    *this = other;
+}
+
+M1DecodeCore &M1DecodeCore::operator=(const M1DecodeCore &other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    // the bank tracks decoders by address, so neither the lane of other nor our own carries over
+    if (filterBank != nullptr) {
+        filterBank->remove(this);
+    }
+    filterBank = nullptr;
+    filterBankLane = -1;
+
+    // the filtered angles are those of other's last decode, bound or not
+    currentYaw = other.currentYaw;
+    currentPitch = other.currentPitch;
+    currentRoll = other.currentRoll;
+
+    targetYaw = other.targetYaw;
+    targetPitch = other.targetPitch;
+    targetRoll = other.targetRoll;
+
+    previousYaw = other.previousYaw;
+    previousPitch = other.previousPitch;
+    previousRoll = other.previousRoll;
+
+    filterSpeed = other.filterSpeed;
+    timeLastUpdate = other.timeLastUpdate;
+    timeLastCalculation = other.timeLastCalculation;
+    useManualTime = other.useManualTime;
+    manualTime = other.manualTime;
+    deterministic = other.deterministic;
+
+    platformType = other.platformType;
+    decodeMode = other.decodeMode;
+    reducedDecodeMode = other.reducedDecodeMode;
+    std::copy(other.reducedCoeffs, other.reducedCoeffs + 14 * 2, reducedCoeffs);
+
+    usePitchForRotation = other.usePitchForRotation;
+    useRollForRotation = other.useRollForRotation;
+
+    std::copy(other.rotationHistory, other.rotationHistory + M1_ROTATION_HISTORY_SIZE, rotationHistory);
+    std::copy(other.rotationHistoryTime, other.rotationHistoryTime + M1_ROTATION_HISTORY_SIZE, rotationHistoryTime);
+    rotationHistoryCount = other.rotationHistoryCount;
+    predictionTargetTime = other.predictionTargetTime;
+    predictionHorizon = other.predictionHorizon;
+
+    coeffReuseThreshold = other.coeffReuseThreshold;
+    cachedNumChannelPoints = other.cachedNumChannelPoints;
+    std::copy(other.cachedAngles, other.cachedAngles + 3, cachedAngles);
+    std::copy(other.cachedCoeffs, other.cachedCoeffs + 14 * 2, cachedCoeffs);
+    coeffReuseCount = other.coeffReuseCount;
+    coeffEvaluateCount = other.coeffEvaluateCount;
+
+    rotation = other.rotation;
+
+    ms = other.ms;
+
+    strLog = other.strLog;
+
+    return *this;
+}
+
+void M1DecodeCore::reset() {
+    // a pooled slot must not stay bound to the lane of its previous owner
+    if (filterBank != nullptr) {
+        filterBank->remove(this);
+    }
+
+    currentYaw = 0;
+    currentPitch = 0;
+    currentRoll = 0;
+
+    targetYaw = 0;
+    targetPitch = 0;
+    targetRoll = 0;
+
+    previousYaw = 0;
+    previousPitch = 0;
+    previousRoll = 0;
+
+    filterSpeed = 0.9f;
+    timeLastUpdate = 0;
+    timeLastCalculation = 0;
+    useManualTime = false;
+    manualTime = 0;
+    filterBank = nullptr;
+    filterBankLane = -1;
+    deterministic = false;
+
+    platformType = Mach1PlatformDefault;
+    decodeMode = M1DecodeSpatial_8;
+    reducedDecodeMode = M1DecodeSpatial_14;
+
+    usePitchForRotation = true;
+    useRollForRotation = true;
+
+    rotationHistoryCount = 0;
+    predictionTargetTime = 0;
+    predictionHorizon = 0;
+
+    coeffReuseThreshold = 0;
+    cachedNumChannelPoints = 0;
+    coeffReuseCount = 0;
+    coeffEvaluateCount = 0;
+
+    rotation = {0, 0, 0};
+
+    ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+
+    strLog.clear();
+}
+
+long M1DecodeCore::getCurrentTime() {
+    if (useManualTime || deterministic) {
+        return manualTime;
+    }
+    return (long)(duration_cast<milliseconds>(system_clock::now().time_since_epoch()) - ms).count();
+}
+
+long M1DecodeCore::getLastCalculationTime() {
+    return timeLastCalculation;
+}
+
+void M1DecodeCore::setManualTime(long milliseconds) {
+    useManualTime = true;
+    manualTime = milliseconds;
+}
+
+void M1DecodeCore::setDeterministic(bool enable) {
+    deterministic = enable;
+    timeLastUpdate = 0; // the filter clock switches between the system and the caller's time
+}
+
+bool M1DecodeCore::getDeterministic() {
+    return deterministic;
+}
+
+void M1DecodeCore::setFilterBank(Mach1DecodeFilterBank *bank, int lane) {
+    filterBank = bank;
+    filterBankLane = lane;
+    timeLastUpdate = 0; // the bank keeps its own filter clock
+}
+
+Mach1Point3D M1DecodeCore::getFilterTarget() {
+    Mach1Point3D decodeRotation = getPredictedRotation();
+    float Yaw = fmod(decodeRotation.x, 360.0);
+    float Pitch = fmod(decodeRotation.y, 360.0);
+    float Roll = fmod(decodeRotation.z, 360.0);
+
+    convertAnglesToMach1(platformType, &Yaw, &Pitch, &Roll);
+    lockAngles(Pitch, Roll);
+
+    Mach1Point3D target = {Yaw, Pitch, Roll};
+    return target;
+}
+
+void M1DecodeCore::clearManualTime() {
+    useManualTime = false;
+    timeLastUpdate = 0; // the two clocks share no origin, restart the filter step
+}
+
+Mach1FilterClock M1DecodeCore::swapFilterClock(Mach1FilterClock clock) {
+    Mach1FilterClock previous = {useManualTime, manualTime, timeLastUpdate};
+    useManualTime = clock.useManualTime;
+    manualTime = clock.manualTime;
+    timeLastUpdate = clock.timeLastUpdate;
+    return previous;
+}
+
+void M1DecodeCore::setPlatformType(Mach1PlatformType type) {
+    platformType = type;
+}
+
+Mach1PlatformType M1DecodeCore::getPlatformType() {
+    return platformType;
+}
+
+int M1DecodeCore::getFormatChannelCount() {
+    switch (decodeMode) {
+    case M1DecodeSpatial_4:
+        return 4;
+    case M1DecodeSpatial_8:
+        return 8;
+    case M1DecodeSpatial_14:
+        return 14;
+    }
+    return 0;
+}
+
+int M1DecodeCore::getFormatCoeffCount() {
+    switch (decodeMode) {
+    case M1DecodeSpatial_4:
+        return (4 * 2);
+    case M1DecodeSpatial_8:
+        return (8 * 2);
+    case M1DecodeSpatial_14:
+        return (14 * 2);
+    }
+    return 0;
+}
+
+void M1DecodeCore::setRotation(Mach1Point3D newRotationFromMinusOnetoOne) {
+    rotation = newRotationFromMinusOnetoOne * 360.0;
+    rotationHistoryCount = 0;
+}
+
+void M1DecodeCore::setRotationDegrees(Mach1Point3D newRotationDegrees) {
+    rotation = newRotationDegrees;
+    rotationHistoryCount = 0;
+}
+
+void M1DecodeCore::setRotationRadians(Mach1Point3D newRotationRadians) {
+    rotation = newRotationRadians * (180.0 / PI);
+    rotationHistoryCount = 0;
+}
+
+void M1DecodeCore::setRotationDegreesAtTime(Mach1Point3D newRotationDegrees, double timeSeconds) {
+    if (rotationHistoryCount > 0) {
+        double sinceLast = timeSeconds - rotationHistoryTime[rotationHistoryCount - 1];
+        if (sinceLast <= 0 || sinceLast > M1_MAX_PREDICTION_HORIZON) {
+            rotationHistoryCount = 0; // time went backwards or the tracker stalled, restart the estimate
+        }
+    }
+
+    if (rotationHistoryCount == M1_ROTATION_HISTORY_SIZE) {
+        for (int i = 1; i < M1_ROTATION_HISTORY_SIZE; i++) {
+            rotationHistory[i - 1] = rotationHistory[i];
+            rotationHistoryTime[i - 1] = rotationHistoryTime[i];
+        }
+        rotationHistoryCount--;
+    }
+
+    rotationHistory[rotationHistoryCount] = newRotationDegrees;
+    rotationHistoryTime[rotationHistoryCount] = timeSeconds;
+    rotationHistoryCount++;
+
+    rotation = newRotationDegrees;
+}
+
+void M1DecodeCore::setPredictionTargetTime(double timeSeconds) {
+    predictionTargetTime = timeSeconds;
+}
+
+void M1DecodeCore::setPredictionHorizon(float maxSeconds) {
+    predictionHorizon = clamp(maxSeconds, 0, M1_MAX_PREDICTION_HORIZON);
+}
+
+float M1DecodeCore::getPredictionHorizon() {
+    return predictionHorizon;
+}
+
+Mach1Point3D M1DecodeCore::getPredictedRotation() {
+    if (predictionHorizon <= 0 || rotationHistoryCount < 2) {
+        return rotation;
+    }
+
+    int newest = rotationHistoryCount - 1;
+    double span = rotationHistoryTime[newest] - rotationHistoryTime[0];
+
+    // angular velocity over the history, summing wrapped steps so a yaw crossing +/-180 stays continuous
+    Mach1Point3D travel = {0, 0, 0};
+    for (int i = 1; i <= newest; i++) {
+        travel.x += alignAngle(rotationHistory[i].x - rotationHistory[i - 1].x);
+        travel.y += alignAngle(rotationHistory[i].y - rotationHistory[i - 1].y);
+        travel.z += alignAngle(rotationHistory[i].z - rotationHistory[i - 1].z);
+    }
+
+    float ahead = clamp((float)(predictionTargetTime - rotationHistoryTime[newest]), 0, predictionHorizon) / (float)span;
+
+    Mach1Point3D predicted;
+    predicted.x = rotation.x + travel.x * ahead;
+    predicted.y = clamp(rotation.y + travel.y * ahead, -90, 90);
+    predicted.z = rotation.z + travel.z * ahead;
+    return predicted;
+}
+
+void M1DecodeCore::setRotationQuat(Mach1Point4D newRotationQuat) {
+    Mach1Point3D angles;
+
+    // roll (x-axis rotation)
+    float sinr_cosp = 2 * (newRotationQuat.w * newRotationQuat.x + newRotationQuat.y * newRotationQuat.z);
+    float cosr_cosp = 1 - 2 * (newRotationQuat.x * newRotationQuat.x + newRotationQuat.y * newRotationQuat.y);
+    angles.x = deterministic ? m1DetAtan2(sinr_cosp, cosr_cosp) : atan2f(sinr_cosp, cosr_cosp);
+
+    // pitch (y-axis rotation)
+    float sinp = 2 * (newRotationQuat.w * newRotationQuat.y - newRotationQuat.z * newRotationQuat.x);
+    if (std::abs(sinp) >= 1) {
+        angles.y = copysignf(PI / 2, sinp); // use 90 degrees if out of range
+    } else {
+        angles.y = deterministic ? m1DetAsin(sinp) : asinf(sinp);
+    }
+
+    // yaw (z-axis rotation)
+    float siny_cosp = 2 * (newRotationQuat.w * newRotationQuat.z + newRotationQuat.x * newRotationQuat.y);
+    float cosy_cosp = 1 - 2 * (newRotationQuat.y * newRotationQuat.y + newRotationQuat.z * newRotationQuat.z);
+    angles.z = deterministic ? m1DetAtan2(siny_cosp, cosy_cosp) : atan2f(siny_cosp, cosy_cosp);
+
+    setRotationRadians(angles);
+}
+
+void M1DecodeCore::setFilterSpeed(float newFilterSpeed) {
+    filterSpeed = newFilterSpeed;
+}
+
+//--------------------------------------------------
+
+void M1DecodeCore::setDecodeMode(Mach1DecodeMode mode) {
+    decodeMode = mode;
+}
+
+Mach1DecodeMode M1DecodeCore::getDecodeMode() {
+    return decodeMode;
+}
+
+void M1DecodeCore::setReducedDecodeMode(Mach1DecodeMode mode) {
+    reducedDecodeMode = mode;
+}
+
+Mach1DecodeMode M1DecodeCore::getReducedDecodeMode() {
+    return reducedDecodeMode;
+}
+
+void M1DecodeCore::setUsePitchForRotation(bool usePitchForRotation) {
+    this->usePitchForRotation = usePitchForRotation;
+}
+
+bool M1DecodeCore::getUsePitchForRotation() {
+    return usePitchForRotation;
+}
+
+void M1DecodeCore::setUseRollForRotation(bool useRollForRotation) {
+    this->useRollForRotation = useRollForRotation;
+}
+
+bool M1DecodeCore::getUseRollForRotation() {
+    return useRollForRotation;
+}
+
+void M1DecodeCore::setCoeffReuseThreshold(float thresholdDegrees) {
+    coeffReuseThreshold = thresholdDegrees;
+    cachedNumChannelPoints = 0;
+}
+
+float M1DecodeCore::getCoeffReuseThreshold() {
+    return coeffReuseThreshold;
+}
+
+float M1DecodeCore::getCoeffReuseRate() {
+    long long total = coeffReuseCount + coeffEvaluateCount;
+    return total > 0 ? (float)coeffReuseCount / total : 0;
+}
+
+void M1DecodeCore::resetCoeffReuseRate() {
+    coeffReuseCount = 0;
+    coeffEvaluateCount = 0;
+}
+
+std::vector<float> M1DecodeCore::decode(float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
+    setRotationDegrees({Yaw, Pitch, Roll});
+    return decodeCoeffs(bufferSize, sampleIndex);
+}
+
+std::vector<float> M1DecodeCore::decodeCoeffs(int bufferSize, int sampleIndex) {
+    if (reducedDecodeMode < decodeMode) {
+        std::vector<float> coeffs(getFormatCoeffCount());
+        decodeCoeffs(coeffs.data(), bufferSize, sampleIndex);
+        return coeffs;
+    }
+
+    long tStart = getCurrentTime();
+    std::vector<float> coeffs;
+
+    Mach1Point3D decodeRotation = getPredictedRotation();
+    float yaw = fmod(decodeRotation.x, 360.0); // protect a 360 cycle
+    float pitch = fmod(decodeRotation.y, 360.0);
+    float roll = fmod(decodeRotation.z, 360.0);
+    
+    switch (decodeMode) {
+    case M1DecodeSpatial_4:
+        coeffs = processSample(&M1DecodeCore::spatialAlgo_4, yaw, pitch, roll, bufferSize, sampleIndex);
+        break;
+
+    case M1DecodeSpatial_8:
+        coeffs = processSample(&M1DecodeCore::spatialAlgo_8, yaw, pitch, roll, bufferSize, sampleIndex);
+        break;
+
+    case M1DecodeSpatial_14:
+        coeffs = processSample(&M1DecodeCore::spatialAlgo_14, yaw, pitch, roll, bufferSize, sampleIndex);
+        break;
+
+    default:
+        break;
+    }
+    
+    timeLastCalculation = getCurrentTime() - tStart;
+    return coeffs;
+}
+
+// Return decode Coeffs for audio players that support pan & gain functions to reduce verbosity of the client side spatial mixer
+std::vector<float> M1DecodeCore::decodePannedCoeffs(int bufferSize, int sampleIndex, bool applyPanLaw) {
+    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
+
+    bool panLaw = applyPanLaw;
+    std::vector<float> pannedCoeffs;
+
+    for (int i = 0; i < (coeffs.size() - 2) / 2; i++) {
+        float l = coeffs[i * 2];
+        float r = coeffs[i * 2 + 1];
+        float gain = 0.0;
+        float pan = 0.0;
+
+        if (l > r) {
+            pan = -(1 - r / l);
+            if (panLaw) {
+                gain = l * (sqrt(2) / 2);
+            } else {
+                gain = l;
+            }
+        } else {
+            pan = (1 - l / r);
+            if (panLaw) {
+                gain = r * (sqrt(2) / 2);
+            } else {
+                gain = r;
+            }
+        }
+        // if gain is 0 reset pan
+        if (gain == 0) {
+            pan = 0;
+        }
+        // if pan is NaN reset pan
+        if (std::isnan(pan)) {
+            pan = 0.0;
+        }
+        pannedCoeffs.push_back(gain);
+        pannedCoeffs.push_back(pan);
+    }
+    return pannedCoeffs;
+}
+
+// Decode using the current algorithm type in a more efficient way
+void M1DecodeCore::decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
+    setRotationDegrees({Yaw, Pitch, Roll});
+    decodeCoeffs(result, bufferSize, sampleIndex);
+}
+
+void M1DecodeCore::decodeCoeffs(float *result, int bufferSize, int sampleIndex) {
+    long tStart = getCurrentTime();
+
+    Mach1Point3D decodeRotation = getPredictedRotation();
+    float Yaw = fmod(decodeRotation.x, 360.0); // protect a 360 cycle
+    float Pitch = fmod(decodeRotation.y, 360.0);
+    float Roll = fmod(decodeRotation.z, 360.0);
+
+    Mach1DecodeMode algoMode = reducedDecodeMode < decodeMode ? reducedDecodeMode : decodeMode;
+    float *algoResult = algoMode != decodeMode ? reducedCoeffs : result;
+
+    switch (algoMode) {
+    case M1DecodeSpatial_4:
+        processSample(&M1DecodeCore::spatialAlgo_4, Yaw, Pitch, Roll, algoResult, bufferSize, sampleIndex);
+        break;
+
+    case M1DecodeSpatial_8:
+        processSample(&M1DecodeCore::spatialAlgo_8, Yaw, Pitch, Roll, algoResult, bufferSize, sampleIndex);
+        break;
+
+    case M1DecodeSpatial_14:
+        processSample(&M1DecodeCore::spatialAlgo_14, Yaw, Pitch, Roll, algoResult, bufferSize, sampleIndex);
+        break;
+
+    default:
+        break;
+    }
+
+    if (algoMode != decodeMode) {
+        transcodeReducedCoeffs(algoMode, decodeMode, reducedCoeffs, result);
+    }
+    
+    timeLastCalculation = getCurrentTime() - tStart;
+}
+
+void M1DecodeCore::decodeCoeffsWithGradient(float *result, float *gradient) {
+    long tStart = getCurrentTime();
+
+    Mach1Point3D decodeRotation = getPredictedRotation();
+    float Yaw = fmod(decodeRotation.x, 360.0); // protect a 360 cycle
+    float Pitch = fmod(decodeRotation.y, 360.0);
+    float Roll = fmod(decodeRotation.z, 360.0);
+
+    int numChannelPoints = getFormatChannelCount();
+
+    // a reused result was evaluated at another orientation than the gradient below, always evaluate
+    float reuseThreshold = coeffReuseThreshold;
+    coeffReuseThreshold = 0;
+
+    switch (decodeMode) {
+    case M1DecodeSpatial_4:
+        processSample(&M1DecodeCore::spatialAlgo_4, Yaw, Pitch, Roll, result);
+        break;
+
+    case M1DecodeSpatial_8:
+        processSample(&M1DecodeCore::spatialAlgo_8, Yaw, Pitch, Roll, result);
+        break;
+
+    case M1DecodeSpatial_14:
+        processSample(&M1DecodeCore::spatialAlgo_14, Yaw, Pitch, Roll, result);
+        break;
+
+    default:
+        numChannelPoints = 0;
+        break;
+    }
+
+    coeffReuseThreshold = reuseThreshold;
+
+    // current angles now hold the filtered orientation the coefficients were evaluated for
+    if (numChannelPoints > 0) {
+        storeCachedCoeffs(numChannelPoints, currentYaw, currentPitch, currentRoll, result);
+        spatialMultichannelGradient(spatialChannelPoints, numChannelPoints, currentYaw, currentPitch, currentRoll, gradient);
+    }
+
+    timeLastCalculation = getCurrentTime() - tStart;
+}
+
+void M1DecodeCore::transcodeReducedCoeffs(Mach1DecodeMode reducedMode, Mach1DecodeMode mode, const float *reduced, float *result) {
+    // corners of the Spatial_8 cube on the same side as each Spatial_14 mid point: front, right, back, left, top, bottom
+    static const int midPointCorners[6][4] = {
+        {0, 1, 4, 5},
+        {1, 3, 5, 7},
+        {2, 3, 6, 7},
+        {0, 2, 4, 6},
+        {0, 1, 2, 3},
+        {4, 5, 6, 7},
+    };
+
+    int reducedChannels = (reducedMode == M1DecodeSpatial_4) ? 4 : 8;
+    int channels = (mode == M1DecodeSpatial_8) ? 8 : 14;
+
+    // Spatial_4 holds the upper corners, each lower corner plays through the one above it
+    float corners[8 * 2];
+    for (int i = 0; i < 8; i++) {
+        corners[i * 2 + 0] = reduced[(i % reducedChannels) * 2 + 0];
+        corners[i * 2 + 1] = reduced[(i % reducedChannels) * 2 + 1];
+    }
+
+    for (int i = 0; i < 8 * 2; i++) {
+        result[i] = corners[i];
+    }
+    for (int i = 0; i < channels - 8; i++) {
+        float l = 0;
+        float r = 0;
+        for (int j = 0; j < 4; j++) {
+            l += corners[midPointCorners[i][j] * 2 + 0];
+            r += corners[midPointCorners[i][j] * 2 + 1];
+        }
+        result[(8 + i) * 2 + 0] = 0.25f * l;
+        result[(8 + i) * 2 + 1] = 0.25f * r;
+    }
+
+    // keep each ear's total gain that of the reduced decode, the folded channels would otherwise add level
+    for (int ear = 0; ear < 2; ear++) {
+        float reducedSum = 0;
+        float sum = 0;
+        for (int i = 0; i < reducedChannels; i++) {
+            reducedSum += reduced[i * 2 + ear];
+        }
+        for (int i = 0; i < channels; i++) {
+            sum += result[i * 2 + ear];
+        }
+        if (sum > 0) {
+            for (int i = 0; i < channels; i++) {
+                result[i * 2 + ear] *= reducedSum / sum;
+            }
+        }
+    }
+}
+
+void M1DecodeCore::decodePannedCoeffs(float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
+    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
+
+    bool panLaw = applyPanLaw;
+
+    for (int i = 0; i < (coeffs.size() - 2) / 2; i++) {
+        float l = coeffs[i * 2];
+        float r = coeffs[i * 2 + 1];
+        float gain = 0.0;
+        float pan = 0.0;
+
+        if (l > r) {
+            pan = -(1 - r / l);
+            if (panLaw) {
+                gain = l * (sqrt(2) / 2);
+            } else {
+                gain = l;
+            }
+        } else {
+            pan = (1 - l / r);
+            if (panLaw) {
+                gain = r * (sqrt(2) / 2);
+            } else {
+                gain = r;
+            }
+        }
+        // if gain is 0 reset pan
+        if (gain == 0) {
+            pan = 0;
+        }
+        // if pan is NaN reset pan
+        if (std::isnan(pan)) {
+            pan = 0.0;
+        }
+        result[i * 2] = gain;
+        result[i * 2 + 1] = pan;
+    }
+}
+
+void M1DecodeCore::decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex) {
+    std::vector<float> coeffs = decodeCoeffs(bufferSize, sampleIndex);
+
+    int inChans = channels;
+    int outChans = getFormatCoeffCount();
+    int outStereoDecodeChans = 2;
+
+    for (int i = 0; i < inChans; i++) {
+        for (int j = 0; j < outStereoDecodeChans; j++) {
+            result[i * outStereoDecodeChans + j] = 0;
+            for (int k = 0; k < outChans; k++) {
+                result[i * outStereoDecodeChans + j] += matrix[k * inChans + i] * coeffs[k * outStereoDecodeChans + j];
+            }
+        }
+    }
+}
+
+void M1DecodeCore::processSample(processSampleForMultichannelPtr _processSampleForMultichannelPtr, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
+    convertAnglesToMach1(platformType, &Yaw, &Pitch, &Roll);
+    lockAngles(Pitch, Roll);
+    
+    targetYaw = Yaw;
+    targetPitch = Pitch;
+    targetRoll = Roll;
+
+    if (bufferSize > 0) {
+        // we're in per sample mode
+        // returning values from right here!
+
+        std::vector<float> gainsL(getFormatCoeffCount());
+        std::vector<float> gainsR(getFormatCoeffCount());
+        (this->*_processSampleForMultichannelPtr)(currentYaw, currentPitch, currentRoll, gainsL.data());
+        (this->*_processSampleForMultichannelPtr)(currentYaw, currentPitch, currentRoll, gainsR.data());
+        float phase = (float)sampleIndex / (float)bufferSize;
+
+        std::vector<float> gains_lerp(getFormatCoeffCount());
+        for (int i = 0; i < gains_lerp.size(); i++) {
+            gains_lerp[i] = gainsL[i] * (1 - phase) + gainsR[i] * phase;
+            result[i] = gains_lerp[i];
+        }
+        return;
+    } else {
+        // Filtering per-buffer
+        if (filterBank != nullptr) { // filtered for this frame in Mach1DecodeFilterBank::update()
+            filterBank->getCurrentAngles(filterBankLane, currentYaw, currentPitch, currentRoll);
+
+            Yaw = currentYaw;
+            Pitch = currentPitch;
+            Roll = currentRoll;
+        } else if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
+            targetYaw = Yaw;
+            targetPitch = Pitch;
+            targetRoll = Roll;
+
+            updateAngles();
+
+            Yaw = currentYaw;
+            Pitch = currentPitch;
+            Roll = currentRoll;
+        } else {
+            targetYaw = Yaw;
+            targetPitch = Pitch;
+            targetRoll = Roll;
+
+            currentYaw = Yaw;
+            currentPitch = Pitch;
+            currentRoll = Roll;
+
+            previousYaw = currentYaw;
+            previousPitch = currentPitch;
+            previousRoll = currentRoll;
+        }
+    }
+
+    // printf("%f, %f, %f\r\n", Yaw, Pitch, Roll);
+
+    (this->*_processSampleForMultichannelPtr)(Yaw, Pitch, Roll, result);
+}
+
+std::vector<float> M1DecodeCore::processSample(processSampleForMultichannel _processSampleForMultichannel, float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
+    convertAnglesToMach1(platformType, &Yaw, &Pitch, &Roll);
+    lockAngles(Pitch, Roll);
+    
+    targetYaw = Yaw;
+    targetPitch = Pitch;
+    targetRoll = Roll;
+
+    if (bufferSize > 0) {
+        // we're in per sample mode
+        // returning values from right here!
+        std::vector<float> gainsL = (this->*_processSampleForMultichannel)(currentYaw, currentPitch, currentRoll);
+        std::vector<float> gainsR = (this->*_processSampleForMultichannel)(currentYaw, currentPitch, currentRoll);
+        float phase = (float)sampleIndex / (float)bufferSize;
+        std::vector<float> gains_lerp;
+        gains_lerp.resize(gainsL.size());
+        for (int i = 0; i < gainsL.size(); i++) {
+            gains_lerp[i] = gainsL[i] * (1 - phase) + gainsR[i] * phase;
+        }
+        return gains_lerp;
+    } else {
+        // Filtering per-buffer
+        if (filterBank != nullptr) { // filtered for this frame in Mach1DecodeFilterBank::update()
+            filterBank->getCurrentAngles(filterBankLane, currentYaw, currentPitch, currentRoll);
+
+            Yaw = currentYaw;
+            Pitch = currentPitch;
+            Roll = currentRoll;
+        } else if (filterSpeed <= 1.0f && filterSpeed > 0.0f) { // filter and lerp the input angles for smoothing
+            targetYaw = Yaw;
+            targetPitch = Pitch;
+            targetRoll = Roll;
+
+            updateAngles();
+
+            Yaw = currentYaw;
+            Pitch = currentPitch;
+            Roll = currentRoll;
+        } else {
+            targetYaw = Yaw;
+            targetPitch = Pitch;
+            targetRoll = Roll;
+
+            currentYaw = Yaw;
+            currentPitch = Pitch;
+            currentRoll = Roll;
+
+            previousYaw = currentYaw;
+            previousPitch = currentPitch;
+            previousRoll = currentRoll;
+        }
+    }
+    return (this->*_processSampleForMultichannel)(Yaw, Pitch, Roll);
+}
+
+M1_DETERMINISTIC_FP_END
@@ -0,0 +1,189 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+#include "Mach1DecodeFilterBank.h"
+#include "Mach1DecodeCore.h"
+#include "Mach1Float4.h"
+
+#include <algorithm>
+
+// Matches fmod(a, 360) for |a| < 2^31 * 360: a - 360 * trunc(a / 360) is exact once the quotient is
+// right, and a / 360 can only round up across an integer, which leaves the remainder on the wrong side of 0
+static inline Mach1Float4 fmod360(Mach1Float4 a) {
+    const Mach1Float4 zero = m1Set4(0);
+    const Mach1Float4 full = m1Set4(360);
+
+    Mach1Float4 r = m1Sub4(a, m1Mul4(m1Trunc4(m1Div4(a, full)), full));
+    r = m1Select4(m1And4(m1CmpGt4(a, zero), m1CmpLt4(r, zero)), m1Add4(r, full), r);
+    r = m1Select4(m1And4(m1CmpLt4(a, zero), m1CmpGt4(r, zero)), m1Sub4(r, full), r);
+    return r;
+}
+
+// M1DecodeCore::radialDistance(target, current)
+static inline Mach1Float4 radialDistance4(Mach1Float4 target, Mach1Float4 current) {
+    Mach1Float4 direct = m1Abs4(m1Sub4(current, target));
+    Mach1Float4 wrapped = m1Abs4(m1Sub4(direct, m1Set4(360)));
+    return m1Select4(m1CmpGt4(direct, wrapped), wrapped, direct);
+}
+
+// M1DecodeCore::targetDirectionMultiplier(current, target)
+static inline Mach1Float4 targetDirection4(Mach1Float4 current, Mach1Float4 target) {
+    const Mach1Float4 zero = m1Set4(0);
+    const Mach1Float4 full = m1Set4(360);
+
+    Mach1Float4 difference = m1Sub4(current, target);
+    Mach1Float4 direct = m1Abs4(difference);
+    Mach1Float4 wraps = m1Or4(m1CmpGt4(direct, m1Abs4(m1Add4(difference, full))), m1CmpGt4(direct, m1Abs4(m1Sub4(difference, full))));
+
+    Mach1Float4 toward = m1Select4(m1CmpLt4(current, target), m1Set4(1), m1Select4(m1CmpGt4(current, target), m1Set4(-1), zero));
+    return m1Select4(wraps, m1Sub4(zero, toward), toward);
+}
+
+void Mach1DecodeFilterBank::resizeLanes(int count) {
+    int padded = (count + 3) & ~3;
+
+    targetYaw.resize(padded, 0);
+    targetPitch.resize(padded, 0);
+    targetRoll.resize(padded, 0);
+    currentYaw.resize(padded, 0);
+    currentPitch.resize(padded, 0);
+    currentRoll.resize(padded, 0);
+    filterSpeed.resize(padded, 0);
+    speedAngle.resize(padded, 0);
+    timeLastUpdate.resize(padded, 0);
+}
+
+int Mach1DecodeFilterBank::add(M1DecodeCore *decoder) {
+    int lane = (int)decoders.size();
+    decoders.push_back(decoder);
+    resizeLanes(lane + 1);
+
+    Mach1Point3D current = decoder->getCurrentAngle();
+    targetYaw[lane] = currentYaw[lane] = current.x;
+    targetPitch[lane] = currentPitch[lane] = current.y;
+    targetRoll[lane] = currentRoll[lane] = current.z;
+    filterSpeed[lane] = decoder->filterSpeed;
+    speedAngle[lane] = 0;
+    timeLastUpdate[lane] = 0;
+
+    decoder->setFilterBank(this, lane);
+    return lane;
+}
+
+void Mach1DecodeFilterBank::remove(M1DecodeCore *decoder) {
+    std::vector<M1DecodeCore *>::iterator it = std::find(decoders.begin(), decoders.end(), decoder);
+    if (it == decoders.end())
+        return;
+
+    int lane = (int)(it - decoders.begin());
+    int last = (int)decoders.size() - 1;
+
+    decoder->setFilterBank(nullptr, -1);
+
+    if (lane != last) {
+        decoders[lane] = decoders[last];
+        targetYaw[lane] = targetYaw[last];
+        targetPitch[lane] = targetPitch[last];
+        targetRoll[lane] = targetRoll[last];
+        currentYaw[lane] = currentYaw[last];
+        currentPitch[lane] = currentPitch[last];
+        currentRoll[lane] = currentRoll[last];
+        filterSpeed[lane] = filterSpeed[last];
+        speedAngle[lane] = speedAngle[last];
+        timeLastUpdate[lane] = timeLastUpdate[last];
+
+        decoders[lane]->setFilterBank(this, lane);
+    }
+
+    decoders.pop_back();
+
+    // keep the padding lanes inert
+    int padded = (int)targetYaw.size();
+    for (int i = last; i < padded; i++) {
+        targetYaw[i] = targetPitch[i] = targetRoll[i] = 0;
+        currentYaw[i] = currentPitch[i] = currentRoll[i] = 0;
+        filterSpeed[i] = speedAngle[i] = 0;
+        timeLastUpdate[i] = 0;
+    }
+}
+
+void Mach1DecodeFilterBank::clear() {
+    for (size_t i = 0; i < decoders.size(); i++) {
+        decoders[i]->setFilterBank(nullptr, -1);
+    }
+    decoders.clear();
+    resizeLanes(0);
+}
+
+void Mach1DecodeFilterBank::update(long currentTimeMilliseconds) {
+    int count = (int)decoders.size();
+
+    // gather targets, the only per-decoder work left; the elapsed time only advances on filtering lanes
+    for (int i = 0; i < count; i++) {
+        Mach1Point3D target = decoders[i]->getFilterTarget();
+        targetYaw[i] = target.x;
+        targetPitch[i] = target.y;
+        targetRoll[i] = target.z;
+
+        float speed = decoders[i]->filterSpeed;
+        bool filtering = speed > 0.0f && speed < 1.0f;
+        filterSpeed[i] = speed;
+        speedAngle[i] = (filtering && timeLastUpdate[i]) ? speed * 1.0f * (currentTimeMilliseconds - timeLastUpdate[i]) : 0;
+        if (filtering)
+            timeLastUpdate[i] = currentTimeMilliseconds;
+    }
+
+    const Mach1Float4 zero = m1Set4(0);
+    const Mach1Float4 one = m1Set4(1);
+    const Mach1Float4 full = m1Set4(360);
+
+    for (int i = 0; i < count; i += 4) {
+        Mach1Float4 speed = m1Load4(&speedAngle[i]);
+        Mach1Float4 filterSpeed4 = m1Load4(&filterSpeed[i]);
+
+        Mach1Float4 rawYaw = m1Load4(&targetYaw[i]);
+        Mach1Float4 rawPitch = m1Load4(&targetPitch[i]);
+        Mach1Float4 rawRoll = m1Load4(&targetRoll[i]);
+
+        Mach1Float4 tYaw = fmod360(rawYaw);
+        Mach1Float4 tPitch = fmod360(rawPitch);
+        Mach1Float4 tRoll = fmod360(rawRoll);
+        Mach1Float4 cYaw = fmod360(m1Load4(&currentYaw[i]));
+        Mach1Float4 cPitch = fmod360(m1Load4(&currentPitch[i]));
+        Mach1Float4 cRoll = fmod360(m1Load4(&currentRoll[i]));
+
+        Mach1Float4 distanceYaw = radialDistance4(tYaw, cYaw);
+        Mach1Float4 distancePitch = radialDistance4(tPitch, cPitch);
+        Mach1Float4 distanceRoll = radialDistance4(tRoll, cRoll);
+        Mach1Float4 near = m1CmpLt4(m1Add4(m1Add4(distanceYaw, distancePitch), distanceRoll), full);
+
+        // step toward the target unless within one step of it or the total distance wraps
+        Mach1Float4 stepYaw = m1Select4(m1And4(m1CmpGt4(distanceYaw, speed), near), m1Add4(cYaw, m1Mul4(speed, targetDirection4(cYaw, tYaw))), tYaw);
+        Mach1Float4 stepPitch = m1Select4(m1And4(m1CmpGt4(distancePitch, speed), near), m1Add4(cPitch, m1Mul4(speed, targetDirection4(cPitch, tPitch))), tPitch);
+        Mach1Float4 stepRoll = m1Select4(m1And4(m1CmpGt4(distanceRoll, speed), near), m1Add4(cRoll, m1Mul4(speed, targetDirection4(cRoll, tRoll))), tRoll);
+
+        // speeds in (0, 1) filter, 1 snaps to the wrapped target, anything else bypasses the filter
+        Mach1Float4 updating = m1And4(m1CmpGt4(filterSpeed4, zero), m1CmpLe4(filterSpeed4, one));
+        Mach1Float4 filtering = m1And4(updating, m1CmpLt4(filterSpeed4, one));
+
+        m1Store4(&currentYaw[i], m1Select4(filtering, stepYaw, m1Select4(updating, tYaw, rawYaw)));
+        m1Store4(&currentPitch[i], m1Select4(filtering, stepPitch, m1Select4(updating, tPitch, rawPitch)));
+        m1Store4(&currentRoll[i], m1Select4(filtering, stepRoll, m1Select4(updating, tRoll, rawRoll)));
+    }
+}
+
+void Mach1DecodeFilterBank::getCurrentAngles(int lane, float &Yaw, float &Pitch, float &Roll) const {
+    Yaw = currentYaw[lane];
+    Pitch = currentPitch[lane];
+    Roll = currentRoll[lane];
+}
+
+int Mach1DecodeFilterBank::getCount() const {
+    return (int)decoders.size();
+}
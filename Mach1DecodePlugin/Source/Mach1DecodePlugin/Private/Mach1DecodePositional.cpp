@@ -1,223 +1,347 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#include "Mach1DecodePositional.h"
-
-#ifndef DEG_TO_RAD
-#    define DEG_TO_RAD (PI / 180.0)
-#endif
-
-#ifndef __FLT_EPSILON__
-#    define __FLT_EPSILON__ 1.19209290e-07F
-#endif
-
-Mach1DecodePositional::Mach1DecodePositional() {
-    M1obj = Mach1DecodePositionalCAPI_create();
-}
-
-Mach1DecodePositional::~Mach1DecodePositional() {
-    Mach1DecodePositionalCAPI_delete(M1obj);
-}
-
-void Mach1DecodePositional::setPlatformType(Mach1PlatformType type) {
-    Mach1DecodePositionalCAPI_setPlatformType(M1obj, type);
-    /// Set the device's angle order and convention if applicable
-    ///
-    /// - Parameters:
-    ///     - Mach1PlatformDefault
-    ///     - Mach1PlatformUnity
-    ///     - Mach1PlatformUE
-    ///     - Mach1PlatformOfEasyCam
-    ///     - Mach1PlatformAndroid
-    ///     - Mach1PlatformiOS
-    ///     - Mach1PlatformiOSTableTop_ZVertical
-    ///     - Mach1PlatformiOSPortraitHandheld_YVertical
-    ///     - Mach1PlatformiOSPortrait_YawOnly
-}
-
-void Mach1DecodePositional::setDecodeMode(Mach1DecodeMode mode) {
-    Mach1DecodePositionalCAPI_setDecodeMode(M1obj, mode);
-    /// Set the decoding algorithm
-    ///
-    /// - Parameters:
-    ///     - M1Spatial_4 (default spatial | 8 channels)
-    ///     - M1Spatial_8 (compass / yaw | 4 channels)
-    ///     - M1Spatial_14 (higher order spatial | 14 channels)
-}
-
-void Mach1DecodePositional::setMuteWhenOutsideObject(bool muteWhenOutsideObject) {
-    Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(M1obj, muteWhenOutsideObject);
-    /// Mute mach1decode object (all coefficifient results becomes 0)
-    /// when outside the positional reference shape/point
-}
-
-void Mach1DecodePositional::setMuteWhenInsideObject(bool muteWhenInsideObject) {
-    Mach1DecodePositionalCAPI_setMuteWhenInsideObject(M1obj, muteWhenInsideObject);
-    /// Mute mach1decode object (all coefficifient results becomes 0)
-    /// when inside the positional reference shape/point
-}
-
-void Mach1DecodePositional::setUseAttenuation(bool useAttenuation) {
-    Mach1DecodePositionalCAPI_setUseAttenuation(M1obj, useAttenuation);
-    /// Set distance attenuation calculations on that mach1decode object on/off
-    ///
-    /// - Remark: When off, distance remains 1.0
-}
-
-void Mach1DecodePositional::setAttenuationCurve(float attenuationCurve) {
-    Mach1DecodePositionalCAPI_setAttenuationCurve(M1obj, attenuationCurve);
-    /// Set the current normalized distance per update for attenuation coefficient
-    ///
-    /// - Parameters:
-    ///     - Normalized range: 0.0 -> 1.0
-}
-
-void Mach1DecodePositional::setUsePlaneCalculation(bool usePlaneCalculation) {
-    Mach1DecodePositionalCAPI_setUsePlaneCalculation(M1obj, usePlaneCalculation);
-    /// Calculate the rotation to the decode object from it's center point
-    /// or from the closest point to the object on a plane
-    ///
-    /// - Parameters:
-    ///     - True: Closest point of plane of object for calculations of rotation
-    ///     - False (default): center point of object for calculations of rotation
-}
-
-void Mach1DecodePositional::setUseYawForRotation(bool useYawForRotation) {
-    Mach1DecodePositionalCAPI_setUseYawForRotation(M1obj, useYawForRotation);
-    /// Set use/ignore Yaw angle rotation results from pivoting positionally
-    ///
-    /// - Remark: Default is true
-}
-
-void Mach1DecodePositional::setUsePitchForRotation(bool usePitchForRotation) {
-    Mach1DecodePositionalCAPI_setUsePitchForRotation(M1obj, usePitchForRotation);
-    /// Set use/ignore Pitch angle rotation results from pivoting positionally
-    ///
-    /// - Remark: Default is true
-}
-
-void Mach1DecodePositional::setUseRollForRotation(bool useRollForRotation) {
-    Mach1DecodePositionalCAPI_setUseRollForRotation(M1obj, useRollForRotation);
-    /// Set use/ignore Roll angle rotation results from pivoting positionally
-    ///
-    /// - Remark: Default is true
-}
-
-void Mach1DecodePositional::setListenerPosition(Mach1Point3D point) {
-    Mach1DecodePositionalCAPI_setListenerPosition(M1obj, point);
-    /// Sets the device/camera's position in desired x,y,z space
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Position: x,y,z
-}
-
-void Mach1DecodePositional::setListenerRotation(Mach1Point3D point) {
-    Mach1DecodePositionalCAPI_setListenerRotation(M1obj, point);
-    /// Sets the device/camera's orientation with Euler angles
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Rotation: yaw,pitch,roll
-}
-
-void Mach1DecodePositional::setListenerRotationQuat(Mach1Point4D quat) {
-    Mach1DecodePositionalCAPI_setListenerRotationQuat(M1obj, quat);
-    /// Sets the device/camera's orientation with Quaternion
-    ///
-    /// - Parameters:
-    ///     - Mach1Point4D Rotation: Quaternion
-}
-
-void Mach1DecodePositional::setDecoderAlgoPosition(Mach1Point3D point) {
-    Mach1DecodePositionalCAPI_setDecoderAlgoPosition(M1obj, point);
-    /// Sets the decode object's position in desired x,y,z space
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Rotation: x,y,z
-}
-
-void Mach1DecodePositional::setDecoderAlgoRotation(Mach1Point3D point) {
-    Mach1DecodePositionalCAPI_setDecoderAlgoRotation(M1obj, point);
-    /// Sets the decode object's orientation with Euler angles
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Rotation: yaw,pitch,roll
-}
-
-void Mach1DecodePositional::setDecoderAlgoRotationQuat(Mach1Point4D quat) {
-    Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(M1obj, quat);
-    /// Sets the decode object's position in desired x,y,z space
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Rotation: x,y,z
-}
-
-void Mach1DecodePositional::setDecoderAlgoScale(Mach1Point3D point) {
-    Mach1DecodePositionalCAPI_setDecoderAlgoScale(M1obj, point);
-    /// Sets the decode object's scale in desired x,y,z space
-    ///
-    /// - Parameters:
-    ///     - Mach1Point3D Scale: x,y,z multiplier
-}
-
-void Mach1DecodePositional::evaluatePositionResults() {
-    Mach1DecodePositionalCAPI_evaluatePositionResults(M1obj);
-}
-
-#ifndef __EMSCRIPTEN__
-void Mach1DecodePositional::getCoefficients(float *result) {
-    Mach1DecodePositionalCAPI_getCoefficients(M1obj, result);
-    /// Return the current coefficients to be applied to the audioplayer's volume
-    ///
-    /// - Remark: Result is returned back as the argument, an array of 18 floats is required as an input
-}
-#endif
-
-void Mach1DecodePositional::getCoefficients(std::vector<float> &result) {
-    Mach1DecodePositionalCAPI_getCoefficients(M1obj, result.data());
-    /// Return the current coefficients to be applied to the audioplayer's volume
-    ///
-    /// - Remark: Result is returned back as the argument, an array of 18 floats is required as an input
-}
-
-float Mach1DecodePositional::getDist() {
-    return Mach1DecodePositionalCAPI_getDist(M1obj);
-    /// Return a distance calculation of the position of the device/camera
-    /// to the position of the m1obj
-}
-
-int Mach1DecodePositional::getFormatChannelCount() {
-    return Mach1DecodePositionalCAPI_getFormatChannelCount(M1obj);
-}
-
-int Mach1DecodePositional::getFormatCoeffCount() {
-    return Mach1DecodePositionalCAPI_getFormatCoeffCount(M1obj);
-}
-
-Mach1Point3D Mach1DecodePositional::getCurrentAngle() {
-    return Mach1DecodePositionalCAPI_getCurrentAngle(M1obj);
-    /// Return the current orientation angle of the m1obj
-}
-
-Mach1Point3D Mach1DecodePositional::getCurrentAngleInternal() {
-    return Mach1DecodePositionalCAPI_getCurrentAngleInternal(M1obj);
-    /// Returns the current angle before any platform corrections have been made
-    /// intended for debug purposes only
-}
-
-Mach1Point3D Mach1DecodePositional::getPositionalRotation() {
-    return Mach1DecodePositionalCAPI_getPositionalRotation(M1obj);
-}
-
-void Mach1DecodePositional::setFilterSpeed(float filterSpeed) {
-    Mach1DecodePositionalCAPI_setFilterSpeed(M1obj, filterSpeed);
-    /// Filter speed determines the amount of angle smoothing applied
-    /// to the orientation angles used for the Mach1DecodeCore class
-    ///
-    /// - Parameters:
-    ///     - value range: 0.0001 -> 1.0 (where 0.1 would be a slow filter
-    ///     and 1.0 is no filter)
-}
-
-Mach1Point3D Mach1DecodePositional::getClosestPointOnPlane() {
-    return Mach1DecodePositionalCAPI_getClosestPointOnPlane(M1obj);
-}
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#include "Mach1DecodePositional.h"
+#include <algorithm>
+
+#ifndef DEG_TO_RAD
+#    define DEG_TO_RAD (PI / 180.0)
+#endif
+
+#ifndef __FLT_EPSILON__
+#    define __FLT_EPSILON__ 1.19209290e-07F
+#endif
+
+Mach1DecodePositional::Mach1DecodePositional() {
+    M1obj = Mach1DecodePositionalCAPI_create();
+    M1pool = nullptr;
+    M1poolIndex = -1;
+}
+
+Mach1DecodePositional::Mach1DecodePositional(void *pool) {
+    M1pool = pool;
+    M1poolIndex = Mach1DecodePositionalCAPI_poolAcquire(M1pool);
+    M1obj = Mach1DecodePositionalCAPI_poolGet(M1pool, M1poolIndex);
+
+    if (M1obj == nullptr) {
+        // pool is exhausted, fall back to a regular allocation
+        M1pool = nullptr;
+        M1poolIndex = -1;
+        M1obj = Mach1DecodePositionalCAPI_create();
+    }
+    /// Acquire the decoder from a pool created with Mach1DecodePositionalCAPI_createPool
+    /// instead of allocating it, the slot is returned to the pool on destruction
+    ///
+    /// - Remark: The pool must outlive this object
+}
+
+Mach1DecodePositional::~Mach1DecodePositional() {
+    if (M1pool != nullptr) {
+        Mach1DecodePositionalCAPI_poolRelease(M1pool, M1poolIndex);
+    } else {
+        Mach1DecodePositionalCAPI_delete(M1obj);
+    }
+}
+
+void Mach1DecodePositional::setPlatformType(Mach1PlatformType type) {
+    Mach1DecodePositionalCAPI_setPlatformType(M1obj, type);
+    /// Set the device's angle order and convention if applicable
+    ///
+    /// - Parameters:
+    ///     - Mach1PlatformDefault
+    ///     - Mach1PlatformUnity
+    ///     - Mach1PlatformUE
+    ///     - Mach1PlatformOfEasyCam
+    ///     - Mach1PlatformAndroid
+    ///     - Mach1PlatformiOS
+    ///     - Mach1PlatformiOSTableTop_ZVertical
+    ///     - Mach1PlatformiOSPortraitHandheld_YVertical
+    ///     - Mach1PlatformiOSPortrait_YawOnly
+}
+
+void Mach1DecodePositional::setDecodeMode(Mach1DecodeMode mode) {
+    Mach1DecodePositionalCAPI_setDecodeMode(M1obj, mode);
+    /// Set the decoding algorithm
+    ///
+    /// - Parameters:
+    ///     - M1Spatial_4 (default spatial | 8 channels)
+    ///     - M1Spatial_8 (compass / yaw | 4 channels)
+    ///     - M1Spatial_14 (higher order spatial | 14 channels)
+}
+
+void Mach1DecodePositional::setReducedDecodeMode(Mach1DecodeMode mode) {
+    Mach1DecodePositionalCAPI_setReducedDecodeMode(M1obj, mode);
+    /// Evaluate a cheaper decoding algorithm and transcode its coefficients to the channels of the decoding mode
+    ///
+    /// - Parameters:
+    ///     - mode: lower than the decoding mode to take effect, M1Spatial_14 to disable
+}
+
+void Mach1DecodePositional::setMuteWhenOutsideObject(bool muteWhenOutsideObject) {
+    Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(M1obj, muteWhenOutsideObject);
+    /// Mute mach1decode object (all coefficifient results becomes 0)
+    /// when outside the positional reference shape/point
+}
+
+void Mach1DecodePositional::setMuteWhenInsideObject(bool muteWhenInsideObject) {
+    Mach1DecodePositionalCAPI_setMuteWhenInsideObject(M1obj, muteWhenInsideObject);
+    /// Mute mach1decode object (all coefficifient results becomes 0)
+    /// when inside the positional reference shape/point
+}
+
+void Mach1DecodePositional::setUseAttenuation(bool useAttenuation) {
+    Mach1DecodePositionalCAPI_setUseAttenuation(M1obj, useAttenuation);
+    /// Set distance attenuation calculations on that mach1decode object on/off
+    ///
+    /// - Remark: When off, distance remains 1.0
+}
+
+void Mach1DecodePositional::setAttenuationCurve(float attenuationCurve) {
+    Mach1DecodePositionalCAPI_setAttenuationCurve(M1obj, attenuationCurve);
+    /// Set the current normalized distance per update for attenuation coefficient
+    ///
+    /// - Parameters:
+    ///     - Normalized range: 0.0 -> 1.0
+}
+
+void Mach1DecodePositional::setAttenuationModel(Mach1AttenuationModel model) {
+    Mach1DecodePositionalCAPI_setAttenuationModel(M1obj, model);
+    /// Set the distance model evaluated inside evaluatePositionResults()
+    ///
+    /// - Parameters:
+    ///     - Mach1AttenuationCurve (default): use the value from setAttenuationCurve
+    ///     - Mach1AttenuationInverse: minDistance / (minDistance + rolloff * (distance - minDistance))
+    ///     - Mach1AttenuationLinear: 1 - rolloff * (distance - minDistance) / (maxDistance - minDistance)
+    ///     - Mach1AttenuationExponential: (distance / minDistance) ^ -rolloff
+    ///     - Mach1AttenuationTable: lookup into the table set with setAttenuationTable
+}
+
+void Mach1DecodePositional::setAttenuationRange(float minDistance, float maxDistance) {
+    Mach1DecodePositionalCAPI_setAttenuationRange(M1obj, minDistance, maxDistance);
+    /// Set the distance range of the inverse, linear and exponential models
+    ///
+    /// - Remark: Distances are clamped to this range before evaluation
+}
+
+void Mach1DecodePositional::setAttenuationRolloff(float rolloff) {
+    Mach1DecodePositionalCAPI_setAttenuationRolloff(M1obj, rolloff);
+    /// Set the rolloff factor of the inverse, linear and exponential models
+    ///
+    /// - Remark: Default is 1.0
+}
+
+bool Mach1DecodePositional::setAttenuationTable(const std::vector<float> &distances, const std::vector<float> &gains) {
+    return Mach1DecodePositionalCAPI_setAttenuationTable(M1obj, (float *)distances.data(), (float *)gains.data(), (int)(std::min)(distances.size(), gains.size()));
+    /// Set a piecewise linear distance -> gain curve, baked into a lookup table
+    ///
+    /// - Parameters:
+    ///     - distances: strictly increasing distances of the curve points
+    ///     - gains: gain at each distance
+    ///
+    /// - Returns: false if the points are empty or not strictly increasing, the previous table is kept
+}
+
+float Mach1DecodePositional::getAttenuationGain() {
+    return Mach1DecodePositionalCAPI_getAttenuationGain(M1obj);
+    /// Return the attenuation gain applied by the last evaluatePositionResults()
+}
+
+void Mach1DecodePositional::setOcclusionGain(float occlusionGain) {
+    Mach1DecodePositionalCAPI_setOcclusionGain(M1obj, occlusionGain);
+    /// Set the transmission factor through occluders between listener and decoder
+    ///
+    /// - Remark: Multiplied into the gain by the next evaluatePositionResults(), 1.0 is unoccluded
+}
+
+float Mach1DecodePositional::getOcclusionGain() {
+    return Mach1DecodePositionalCAPI_getOcclusionGain(M1obj);
+    /// Return the occlusion factor currently applied to the gain
+}
+
+void Mach1DecodePositional::setUsePlaneCalculation(bool usePlaneCalculation) {
+    Mach1DecodePositionalCAPI_setUsePlaneCalculation(M1obj, usePlaneCalculation);
+    /// Calculate the rotation to the decode object from it's center point
+    /// or from the closest point to the object on a plane
+    ///
+    /// - Parameters:
+    ///     - True: Closest point of plane of object for calculations of rotation
+    ///     - False (default): center point of object for calculations of rotation
+}
+
+void Mach1DecodePositional::setUseYawForRotation(bool useYawForRotation) {
+    Mach1DecodePositionalCAPI_setUseYawForRotation(M1obj, useYawForRotation);
+    /// Set use/ignore Yaw angle rotation results from pivoting positionally
+    ///
+    /// - Remark: Default is true
+}
+
+void Mach1DecodePositional::setUsePitchForRotation(bool usePitchForRotation) {
+    Mach1DecodePositionalCAPI_setUsePitchForRotation(M1obj, usePitchForRotation);
+    /// Set use/ignore Pitch angle rotation results from pivoting positionally
+    ///
+    /// - Remark: Default is true
+}
+
+void Mach1DecodePositional::setUseRollForRotation(bool useRollForRotation) {
+    Mach1DecodePositionalCAPI_setUseRollForRotation(M1obj, useRollForRotation);
+    /// Set use/ignore Roll angle rotation results from pivoting positionally
+    ///
+    /// - Remark: Default is true
+}
+
+void Mach1DecodePositional::setListenerPosition(Mach1Point3D point) {
+    Mach1DecodePositionalCAPI_setListenerPosition(M1obj, point);
+    /// Sets the device/camera's position in desired x,y,z space
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Position: x,y,z
+}
+
+void Mach1DecodePositional::setListenerRotation(Mach1Point3D point) {
+    Mach1DecodePositionalCAPI_setListenerRotation(M1obj, point);
+    /// Sets the device/camera's orientation with Euler angles
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Rotation: yaw,pitch,roll
+}
+
+void Mach1DecodePositional::setListenerRotationQuat(Mach1Point4D quat) {
+    Mach1DecodePositionalCAPI_setListenerRotationQuat(M1obj, quat);
+    /// Sets the device/camera's orientation with Quaternion
+    ///
+    /// - Parameters:
+    ///     - Mach1Point4D Rotation: Quaternion
+}
+
+void Mach1DecodePositional::setDecoderAlgoPosition(Mach1Point3D point) {
+    Mach1DecodePositionalCAPI_setDecoderAlgoPosition(M1obj, point);
+    /// Sets the decode object's position in desired x,y,z space
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Rotation: x,y,z
+}
+
+void Mach1DecodePositional::setDecoderAlgoRotation(Mach1Point3D point) {
+    Mach1DecodePositionalCAPI_setDecoderAlgoRotation(M1obj, point);
+    /// Sets the decode object's orientation with Euler angles
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Rotation: yaw,pitch,roll
+}
+
+void Mach1DecodePositional::setDecoderAlgoRotationQuat(Mach1Point4D quat) {
+    Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(M1obj, quat);
+    /// Sets the decode object's position in desired x,y,z space
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Rotation: x,y,z
+}
+
+void Mach1DecodePositional::setDecoderAlgoScale(Mach1Point3D point) {
+    Mach1DecodePositionalCAPI_setDecoderAlgoScale(M1obj, point);
+    /// Sets the decode object's scale in desired x,y,z space
+    ///
+    /// - Parameters:
+    ///     - Mach1Point3D Scale: x,y,z multiplier
+}
+
+void Mach1DecodePositional::evaluatePositionResults() {
+    Mach1DecodePositionalCAPI_evaluatePositionResults(M1obj);
+}
+
+#ifndef __EMSCRIPTEN__
+void Mach1DecodePositional::getCoefficients(float *result) {
+    Mach1DecodePositionalCAPI_getCoefficients(M1obj, result);
+    /// Return the current coefficients to be applied to the audioplayer's volume
+    ///
+    /// - Remark: Result is returned back as the argument, an array of 18 floats is required as an input
+}
+#endif
+
+void Mach1DecodePositional::getCoefficients(std::vector<float> &result) {
+    Mach1DecodePositionalCAPI_getCoefficients(M1obj, result.data());
+    /// Return the current coefficients to be applied to the audioplayer's volume
+    ///
+    /// - Remark: Result is returned back as the argument, an array of 18 floats is required as an input
+}
+
+float Mach1DecodePositional::getDist() {
+    return Mach1DecodePositionalCAPI_getDist(M1obj);
+    /// Return a distance calculation of the position of the device/camera
+    /// to the position of the m1obj
+}
+
+int Mach1DecodePositional::getFormatChannelCount() {
+    return Mach1DecodePositionalCAPI_getFormatChannelCount(M1obj);
+}
+
+int Mach1DecodePositional::getFormatCoeffCount() {
+    return Mach1DecodePositionalCAPI_getFormatCoeffCount(M1obj);
+}
+
+Mach1Point3D Mach1DecodePositional::getCurrentAngle() {
+    return Mach1DecodePositionalCAPI_getCurrentAngle(M1obj);
+    /// Return the current orientation angle of the m1obj
+}
+
+Mach1Point3D Mach1DecodePositional::getCurrentAngleInternal() {
+    return Mach1DecodePositionalCAPI_getCurrentAngleInternal(M1obj);
+    /// Returns the current angle before any platform corrections have been made
+    /// intended for debug purposes only
+}
+
+Mach1Point3D Mach1DecodePositional::getPositionalRotation() {
+    return Mach1DecodePositionalCAPI_getPositionalRotation(M1obj);
+}
+
+void Mach1DecodePositional::setFilterSpeed(float filterSpeed) {
+    Mach1DecodePositionalCAPI_setFilterSpeed(M1obj, filterSpeed);
+    /// Filter speed determines the amount of angle smoothing applied
+    /// to the orientation angles used for the Mach1DecodeCore class
+    ///
+    /// - Parameters:
+    ///     - value range: 0.0001 -> 1.0 (where 0.1 would be a slow filter
+    ///     and 1.0 is no filter)
+}
+
+void Mach1DecodePositional::setCoeffReuseThreshold(float thresholdDegrees) {
+    Mach1DecodePositionalCAPI_setCoeffReuseThreshold(M1obj, thresholdDegrees);
+    /// Reuse the previous coefficients while the filtered orientation stays
+    /// within the threshold of the one they were computed for
+    ///
+    /// - Parameters:
+    ///     - thresholdDegrees: per axis, 0 disables reuse
+}
+
+float Mach1DecodePositional::getCoeffReuseRate() {
+    return Mach1DecodePositionalCAPI_getCoeffReuseRate(M1obj);
+    /// Return the share of coefficient evaluations answered by reuse, 0 -> 1
+}
+
+void Mach1DecodePositional::setDeterministic(bool enable) {
+    Mach1DecodePositionalCAPI_setDeterministic(M1obj, enable);
+    /// Make the coefficients reproducible across platforms so they can be
+    /// cached, shared or replayed: trig uses the SDK's own polynomials and
+    /// the angle filter only advances with setManualTime (bit identical
+    /// results verified with GCC on x86-64 only)
+    ///
+    /// - Parameters:
+    ///     - enable: false (default) uses the platform math library and clock
+}
+
+bool Mach1DecodePositional::getDeterministic() {
+    return Mach1DecodePositionalCAPI_getDeterministic(M1obj);
+    /// Return whether deterministic decoding is enabled
+}
+
+void Mach1DecodePositional::setManualTime(long milliseconds) {
+    Mach1DecodePositionalCAPI_setManualTime(M1obj, milliseconds);
+    /// Supply the time for the angle filter, e.g. from the audio clock
+    ///
+    /// - Parameters:
+    ///     - milliseconds: current time, must not go backwards
+}
+
+Mach1Point3D Mach1DecodePositional::getClosestPointOnPlane() {
+    return Mach1DecodePositionalCAPI_getClosestPointOnPlane(M1obj);
+}
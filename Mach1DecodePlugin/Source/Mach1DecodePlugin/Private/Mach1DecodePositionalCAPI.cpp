@@ -1,143 +1,235 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#include "Mach1DecodePositionalCAPI.h"
-#include "Mach1DecodePositionalCore.h"
-
-void *Mach1DecodePositionalCAPI_create() {
-    return new Mach1DecodePositionalCore();
-}
-
-void Mach1DecodePositionalCAPI_delete(void *M1obj) {
-    if (M1obj != nullptr) {
-        delete (Mach1DecodePositionalCore *)M1obj;
-        M1obj = nullptr;
-    }
-}
-
-void Mach1DecodePositionalCAPI_setPlatformType(void *M1obj, Mach1PlatformType type) {
-    if (M1obj != nullptr) {
-        ((Mach1DecodePositionalCore *)M1obj)->setPlatformType(type);
-    }
-}
-
-void Mach1DecodePositionalCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
-    if (M1obj != nullptr) {
-        ((Mach1DecodePositionalCore *)M1obj)->setDecodeMode(mode);
-    }
-}
-
-void Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(void *M1obj, bool muteWhenOutsideObject) {
-    ((Mach1DecodePositionalCore *)M1obj)->setMuteWhenOutsideObject(muteWhenOutsideObject);
-}
-
-void Mach1DecodePositionalCAPI_setMuteWhenInsideObject(void *M1obj, bool muteWhenInsideObject) {
-    ((Mach1DecodePositionalCore *)M1obj)->setMuteWhenInsideObject(muteWhenInsideObject);
-}
-
-void Mach1DecodePositionalCAPI_setUseAttenuation(void *M1obj, bool useAttenuation) {
-    ((Mach1DecodePositionalCore *)M1obj)->setUseAttenuation(useAttenuation);
-}
-
-void Mach1DecodePositionalCAPI_setAttenuationCurve(void *M1obj, float attenuationCurve) {
-    ((Mach1DecodePositionalCore *)M1obj)->setAttenuationCurve(attenuationCurve);
-}
-
-void Mach1DecodePositionalCAPI_setUsePlaneCalculation(void *M1obj, bool usePlaneCalculation) {
-    ((Mach1DecodePositionalCore *)M1obj)->setUsePlaneCalculation(usePlaneCalculation);
-}
-
-void Mach1DecodePositionalCAPI_setUseYawForRotation(void *M1obj, bool useYawForRotation) {
-    ((Mach1DecodePositionalCore *)M1obj)->setUseYawForRotation(useYawForRotation);
-}
-
-void Mach1DecodePositionalCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation) {
-    ((Mach1DecodePositionalCore *)M1obj)->setUsePitchForRotation(usePitchForRotation);
-}
-
-void Mach1DecodePositionalCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation) {
-    ((Mach1DecodePositionalCore *)M1obj)->setUseRollForRotation(useRollForRotation);
-}
-
-void Mach1DecodePositionalCAPI_setListenerPosition(void *M1obj, Mach1Point3D point) {
-    Mach1Point3D pnt{point.x, point.y, point.z};
-    ((Mach1DecodePositionalCore *)M1obj)->setListenerPosition(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setListenerRotation(void *M1obj, Mach1Point3D point) {
-    Mach1Point3D pnt{point.x, point.y, point.z};
-    ((Mach1DecodePositionalCore *)M1obj)->setListenerRotation(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setListenerRotationQuat(void *M1obj, Mach1Point4D point) {
-    Mach1Point4D pnt{point.x, point.y, point.z, point.w};
-    ((Mach1DecodePositionalCore *)M1obj)->setListenerRotationQuat(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setDecoderAlgoPosition(void *M1obj, Mach1Point3D point) {
-    Mach1Point3D pnt{point.x, point.y, point.z};
-    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoPosition(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setDecoderAlgoRotation(void *M1obj, Mach1Point3D point) {
-    Mach1Point3D pnt{point.x, point.y, point.z};
-    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoRotation(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(void *M1obj, Mach1Point4D point) {
-    Mach1Point4D pnt{point.x, point.y, point.z, point.w};
-    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoRotationQuat(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_setDecoderAlgoScale(void *M1obj, Mach1Point3D point) {
-    Mach1Point3D pnt{point.x, point.y, point.z};
-    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoScale(&pnt);
-}
-
-void Mach1DecodePositionalCAPI_evaluatePositionResults(void *M1obj) {
-    ((Mach1DecodePositionalCore *)M1obj)->evaluatePositionResults();
-}
-
-void Mach1DecodePositionalCAPI_getCoefficients(void *M1obj, float *result) {
-    ((Mach1DecodePositionalCore *)M1obj)->getCoefficients(result);
-}
-
-float Mach1DecodePositionalCAPI_getDist(void *M1obj) {
-    return ((Mach1DecodePositionalCore *)M1obj)->getDist();
-}
-
-int Mach1DecodePositionalCAPI_getFormatChannelCount(void *M1obj) {
-    return ((Mach1DecodePositionalCore *)M1obj)->getFormatChannelCount();
-}
-
-int Mach1DecodePositionalCAPI_getFormatCoeffCount(void *M1obj) {
-    return ((Mach1DecodePositionalCore *)M1obj)->getFormatCoeffCount();
-}
-
-Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngle(void *M1obj) {
-    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getCurrentAngle();
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
-
-Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngleInternal(void *M1obj) {
-    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getCurrentAngleInternal();
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
-
-Mach1Point3D Mach1DecodePositionalCAPI_getPositionalRotation(void *M1obj) {
-    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getPositionalRotation();
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
-
-void Mach1DecodePositionalCAPI_setFilterSpeed(void *M1obj, float filterSpeed) {
-    ((Mach1DecodePositionalCore *)M1obj)->setFilterSpeed(filterSpeed);
-}
-
-Mach1Point3D Mach1DecodePositionalCAPI_getClosestPointOnPlane(void *M1obj) {
-    Mach1Point3D p = ((Mach1DecodePositionalCore *)M1obj)->getClosestPointOnPlane();
-    return Mach1Point3D{p.x, p.y, p.z};
-}
-
-long Mach1DecodePositionalCAPI_getLastCalculationTime(void *M1obj) {
-    return ((Mach1DecodePositionalCore *)M1obj)->getLastCalculationTime();
-}
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#include "Mach1DecodePositionalCAPI.h"
+#include "Mach1DecodePositionalCore.h"
+#include "Mach1ObjectPool.h"
+
+typedef Mach1ObjectPool<Mach1DecodePositionalCore> Mach1DecodePositionalCorePool;
+
+void *Mach1DecodePositionalCAPI_create() {
+    return new Mach1DecodePositionalCore();
+}
+
+void Mach1DecodePositionalCAPI_delete(void *M1obj) {
+    if (M1obj != nullptr) {
+        delete (Mach1DecodePositionalCore *)M1obj;
+        M1obj = nullptr;
+    }
+}
+
+void *Mach1DecodePositionalCAPI_createPool(int capacity) {
+    return new Mach1DecodePositionalCorePool(capacity);
+}
+
+void Mach1DecodePositionalCAPI_deletePool(void *M1pool) {
+    if (M1pool != nullptr) {
+        delete (Mach1DecodePositionalCorePool *)M1pool;
+        M1pool = nullptr;
+    }
+}
+
+int Mach1DecodePositionalCAPI_poolAcquire(void *M1pool) {
+    return ((Mach1DecodePositionalCorePool *)M1pool)->acquire();
+}
+
+void Mach1DecodePositionalCAPI_poolRelease(void *M1pool, int index) {
+    ((Mach1DecodePositionalCorePool *)M1pool)->release(index);
+}
+
+void *Mach1DecodePositionalCAPI_poolGet(void *M1pool, int index) {
+    return ((Mach1DecodePositionalCorePool *)M1pool)->get(index);
+}
+
+int Mach1DecodePositionalCAPI_poolGetIndex(void *M1pool, void *M1obj) {
+    return ((Mach1DecodePositionalCorePool *)M1pool)->indexOf(M1obj);
+}
+
+int Mach1DecodePositionalCAPI_poolGetCapacity(void *M1pool) {
+    return ((Mach1DecodePositionalCorePool *)M1pool)->getCapacity();
+}
+
+int Mach1DecodePositionalCAPI_poolGetActiveCount(void *M1pool) {
+    return ((Mach1DecodePositionalCorePool *)M1pool)->getActiveCount();
+}
+
+void Mach1DecodePositionalCAPI_setPlatformType(void *M1obj, Mach1PlatformType type) {
+    if (M1obj != nullptr) {
+        ((Mach1DecodePositionalCore *)M1obj)->setPlatformType(type);
+    }
+}
+
+void Mach1DecodePositionalCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
+    if (M1obj != nullptr) {
+        ((Mach1DecodePositionalCore *)M1obj)->setDecodeMode(mode);
+    }
+}
+
+void Mach1DecodePositionalCAPI_setReducedDecodeMode(void *M1obj, enum Mach1DecodeMode mode) {
+    if (M1obj != nullptr) {
+        ((Mach1DecodePositionalCore *)M1obj)->setReducedDecodeMode(mode);
+    }
+}
+
+void Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(void *M1obj, bool muteWhenOutsideObject) {
+    ((Mach1DecodePositionalCore *)M1obj)->setMuteWhenOutsideObject(muteWhenOutsideObject);
+}
+
+void Mach1DecodePositionalCAPI_setMuteWhenInsideObject(void *M1obj, bool muteWhenInsideObject) {
+    ((Mach1DecodePositionalCore *)M1obj)->setMuteWhenInsideObject(muteWhenInsideObject);
+}
+
+void Mach1DecodePositionalCAPI_setUseAttenuation(void *M1obj, bool useAttenuation) {
+    ((Mach1DecodePositionalCore *)M1obj)->setUseAttenuation(useAttenuation);
+}
+
+void Mach1DecodePositionalCAPI_setAttenuationCurve(void *M1obj, float attenuationCurve) {
+    ((Mach1DecodePositionalCore *)M1obj)->setAttenuationCurve(attenuationCurve);
+}
+
+void Mach1DecodePositionalCAPI_setAttenuationModel(void *M1obj, enum Mach1AttenuationModel model) {
+    ((Mach1DecodePositionalCore *)M1obj)->setAttenuationModel(model);
+}
+
+void Mach1DecodePositionalCAPI_setAttenuationRange(void *M1obj, float minDistance, float maxDistance) {
+    ((Mach1DecodePositionalCore *)M1obj)->setAttenuationRange(minDistance, maxDistance);
+}
+
+void Mach1DecodePositionalCAPI_setAttenuationRolloff(void *M1obj, float rolloff) {
+    ((Mach1DecodePositionalCore *)M1obj)->setAttenuationRolloff(rolloff);
+}
+
+bool Mach1DecodePositionalCAPI_setAttenuationTable(void *M1obj, float *distances, float *gains, int count) {
+    return ((Mach1DecodePositionalCore *)M1obj)->setAttenuationTable(distances, gains, count);
+}
+
+float Mach1DecodePositionalCAPI_getAttenuationGain(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getAttenuationGain();
+}
+
+void Mach1DecodePositionalCAPI_setOcclusionGain(void *M1obj, float occlusionGain) {
+    ((Mach1DecodePositionalCore *)M1obj)->setOcclusionGain(occlusionGain);
+}
+
+float Mach1DecodePositionalCAPI_getOcclusionGain(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getOcclusionGain();
+}
+
+void Mach1DecodePositionalCAPI_setUsePlaneCalculation(void *M1obj, bool usePlaneCalculation) {
+    ((Mach1DecodePositionalCore *)M1obj)->setUsePlaneCalculation(usePlaneCalculation);
+}
+
+void Mach1DecodePositionalCAPI_setUseYawForRotation(void *M1obj, bool useYawForRotation) {
+    ((Mach1DecodePositionalCore *)M1obj)->setUseYawForRotation(useYawForRotation);
+}
+
+void Mach1DecodePositionalCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation) {
+    ((Mach1DecodePositionalCore *)M1obj)->setUsePitchForRotation(usePitchForRotation);
+}
+
+void Mach1DecodePositionalCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation) {
+    ((Mach1DecodePositionalCore *)M1obj)->setUseRollForRotation(useRollForRotation);
+}
+
+void Mach1DecodePositionalCAPI_setListenerPosition(void *M1obj, Mach1Point3D point) {
+    Mach1Point3D pnt{point.x, point.y, point.z};
+    ((Mach1DecodePositionalCore *)M1obj)->setListenerPosition(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setListenerRotation(void *M1obj, Mach1Point3D point) {
+    Mach1Point3D pnt{point.x, point.y, point.z};
+    ((Mach1DecodePositionalCore *)M1obj)->setListenerRotation(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setListenerRotationQuat(void *M1obj, Mach1Point4D point) {
+    Mach1Point4D pnt{point.x, point.y, point.z, point.w};
+    ((Mach1DecodePositionalCore *)M1obj)->setListenerRotationQuat(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setDecoderAlgoPosition(void *M1obj, Mach1Point3D point) {
+    Mach1Point3D pnt{point.x, point.y, point.z};
+    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoPosition(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setDecoderAlgoRotation(void *M1obj, Mach1Point3D point) {
+    Mach1Point3D pnt{point.x, point.y, point.z};
+    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoRotation(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(void *M1obj, Mach1Point4D point) {
+    Mach1Point4D pnt{point.x, point.y, point.z, point.w};
+    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoRotationQuat(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_setDecoderAlgoScale(void *M1obj, Mach1Point3D point) {
+    Mach1Point3D pnt{point.x, point.y, point.z};
+    ((Mach1DecodePositionalCore *)M1obj)->setDecoderAlgoScale(&pnt);
+}
+
+void Mach1DecodePositionalCAPI_evaluatePositionResults(void *M1obj) {
+    ((Mach1DecodePositionalCore *)M1obj)->evaluatePositionResults();
+}
+
+void Mach1DecodePositionalCAPI_getCoefficients(void *M1obj, float *result) {
+    ((Mach1DecodePositionalCore *)M1obj)->getCoefficients(result);
+}
+
+float Mach1DecodePositionalCAPI_getDist(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getDist();
+}
+
+int Mach1DecodePositionalCAPI_getFormatChannelCount(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getFormatChannelCount();
+}
+
+int Mach1DecodePositionalCAPI_getFormatCoeffCount(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getFormatCoeffCount();
+}
+
+Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngle(void *M1obj) {
+    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getCurrentAngle();
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
+
+Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngleInternal(void *M1obj) {
+    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getCurrentAngleInternal();
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
+
+Mach1Point3D Mach1DecodePositionalCAPI_getPositionalRotation(void *M1obj) {
+    Mach1Point3D angle = ((Mach1DecodePositionalCore *)M1obj)->getPositionalRotation();
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
+
+void Mach1DecodePositionalCAPI_setFilterSpeed(void *M1obj, float filterSpeed) {
+    ((Mach1DecodePositionalCore *)M1obj)->setFilterSpeed(filterSpeed);
+}
+
+void Mach1DecodePositionalCAPI_setCoeffReuseThreshold(void *M1obj, float thresholdDegrees) {
+    ((Mach1DecodePositionalCore *)M1obj)->setCoeffReuseThreshold(thresholdDegrees);
+}
+
+float Mach1DecodePositionalCAPI_getCoeffReuseRate(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getCoeffReuseRate();
+}
+
+void Mach1DecodePositionalCAPI_setDeterministic(void *M1obj, bool enable) {
+    ((Mach1DecodePositionalCore *)M1obj)->setDeterministic(enable);
+}
+
+bool Mach1DecodePositionalCAPI_getDeterministic(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getDeterministic();
+}
+
+void Mach1DecodePositionalCAPI_setManualTime(void *M1obj, long milliseconds) {
+    ((Mach1DecodePositionalCore *)M1obj)->setManualTime(milliseconds);
+}
+
+Mach1Point3D Mach1DecodePositionalCAPI_getClosestPointOnPlane(void *M1obj) {
+    Mach1Point3D p = ((Mach1DecodePositionalCore *)M1obj)->getClosestPointOnPlane();
+    return Mach1Point3D{p.x, p.y, p.z};
+}
+
+long Mach1DecodePositionalCAPI_getLastCalculationTime(void *M1obj) {
+    return ((Mach1DecodePositionalCore *)M1obj)->getLastCalculationTime();
+}
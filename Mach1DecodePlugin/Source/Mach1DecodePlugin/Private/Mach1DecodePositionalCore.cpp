@@ -1,440 +1,871 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-/*
-DISCLAIMER:
-This file is not an example of use but an decoder that will require periodic
-updates and should not be integrated in sections but remain as an update-able factored file.
-*/
-
-#include "Mach1DecodePositionalCore.h"
-
-glm::vec3 Mach1DecodePositionalCore::QuaternionToEuler(glm::quat q) {
-    glm::vec3 euler;
-
-    // if the input quaternion is normalized, this is exactly one. Otherwise, this acts as a correction factor for the quaternion's not-normalizedness
-    float unit = (q.x * q.x) + (q.y * q.y) + (q.z * q.z) + (q.w * q.w);
-
-    // this will have a magnitude of 0.5 or greater if and only if this is a singularity case
-    float test = q.x * q.w - q.y * q.z;
-
-    if (test > 0.499999f * unit) // singularity at north pole
-    {
-        euler.y = -PI_F / 2;
-        euler.x = -2.0f * atan2(q.y, q.x);
-        euler.z = 0;
-    } else if (test < -0.499999f * unit) // singularity at south pole
-    {
-        euler.y = PI_F / 2;
-        euler.x = 2.0f * atan2(q.y, q.x);
-        euler.z = 0;
-    } else // no singularity - this is the majority of cases
-    {
-        euler.y = -asin(2.0f * (q.w * q.x - q.y * q.z));
-        euler.x = atan2(2.0f * q.w * q.y + 2.0f * q.z * q.x, 1 - 2.0f * (q.x * q.x + q.y * q.y));
-        euler.z = -atan2(2.0f * q.w * q.z + 2.0f * q.x * q.y, 1 - 2.0f * (q.z * q.z + q.x * q.x));
-    }
-
-    // ensure the degree values are between 0 and 2*PI
-    euler.x = fmod(euler.x, 2 * PI_F);
-    euler.y = fmod(euler.y, 2 * PI_F);
-    euler.z = fmod(euler.z, 2 * PI_F);
-
-    return euler;
-}
-
-glm::quat Mach1DecodePositionalCore::EulerToQuaternion(glm::vec3 euler) {
-    float xOver2 = -euler.y * 0.5f;
-    float yOver2 = euler.x * 0.5f;
-    float zOver2 = -euler.z * 0.5f;
-
-    float sinXOver2 = sin(xOver2);
-    float cosXOver2 = cos(xOver2);
-    float sinYOver2 = sin(yOver2);
-    float cosYOver2 = cos(yOver2);
-    float sinZOver2 = sin(zOver2);
-    float cosZOver2 = cos(zOver2);
-
-    glm::quat result;
-    result.x = cosYOver2 * sinXOver2 * cosZOver2 + sinYOver2 * cosXOver2 * sinZOver2;
-    result.y = sinYOver2 * cosXOver2 * cosZOver2 - cosYOver2 * sinXOver2 * sinZOver2;
-    result.z = cosYOver2 * cosXOver2 * sinZOver2 - sinYOver2 * sinXOver2 * cosZOver2;
-    result.w = cosYOver2 * cosXOver2 * cosZOver2 + sinYOver2 * sinXOver2 * sinZOver2;
-
-    return result;
-}
-
-// Position settings functions
-void Mach1DecodePositionalCore::ConvertPositionToMach1(Mach1PlatformType platformType, float *X, float *Y, float *Z) {
-    float _x = 0, _y = 0, _z = 0;
-
-    switch (platformType) {
-    case Mach1PlatformDefault:
-        // forward: z, right: x, up: y
-        *X = *X;
-        *Y = *Y;
-        *Z = *Z;
-        break;
-
-    case Mach1PlatformUE:
-        // forward: x, right: y, up: z
-        _z = *X;
-        _x = *Y;
-        _y = *Z;
-        *X = _x;
-        *Y = _y;
-        *Z = _z;
-        break;
-
-    case Mach1PlatformUnity:
-        // forward: z, right: x, up: y
-        *X = *X;
-        *Y = *Y;
-        *Z = *Z;
-        break;
-
-    default:
-        break;
-    }
-}
-
-void Mach1DecodePositionalCore::ConvertPositionToPlatform(Mach1PlatformType platformType, float *X, float *Y, float *Z) {
-    float _x = 0, _y = 0, _z = 0;
-
-    switch (platformType) {
-    case Mach1PlatformDefault:
-        // forward: z, right: x, up: y
-        *X = *X;
-        *Y = *Y;
-        *Z = *Z;
-        break;
-
-    case Mach1PlatformUE:
-        // forward: x, right: y, up: z
-        _x = *X;
-        _y = *Y;
-        _z = *Z;
-        *X = _z;
-        *Y = _x;
-        *Z = _y;
-        break;
-
-    case Mach1PlatformUnity:
-        // forward: z, right: x, up: y
-        // X Y Z -> X Z Y
-        break;
-
-    default:
-        break;
-    }
-}
-
-float Mach1DecodePositionalCore::ClosestPointOnBox(glm::vec3 point, glm::vec3 center, glm::vec3 axis0, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 extents, glm::vec3 &closestPoint) {
-    glm::vec3 vector = point - center;
-    float num = 0.0f;
-
-    float num0 = glm::dot(vector, axis0);
-    if (num0 < -extents.x) {
-        num += powf(num0 + extents.x, 2);
-        num0 = -extents.x;
-    } else if (num0 > extents.x) {
-        num += powf(num0 - extents.x, 2);
-        num0 = extents.x;
-    }
-
-    float num1 = glm::dot(vector, axis1);
-    if (num1 < -extents.y) {
-        num += powf(num1 + extents.y, 2);
-        num1 = -extents.y;
-    } else if (num1 > extents.y) {
-        num += powf(num1 - extents.y, 2);
-        num1 = extents.y;
-    }
-
-    float num2 = glm::dot(vector, axis2);
-    if (num2 < -extents.z) {
-        num += powf(num2 + extents.z, 2);
-        num2 = -extents.z;
-    } else if (num2 > extents.z) {
-        num += powf(num2 - extents.z, 2);
-        num2 = extents.z;
-    }
-    closestPoint = center + num0 * axis0 + num1 * axis1 + num2 * axis2;
-
-    return sqrt(num);
-}
-
-bool Mach1DecodePositionalCore::Clip(float denom, float numer, float &t0, float &t1) {
-    if ((double)denom > 0.0) {
-        if ((double)numer > (double)denom * (double)t1)
-            return false;
-        if ((double)numer > (double)denom * (double)t0)
-            t0 = numer / denom;
-        return true;
-    }
-    if ((double)denom >= 0.0)
-        return (double)numer <= 0.0;
-    if ((double)numer > (double)denom * (double)t0)
-        return false;
-    if ((double)numer > (double)denom * (double)t1)
-        t1 = numer / denom;
-    return true;
-}
-
-int Mach1DecodePositionalCore::DoClipping(float t0, float t1, glm::vec3 origin, glm::vec3 direction, glm::vec3 center, glm::vec3 axis0, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 extents, bool solid, glm::vec3 &point0, glm::vec3 &point1) {
-    glm::vec3 vector = origin - center;
-    glm::vec3 vector2 = glm::vec3(glm::dot(vector, axis0), glm::dot(vector, axis1), glm::dot(vector, axis2));
-    glm::vec3 vector3 = glm::vec3(glm::dot(direction, axis0), glm::dot(direction, axis1), glm::dot(direction, axis2));
-
-    float num = t0;
-    float num2 = t1;
-
-    int quantity = 0;
-
-    bool flag = Clip(vector3.x, -vector2.x - extents.x, t0, t1) && Clip(-vector3.x, vector2.x - extents.x, t0, t1) && Clip(vector3.y, -vector2.y - extents.y, t0, t1) && Clip(-vector3.y, vector2.y - extents.y, t0, t1) && Clip(vector3.z, -vector2.z - extents.z, t0, t1) && Clip(-vector3.z, vector2.z - extents.z, t0, t1);
-    if (flag && (solid || t0 != num || t1 != num2)) {
-        if (t1 > t0) {
-            quantity = 2;
-            point0 = origin + t0 * direction;
-            point1 = origin + t1 * direction;
-        } else {
-
-            quantity = 1;
-            point0 = origin + t0 * direction;
-            point1 = glm::vec3();
-        }
-    } else {
-        quantity = 0;
-        point0 = glm::vec3();
-        point1 = glm::vec3();
-    }
-
-    return quantity;
-}
-
-glm::vec3 Mach1DecodePositionalCore::GetRightVector() {
-    return glm::vec3(1, 0, 0);
-}
-
-glm::vec3 Mach1DecodePositionalCore::GetUpVector() {
-    return glm::vec3(0, 1, 0);
-}
-
-glm::vec3 Mach1DecodePositionalCore::GetForwardVector() {
-    return glm::vec3(0, 0, 1);
-}
-
-Mach1DecodePositionalCore::Mach1DecodePositionalCore() {
-    falloffCurve = 1;
-
-    ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
-    timeLastCalculation = 0;
-
-    setDecodeMode(Mach1DecodeMode::M1DecodeSpatial_8);
-}
-
-void Mach1DecodePositionalCore::setDecodeMode(Mach1DecodeMode mode) {
-    decodeMode = mode;
-    mach1Decode.setDecodeMode(decodeMode);
-}
-
-void Mach1DecodePositionalCore::setPlatformType(Mach1PlatformType type) {
-    platformType = type;
-    mach1Decode.setPlatformType(Mach1PlatformType::Mach1PlatformDefault); // because rotation is already converted by positional
-}
-
-void Mach1DecodePositionalCore::setAttenuationCurve(float attenuationCurve) {
-    this->falloffCurve = attenuationCurve;
-}
-
-void Mach1DecodePositionalCore::setMuteWhenOutsideObject(bool _muteWhenOutsideObject) {
-    this->muteWhenOutsideObject = _muteWhenOutsideObject;
-}
-
-void Mach1DecodePositionalCore::setMuteWhenInsideObject(bool _muteWhenInsideObject) {
-    this->muteWhenOutsideObject = _muteWhenInsideObject;
-}
-
-void Mach1DecodePositionalCore::setUseAttenuation(bool useAttenuation) {
-    this->useFalloff = useAttenuation;
-}
-
-void Mach1DecodePositionalCore::setUsePlaneCalculation(bool usePlaneCalculation) {
-    this->useClosestPointRotationMuteInside = usePlaneCalculation;
-}
-
-void Mach1DecodePositionalCore::setUseYawForRotation(bool _useYawForRotation) {
-    this->useYawForRotation = _useYawForRotation;
-}
-
-void Mach1DecodePositionalCore::setUsePitchForRotation(bool _usePitchForRotation) {
-    this->usePitchForRotation = _usePitchForRotation;
-}
-
-void Mach1DecodePositionalCore::setUseRollForRotation(bool _useRollForRotation) {
-    this->useRollForRotation = _useRollForRotation;
-}
-
-void Mach1DecodePositionalCore::setListenerPosition(Mach1Point3D *pos) {
-    ConvertPositionToMach1(platformType, &pos->x, &pos->y, &pos->z);
-    cameraPosition = glm::vec3(pos->x, pos->y, pos->z);
-}
-
-void Mach1DecodePositionalCore::setListenerRotation(Mach1Point3D *euler) {
-    Mach1Point3D angle = {euler->x, euler->y, euler->z};
-    M1DecodeCore::convertAnglesToMach1(platformType, &angle.x, &angle.y, &angle.z);
-    cameraRotation = EulerToQuaternion(glm::vec3(angle.x, angle.y, angle.z) * DEG_TO_RAD_F);
-}
-
-void Mach1DecodePositionalCore::setListenerRotationQuat(Mach1Point4D *quat) {
-    cameraRotation = glm::quat(quat->w, quat->x, quat->y, quat->z);
-}
-
-void Mach1DecodePositionalCore::setDecoderAlgoPosition(Mach1Point3D *pos) {
-    ConvertPositionToMach1(platformType, &pos->x, &pos->y, &pos->z);
-    soundPosition = glm::vec3(pos->x, pos->y, pos->z);
-}
-
-void Mach1DecodePositionalCore::setDecoderAlgoRotation(Mach1Point3D *euler) {
-    Mach1Point3D angle = {euler->x, euler->y, euler->z};
-    M1DecodeCore::convertAnglesToMach1(platformType, &angle.x, &angle.y, &angle.z);
-    soundRotation = EulerToQuaternion(glm::vec3(angle.x, angle.y, angle.z) * DEG_TO_RAD_F);
-}
-
-void Mach1DecodePositionalCore::setDecoderAlgoRotationQuat(Mach1Point4D *quat) {
-    soundRotation = glm::quat(quat->w, quat->x, quat->y, quat->z);
-}
-
-void Mach1DecodePositionalCore::setDecoderAlgoScale(Mach1Point3D *scale) {
-    soundScale = glm::vec3(scale->x, scale->y, scale->z);
-}
-
-void Mach1DecodePositionalCore::evaluatePositionResults() {
-    long tStart = getCurrentTime();
-
-    gain = 1.0f;
-    dist = 0;
-
-    // Find closest point
-    glm::vec3 point = soundPosition;
-
-    glm::vec3 outsideClosestPoint;
-    // glm::vec3 insidePoint0, insidePoint1;
-
-    glm::vec3 soundRightVector = soundRotation * GetRightVector();     // glm::vec3(1, 0, 0);// GetRightVector(); // right
-    glm::vec3 soundUpVector = soundRotation * GetUpVector();           // glm::vec3(0, 1, 0); // up
-    glm::vec3 soundForwardVector = soundRotation * GetForwardVector(); // glm::vec3(0, 0, 1); // forward
-
-    bool isOutside = (ClosestPointOnBox(cameraPosition, soundPosition, soundRightVector, soundUpVector, soundForwardVector, soundScale / 2.0f, outsideClosestPoint) > 0);
-    bool hasSoundOutside = isOutside && !muteWhenOutsideObject;
-    bool hasSoundInside = !isOutside && !muteWhenInsideObject;
-
-    if (hasSoundOutside && useClosestPointRotationMuteInside) // useClosestPointRotation
-    {
-        point = outsideClosestPoint;
-
-        dist = glm::distance(cameraPosition, point);
-
-        if (useFalloff) {
-            gain = gain * falloffCurve;
-        }
-    } else if (hasSoundOutside || hasSoundInside) // useCenterPointRotation
-    {
-        dist = glm::distance(cameraPosition, point);
-
-        if (useFalloff) {
-            if (hasSoundOutside) {
-                gain = gain * falloffCurve;
-            }
-        }
-    } else {
-        gain = 0;
-    }
-
-    closestPointOnPlane = point;
-    glm::vec3 dir = point - cameraPosition;
-
-    if (glm::length(dir) > 0) {
-        // Compute rotation for sound
-        // http://www.aclockworkberry.com/world-coordinate-systems-in-3ds-max-unity-and-unreal-engine/
-        glm::quat quat;
-        quat = glm::quatLookAtLH(glm::normalize(dir), GetUpVector()) * glm::inverse(soundRotation);
-
-        glm::vec3 quatEulerAngles = QuaternionToEuler(glm::normalize(quat));
-
-        bool useXForRotation = useYawForRotation;
-        bool useYForRotation = usePitchForRotation;
-        bool useZForRotation = useRollForRotation;
-
-        quat = EulerToQuaternion(glm::vec3(useXForRotation ? quatEulerAngles.x : 0, useYForRotation ? quatEulerAngles.y : 0, useZForRotation ? quatEulerAngles.z : 0));
-        eulerAnglesCube = QuaternionToEuler(glm::normalize(quat)) * RAD_TO_DEG_F;
-
-        quat = glm::inverse(quat) * cameraRotation; // * glm::inverse(soundRotation);
-        eulerAngles = QuaternionToEuler(glm::normalize(quat)) * RAD_TO_DEG_F;
-
-        // SoundAlgorithm
-        mach1Decode.setRotationDegrees(Mach1Point3D{eulerAngles.x, eulerAngles.y, eulerAngles.z});
-        coeffs = mach1Decode.decodeCoeffs(0, 0);
-    } else {
-        // Fixed zero distance
-        eulerAngles = glm::vec3(0, 0, 0);
-
-        for (int i = 0; i < coeffs.size(); i++) {
-            coeffs[i] = 0;
-        }
-        gain = 0;
-    }
-    timeLastCalculation = getCurrentTime() - tStart;
-}
-
-void Mach1DecodePositionalCore::getCoefficients(float *result) {
-    for (int i = 0; i < coeffs.size(); i++) {
-        result[i] = gain * coeffs[i];
-    }
-}
-
-int Mach1DecodePositionalCore::getFormatChannelCount() {
-    return mach1Decode.getFormatChannelCount();
-}
-
-int Mach1DecodePositionalCore::getFormatCoeffCount() {
-    return mach1Decode.getFormatCoeffCount();
-}
-
-Mach1Point3D Mach1DecodePositionalCore::getCurrentAngle() {
-    glm::vec3 angle = eulerAngles;
-    M1DecodeCore::convertAnglesToPlatform(platformType, &angle.x, &angle.y, &angle.z);
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
-
-Mach1Point3D Mach1DecodePositionalCore::getCurrentAngleInternal() {
-    return Mach1Point3D{eulerAngles.x, eulerAngles.y, eulerAngles.z};
-}
-
-Mach1Point3D Mach1DecodePositionalCore::getPositionalRotation() {
-    glm::vec3 angle = eulerAnglesCube;
-    M1DecodeCore::convertAnglesToPlatform(platformType, &angle.x, &angle.y, &angle.z);
-    return Mach1Point3D{angle.x, angle.y, angle.z};
-}
-
-Mach1Point3D Mach1DecodePositionalCore::getClosestPointOnPlane() {
-    glm::vec3 p = closestPointOnPlane;
-    ConvertPositionToPlatform(platformType, &p.x, &p.y, &p.z);
-    return Mach1Point3D{p.x, p.y, p.z};
-}
-
-float Mach1DecodePositionalCore::getDist() {
-    return dist;
-}
-
-void Mach1DecodePositionalCore::setFilterSpeed(float filterSpeed) {
-    mach1Decode.setFilterSpeed(filterSpeed);
-}
-
-long Mach1DecodePositionalCore::getCurrentTime() {
-    return (long)(duration_cast<milliseconds>(system_clock::now().time_since_epoch()) - ms).count();
-}
-
-long Mach1DecodePositionalCore::getLastCalculationTime() {
-    return timeLastCalculation;
-}
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+#include "Mach1DeterministicMath.h"
+
+// opened before the other includes so the glm math the kernels inline keeps its written evaluation
+// order too; this file is built outside unity blobs so glm is first parsed here (Mach1DecodePlugin.Build.cs)
+M1_DETERMINISTIC_FP_BEGIN
+
+#include "Mach1DecodePositionalCore.h"
+#include <algorithm>
+
+glm::vec3 Mach1DecodePositionalCore::QuaternionToEuler(glm::quat q, bool deterministic) {
+    glm::vec3 euler;
+
+    // if the input quaternion is normalized, this is exactly one. Otherwise, this acts as a correction factor for the quaternion's not-normalizedness
+    float unit = (q.x * q.x) + (q.y * q.y) + (q.z * q.z) + (q.w * q.w);
+
+    // this will have a magnitude of 0.5 or greater if and only if this is a singularity case
+    float test = q.x * q.w - q.y * q.z;
+
+    if (test > 0.499999f * unit) // singularity at north pole
+    {
+        euler.y = -PI_F / 2;
+        euler.x = -2.0f * (deterministic ? m1DetAtan2(q.y, q.x) : atan2(q.y, q.x));
+        euler.z = 0;
+    } else if (test < -0.499999f * unit) // singularity at south pole
+    {
+        euler.y = PI_F / 2;
+        euler.x = 2.0f * (deterministic ? m1DetAtan2(q.y, q.x) : atan2(q.y, q.x));
+        euler.z = 0;
+    } else // no singularity - this is the majority of cases
+    {
+        float sinY = 2.0f * (q.w * q.x - q.y * q.z);
+        float sinX = 2.0f * q.w * q.y + 2.0f * q.z * q.x, cosX = 1 - 2.0f * (q.x * q.x + q.y * q.y);
+        float sinZ = 2.0f * q.w * q.z + 2.0f * q.x * q.y, cosZ = 1 - 2.0f * (q.z * q.z + q.x * q.x);
+
+        if (deterministic) {
+            euler.y = -m1DetAsin(sinY);
+            euler.x = m1DetAtan2(sinX, cosX);
+            euler.z = -m1DetAtan2(sinZ, cosZ);
+        } else {
+            euler.y = -asin(sinY);
+            euler.x = atan2(sinX, cosX);
+            euler.z = -atan2(sinZ, cosZ);
+        }
+    }
+
+    // ensure the degree values are between 0 and 2*PI
+    euler.x = fmod(euler.x, 2 * PI_F);
+    euler.y = fmod(euler.y, 2 * PI_F);
+    euler.z = fmod(euler.z, 2 * PI_F);
+
+    return euler;
+}
+
+glm::quat Mach1DecodePositionalCore::EulerToQuaternion(glm::vec3 euler, bool deterministic) {
+    float xOver2 = -euler.y * 0.5f;
+    float yOver2 = euler.x * 0.5f;
+    float zOver2 = -euler.z * 0.5f;
+
+    float sinXOver2, cosXOver2, sinYOver2, cosYOver2, sinZOver2, cosZOver2;
+    if (deterministic) {
+        m1DetSinCos(xOver2, sinXOver2, cosXOver2);
+        m1DetSinCos(yOver2, sinYOver2, cosYOver2);
+        m1DetSinCos(zOver2, sinZOver2, cosZOver2);
+    } else {
+        sinXOver2 = sin(xOver2);
+        cosXOver2 = cos(xOver2);
+        sinYOver2 = sin(yOver2);
+        cosYOver2 = cos(yOver2);
+        sinZOver2 = sin(zOver2);
+        cosZOver2 = cos(zOver2);
+    }
+
+    glm::quat result;
+    result.x = cosYOver2 * sinXOver2 * cosZOver2 + sinYOver2 * cosXOver2 * sinZOver2;
+    result.y = sinYOver2 * cosXOver2 * cosZOver2 - cosYOver2 * sinXOver2 * sinZOver2;
+    result.z = cosYOver2 * cosXOver2 * sinZOver2 - sinYOver2 * sinXOver2 * cosZOver2;
+    result.w = cosYOver2 * cosXOver2 * cosZOver2 + sinYOver2 * sinXOver2 * sinZOver2;
+
+    return result;
+}
+
+// Position settings functions
+void Mach1DecodePositionalCore::ConvertPositionToMach1(Mach1PlatformType platformType, float *X, float *Y, float *Z) {
+    float _x = 0, _y = 0, _z = 0;
+
+    switch (platformType) {
+    case Mach1PlatformDefault:
+        // forward: z, right: x, up: y
+        *X = *X;
+        *Y = *Y;
+        *Z = *Z;
+        break;
+
+    case Mach1PlatformUE:
+        // forward: x, right: y, up: z
+        _z = *X;
+        _x = *Y;
+        _y = *Z;
+        *X = _x;
+        *Y = _y;
+        *Z = _z;
+        break;
+
+    case Mach1PlatformUnity:
+        // forward: z, right: x, up: y
+        *X = *X;
+        *Y = *Y;
+        *Z = *Z;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Mach1DecodePositionalCore::ConvertPositionToPlatform(Mach1PlatformType platformType, float *X, float *Y, float *Z) {
+    float _x = 0, _y = 0, _z = 0;
+
+    switch (platformType) {
+    case Mach1PlatformDefault:
+        // forward: z, right: x, up: y
+        *X = *X;
+        *Y = *Y;
+        *Z = *Z;
+        break;
+
+    case Mach1PlatformUE:
+        // forward: x, right: y, up: z
+        _x = *X;
+        _y = *Y;
+        _z = *Z;
+        *X = _z;
+        *Y = _x;
+        *Z = _y;
+        break;
+
+    case Mach1PlatformUnity:
+        // forward: z, right: x, up: y
+        // X Y Z -> X Z Y
+        break;
+
+    default:
+        break;
+    }
+}
+
+float Mach1DecodePositionalCore::ClosestPointOnBox(glm::vec3 point, glm::vec3 center, glm::vec3 axis0, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 extents, glm::vec3 &closestPoint) {
+    glm::vec3 vector = point - center;
+    float num = 0.0f;
+
+    float num0 = glm::dot(vector, axis0);
+    if (num0 < -extents.x) {
+        num += (num0 + extents.x) * (num0 + extents.x);
+        num0 = -extents.x;
+    } else if (num0 > extents.x) {
+        num += (num0 - extents.x) * (num0 - extents.x);
+        num0 = extents.x;
+    }
+
+    float num1 = glm::dot(vector, axis1);
+    if (num1 < -extents.y) {
+        num += (num1 + extents.y) * (num1 + extents.y);
+        num1 = -extents.y;
+    } else if (num1 > extents.y) {
+        num += (num1 - extents.y) * (num1 - extents.y);
+        num1 = extents.y;
+    }
+
+    float num2 = glm::dot(vector, axis2);
+    if (num2 < -extents.z) {
+        num += (num2 + extents.z) * (num2 + extents.z);
+        num2 = -extents.z;
+    } else if (num2 > extents.z) {
+        num += (num2 - extents.z) * (num2 - extents.z);
+        num2 = extents.z;
+    }
+    closestPoint = center + num0 * axis0 + num1 * axis1 + num2 * axis2;
+
+    return sqrtf(num);
+}
+
+bool Mach1DecodePositionalCore::Clip(float denom, float numer, float &t0, float &t1) {
+    if ((double)denom > 0.0) {
+        if ((double)numer > (double)denom * (double)t1)
+            return false;
+        if ((double)numer > (double)denom * (double)t0)
+            t0 = numer / denom;
+        return true;
+    }
+    if ((double)denom >= 0.0)
+        return (double)numer <= 0.0;
+    if ((double)numer > (double)denom * (double)t0)
+        return false;
+    if ((double)numer > (double)denom * (double)t1)
+        t1 = numer / denom;
+    return true;
+}
+
+int Mach1DecodePositionalCore::DoClipping(float t0, float t1, glm::vec3 origin, glm::vec3 direction, glm::vec3 center, glm::vec3 axis0, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 extents, bool solid, glm::vec3 &point0, glm::vec3 &point1) {
+    glm::vec3 vector = origin - center;
+    glm::vec3 vector2 = glm::vec3(glm::dot(vector, axis0), glm::dot(vector, axis1), glm::dot(vector, axis2));
+    glm::vec3 vector3 = glm::vec3(glm::dot(direction, axis0), glm::dot(direction, axis1), glm::dot(direction, axis2));
+
+    float num = t0;
+    float num2 = t1;
+
+    int quantity = 0;
+
+    bool flag = Clip(vector3.x, -vector2.x - extents.x, t0, t1) && Clip(-vector3.x, vector2.x - extents.x, t0, t1) && Clip(vector3.y, -vector2.y - extents.y, t0, t1) && Clip(-vector3.y, vector2.y - extents.y, t0, t1) && Clip(vector3.z, -vector2.z - extents.z, t0, t1) && Clip(-vector3.z, vector2.z - extents.z, t0, t1);
+    if (flag && (solid || t0 != num || t1 != num2)) {
+        if (t1 > t0) {
+            quantity = 2;
+            point0 = origin + t0 * direction;
+            point1 = origin + t1 * direction;
+        } else {
+
+            quantity = 1;
+            point0 = origin + t0 * direction;
+            point1 = glm::vec3();
+        }
+    } else {
+        quantity = 0;
+        point0 = glm::vec3();
+        point1 = glm::vec3();
+    }
+
+    return quantity;
+}
+
+void Mach1OrientedBoxArray::resize(int count) {
+    std::vector<float> *columns[] = {&centerX, &centerY, &centerZ, &axis0X, &axis0Y, &axis0Z, &axis1X, &axis1Y, &axis1Z, &axis2X, &axis2Y, &axis2Z, &extentsX, &extentsY, &extentsZ};
+    for (std::vector<float> *column : columns) {
+        column->resize(count, 0.0f);
+    }
+}
+
+int Mach1OrientedBoxArray::size() const {
+    return (int)centerX.size();
+}
+
+void Mach1OrientedBoxArray::setBox(int index, glm::vec3 center, glm::vec3 axis0, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 extents) {
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    axis0X[index] = axis0.x;
+    axis0Y[index] = axis0.y;
+    axis0Z[index] = axis0.z;
+    axis1X[index] = axis1.x;
+    axis1Y[index] = axis1.y;
+    axis1Z[index] = axis1.z;
+    axis2X[index] = axis2.x;
+    axis2Y[index] = axis2.y;
+    axis2Z[index] = axis2.z;
+    extentsX[index] = extents.x;
+    extentsY[index] = extents.y;
+    extentsZ[index] = extents.z;
+}
+
+void Mach1OrientedBoxArray::setBox(int index, glm::vec3 center, glm::quat rotation, glm::vec3 scale) {
+    // same axes and half extents that evaluatePositionResults() builds for the decoder object
+    setBox(index, center, rotation * glm::vec3(1, 0, 0), rotation * glm::vec3(0, 1, 0), rotation * glm::vec3(0, 0, 1), scale / 2.0f);
+}
+
+void Mach1OrientedBoxArray::copyBox(int index, const Mach1OrientedBoxArray &source, int sourceIndex) {
+    centerX[index] = source.centerX[sourceIndex];
+    centerY[index] = source.centerY[sourceIndex];
+    centerZ[index] = source.centerZ[sourceIndex];
+    axis0X[index] = source.axis0X[sourceIndex];
+    axis0Y[index] = source.axis0Y[sourceIndex];
+    axis0Z[index] = source.axis0Z[sourceIndex];
+    axis1X[index] = source.axis1X[sourceIndex];
+    axis1Y[index] = source.axis1Y[sourceIndex];
+    axis1Z[index] = source.axis1Z[sourceIndex];
+    axis2X[index] = source.axis2X[sourceIndex];
+    axis2Y[index] = source.axis2Y[sourceIndex];
+    axis2Z[index] = source.axis2Z[sourceIndex];
+    extentsX[index] = source.extentsX[sourceIndex];
+    extentsY[index] = source.extentsY[sourceIndex];
+    extentsZ[index] = source.extentsZ[sourceIndex];
+}
+
+// Four boxes loaded lane-wise; the tail of the array is padded with zero-sized boxes
+struct Mach1OrientedBox4 {
+    Mach1Float4 centerX, centerY, centerZ;
+    Mach1Float4 axis0X, axis0Y, axis0Z;
+    Mach1Float4 axis1X, axis1Y, axis1Z;
+    Mach1Float4 axis2X, axis2Y, axis2Z;
+    Mach1Float4 extentsX, extentsY, extentsZ;
+};
+
+static Mach1Float4 LoadBoxColumn(const std::vector<float> &column, int start, int lanes) {
+    if (lanes == 4) {
+        return m1Load4(column.data() + start);
+    }
+    float padded[4] = {0, 0, 0, 0};
+    for (int i = 0; i < lanes; i++) {
+        padded[i] = column[start + i];
+    }
+    return m1Load4(padded);
+}
+
+static void LoadBoxes(const Mach1OrientedBoxArray &boxes, int start, int lanes, Mach1OrientedBox4 &box) {
+    box.centerX = LoadBoxColumn(boxes.centerX, start, lanes);
+    box.centerY = LoadBoxColumn(boxes.centerY, start, lanes);
+    box.centerZ = LoadBoxColumn(boxes.centerZ, start, lanes);
+    box.axis0X = LoadBoxColumn(boxes.axis0X, start, lanes);
+    box.axis0Y = LoadBoxColumn(boxes.axis0Y, start, lanes);
+    box.axis0Z = LoadBoxColumn(boxes.axis0Z, start, lanes);
+    box.axis1X = LoadBoxColumn(boxes.axis1X, start, lanes);
+    box.axis1Y = LoadBoxColumn(boxes.axis1Y, start, lanes);
+    box.axis1Z = LoadBoxColumn(boxes.axis1Z, start, lanes);
+    box.axis2X = LoadBoxColumn(boxes.axis2X, start, lanes);
+    box.axis2Y = LoadBoxColumn(boxes.axis2Y, start, lanes);
+    box.axis2Z = LoadBoxColumn(boxes.axis2Z, start, lanes);
+    box.extentsX = LoadBoxColumn(boxes.extentsX, start, lanes);
+    box.extentsY = LoadBoxColumn(boxes.extentsY, start, lanes);
+    box.extentsZ = LoadBoxColumn(boxes.extentsZ, start, lanes);
+}
+
+static Mach1Float4 Dot4(Mach1Float4 x, Mach1Float4 y, Mach1Float4 z, Mach1Float4 ax, Mach1Float4 ay, Mach1Float4 az) {
+    return m1Add4(m1Add4(m1Mul4(x, ax), m1Mul4(y, ay)), m1Mul4(z, az));
+}
+
+static void StoreLanes(float *dst, int start, int lanes, Mach1Float4 value) {
+    if (lanes == 4) {
+        m1Store4(dst + start, value);
+        return;
+    }
+    float tmp[4];
+    m1Store4(tmp, value);
+    for (int i = 0; i < lanes; i++) {
+        dst[start + i] = tmp[i];
+    }
+}
+
+static void StoreMaskLanes(unsigned char *dst, int start, int lanes, int bits) {
+    for (int i = 0; i < lanes; i++) {
+        dst[start + i] = (bits >> i) & 1;
+    }
+}
+
+void Mach1DecodePositionalCore::ClosestPointOnBoxes(glm::vec3 point, const Mach1OrientedBoxArray &boxes, float *distances, float *closestX, float *closestY, float *closestZ, unsigned char *insideMask) {
+    const Mach1Float4 pointX = m1Set4(point.x);
+    const Mach1Float4 pointY = m1Set4(point.y);
+    const Mach1Float4 pointZ = m1Set4(point.z);
+    const Mach1Float4 zero = m1Set4(0.0f);
+
+    const int count = boxes.size();
+    Mach1OrientedBox4 box;
+
+    for (int start = 0; start < count; start += 4) {
+        const int lanes = std::min(4, count - start);
+        LoadBoxes(boxes, start, lanes, box);
+
+        Mach1Float4 vectorX = m1Sub4(pointX, box.centerX);
+        Mach1Float4 vectorY = m1Sub4(pointY, box.centerY);
+        Mach1Float4 vectorZ = m1Sub4(pointZ, box.centerZ);
+
+        // project onto each axis, clamp to the extents and accumulate the squared excess
+        Mach1Float4 num0 = Dot4(vectorX, vectorY, vectorZ, box.axis0X, box.axis0Y, box.axis0Z);
+        Mach1Float4 num1 = Dot4(vectorX, vectorY, vectorZ, box.axis1X, box.axis1Y, box.axis1Z);
+        Mach1Float4 num2 = Dot4(vectorX, vectorY, vectorZ, box.axis2X, box.axis2Y, box.axis2Z);
+
+        Mach1Float4 clamped0 = m1Max4(m1Sub4(zero, box.extentsX), m1Min4(num0, box.extentsX));
+        Mach1Float4 clamped1 = m1Max4(m1Sub4(zero, box.extentsY), m1Min4(num1, box.extentsY));
+        Mach1Float4 clamped2 = m1Max4(m1Sub4(zero, box.extentsZ), m1Min4(num2, box.extentsZ));
+
+        Mach1Float4 excess0 = m1Sub4(num0, clamped0);
+        Mach1Float4 excess1 = m1Sub4(num1, clamped1);
+        Mach1Float4 excess2 = m1Sub4(num2, clamped2);
+        Mach1Float4 num = m1Add4(m1Add4(m1Mul4(excess0, excess0), m1Mul4(excess1, excess1)), m1Mul4(excess2, excess2));
+
+        if (distances) {
+            StoreLanes(distances, start, lanes, m1Sqrt4(num));
+        }
+        if (closestX && closestY && closestZ) {
+            StoreLanes(closestX, start, lanes, m1Add4(box.centerX, Dot4(clamped0, clamped1, clamped2, box.axis0X, box.axis1X, box.axis2X)));
+            StoreLanes(closestY, start, lanes, m1Add4(box.centerY, Dot4(clamped0, clamped1, clamped2, box.axis0Y, box.axis1Y, box.axis2Y)));
+            StoreLanes(closestZ, start, lanes, m1Add4(box.centerZ, Dot4(clamped0, clamped1, clamped2, box.axis0Z, box.axis1Z, box.axis2Z)));
+        }
+        if (insideMask) {
+            StoreMaskLanes(insideMask, start, lanes, m1MoveMask4(m1CmpLe4(num, zero)));
+        }
+    }
+}
+
+void Mach1DecodePositionalCore::ClipSegmentAgainstBoxes(glm::vec3 origin, glm::vec3 direction, float t0, float t1, const Mach1OrientedBoxArray &boxes, float *enterT, float *exitT, unsigned char *hitMask) {
+    const Mach1Float4 originX = m1Set4(origin.x);
+    const Mach1Float4 originY = m1Set4(origin.y);
+    const Mach1Float4 originZ = m1Set4(origin.z);
+    const Mach1Float4 directionX = m1Set4(direction.x);
+    const Mach1Float4 directionY = m1Set4(direction.y);
+    const Mach1Float4 directionZ = m1Set4(direction.z);
+    const Mach1Float4 zero = m1Set4(0.0f);
+    const Mach1Float4 one = m1Set4(1.0f);
+    const Mach1Float4 epsilon = m1Set4(1e-12f);
+    const Mach1Float4 infinity = m1Set4(HUGE_VALF);
+    const Mach1Float4 negInfinity = m1Set4(-HUGE_VALF);
+
+    const int count = boxes.size();
+    Mach1OrientedBox4 box;
+
+    for (int start = 0; start < count; start += 4) {
+        const int lanes = std::min(4, count - start);
+        LoadBoxes(boxes, start, lanes, box);
+
+        Mach1Float4 vectorX = m1Sub4(originX, box.centerX);
+        Mach1Float4 vectorY = m1Sub4(originY, box.centerY);
+        Mach1Float4 vectorZ = m1Sub4(originZ, box.centerZ);
+
+        // segment in box space, as in DoClipping()
+        Mach1Float4 localOrigin[3] = {
+            Dot4(vectorX, vectorY, vectorZ, box.axis0X, box.axis0Y, box.axis0Z),
+            Dot4(vectorX, vectorY, vectorZ, box.axis1X, box.axis1Y, box.axis1Z),
+            Dot4(vectorX, vectorY, vectorZ, box.axis2X, box.axis2Y, box.axis2Z),
+        };
+        Mach1Float4 localDirection[3] = {
+            Dot4(directionX, directionY, directionZ, box.axis0X, box.axis0Y, box.axis0Z),
+            Dot4(directionX, directionY, directionZ, box.axis1X, box.axis1Y, box.axis1Z),
+            Dot4(directionX, directionY, directionZ, box.axis2X, box.axis2Y, box.axis2Z),
+        };
+        Mach1Float4 extents[3] = {box.extentsX, box.extentsY, box.extentsZ};
+
+        Mach1Float4 tEnter = m1Set4(t0);
+        Mach1Float4 tExit = m1Set4(t1);
+
+        // slab test per axis; a segment parallel to a slab either spans all of t or none of it
+        for (int axis = 0; axis < 3; axis++) {
+            Mach1Float4 parallel = m1CmpLt4(m1Abs4(localDirection[axis]), epsilon);
+            Mach1Float4 denom = m1Select4(parallel, one, localDirection[axis]);
+
+            Mach1Float4 tA = m1Div4(m1Sub4(m1Sub4(zero, extents[axis]), localOrigin[axis]), denom);
+            Mach1Float4 tB = m1Div4(m1Sub4(extents[axis], localOrigin[axis]), denom);
+
+            Mach1Float4 insideSlab = m1And4(m1CmpLe4(m1Sub4(zero, extents[axis]), localOrigin[axis]), m1CmpLe4(localOrigin[axis], extents[axis]));
+            Mach1Float4 parallelNear = m1Select4(insideSlab, negInfinity, infinity);
+            Mach1Float4 parallelFar = m1Select4(insideSlab, infinity, negInfinity);
+
+            tEnter = m1Max4(tEnter, m1Select4(parallel, parallelNear, m1Min4(tA, tB)));
+            tExit = m1Min4(tExit, m1Select4(parallel, parallelFar, m1Max4(tA, tB)));
+        }
+
+        if (enterT) {
+            StoreLanes(enterT, start, lanes, tEnter);
+        }
+        if (exitT) {
+            StoreLanes(exitT, start, lanes, tExit);
+        }
+        if (hitMask) {
+            StoreMaskLanes(hitMask, start, lanes, m1MoveMask4(m1CmpLe4(tEnter, tExit)));
+        }
+    }
+}
+
+glm::vec3 Mach1DecodePositionalCore::GetRightVector() {
+    return glm::vec3(1, 0, 0);
+}
+
+glm::vec3 Mach1DecodePositionalCore::GetUpVector() {
+    return glm::vec3(0, 1, 0);
+}
+
+glm::vec3 Mach1DecodePositionalCore::GetForwardVector() {
+    return glm::vec3(0, 0, 1);
+}
+
+Mach1DecodePositionalCore::Mach1DecodePositionalCore() {
+    falloffCurve = 1;
+
+    ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+    timeLastCalculation = 0;
+
+    setDecodeMode(Mach1DecodeMode::M1DecodeSpatial_8);
+}
+
+void Mach1DecodePositionalCore::reset() {
+    mach1Decode.reset();
+
+    // the defaults of the member initializers and the constructor
+    useFalloff = false;
+    falloffCurve = 1;
+
+    attenuationModel = Mach1AttenuationCurve;
+    attenuationMinDistance = 1;
+    attenuationMaxDistance = 1000;
+    attenuationRolloff = 1;
+    attenuationGain = 1;
+    attenuationTableMinDistance = 0;
+    attenuationTableMaxDistance = 0;
+    hasAttenuationTable = false;
+    occlusionGain = 1;
+
+    muteWhenInsideObject = false;
+    muteWhenOutsideObject = false;
+    useClosestPointRotationMuteInside = false;
+
+    useYawForRotation = true;
+    usePitchForRotation = true;
+    useRollForRotation = true;
+
+    cameraPosition = glm::vec3();
+    cameraRotation = glm::quat();
+    soundPosition = glm::vec3();
+    soundRotation = glm::quat();
+    soundScale = glm::vec3();
+
+    gain = 0;
+    dist = 0;
+    eulerAngles = glm::vec3();
+    eulerAnglesCube = glm::vec3();
+    closestPointOnPlane = glm::vec3();
+
+    deterministic = false;
+    manualTime = 0;
+
+    ms = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+    timeLastCalculation = 0;
+
+    std::fill(coeffs.begin(), coeffs.end(), 0.0f);
+    setDecodeMode(Mach1DecodeMode::M1DecodeSpatial_8);
+}
+
+void Mach1DecodePositionalCore::setDecodeMode(Mach1DecodeMode mode) {
+    decodeMode = mode;
+    mach1Decode.setDecodeMode(decodeMode);
+    coeffs.resize(mach1Decode.getFormatCoeffCount(), 0.0f);
+}
+
+void Mach1DecodePositionalCore::setReducedDecodeMode(Mach1DecodeMode mode) {
+    mach1Decode.setReducedDecodeMode(mode);
+}
+
+void Mach1DecodePositionalCore::setPlatformType(Mach1PlatformType type) {
+    platformType = type;
+    mach1Decode.setPlatformType(Mach1PlatformType::Mach1PlatformDefault); // because rotation is already converted by positional
+}
+
+void Mach1DecodePositionalCore::setAttenuationCurve(float attenuationCurve) {
+    this->falloffCurve = attenuationCurve;
+}
+
+void Mach1DecodePositionalCore::setAttenuationModel(Mach1AttenuationModel model) {
+    this->attenuationModel = model;
+}
+
+void Mach1DecodePositionalCore::setAttenuationRange(float minDistance, float maxDistance) {
+    this->attenuationMinDistance = (std::max)(minDistance, 1e-6f);
+    this->attenuationMaxDistance = (std::max)(maxDistance, this->attenuationMinDistance);
+}
+
+void Mach1DecodePositionalCore::setAttenuationRolloff(float rolloff) {
+    this->attenuationRolloff = (std::max)(rolloff, 0.0f);
+}
+
+bool Mach1DecodePositionalCore::setAttenuationTable(const float *distances, const float *gains, int count) {
+    if (distances == nullptr || gains == nullptr || count < 1) {
+        return false;
+    }
+
+    // an unsorted table would silently interpolate between the wrong points, keep the previous one instead
+    for (int i = 1; i < count; i++) {
+        if (!(distances[i] > distances[i - 1])) {
+            return false;
+        }
+    }
+
+    attenuationTableMinDistance = distances[0];
+    attenuationTableMaxDistance = distances[count - 1];
+
+    // bake the piecewise linear points (sorted by distance) into the uniform LUT
+    int segment = 0;
+    for (int i = 0; i < M1_ATTENUATION_TABLE_SIZE; i++) {
+        float d = attenuationTableMinDistance + (attenuationTableMaxDistance - attenuationTableMinDistance) * i / (M1_ATTENUATION_TABLE_SIZE - 1);
+
+        while (segment < count - 2 && d > distances[segment + 1]) {
+            segment++;
+        }
+
+        if (count == 1) {
+            attenuationTable[i] = gains[0];
+        } else {
+            float span = distances[segment + 1] - distances[segment];
+            float t = span > 0 ? M1DecodeCore::clamp((d - distances[segment]) / span, 0, 1) : 1;
+            attenuationTable[i] = gains[segment] + (gains[segment + 1] - gains[segment]) * t;
+        }
+    }
+    hasAttenuationTable = true;
+    return true;
+}
+
+float Mach1DecodePositionalCore::getAttenuationGain() {
+    return attenuationGain;
+}
+
+void Mach1DecodePositionalCore::setOcclusionGain(float _occlusionGain) {
+    occlusionGain = std::max(0.0f, std::min(1.0f, _occlusionGain));
+}
+
+float Mach1DecodePositionalCore::getOcclusionGain() {
+    return occlusionGain;
+}
+
+float Mach1DecodePositionalCore::evaluateAttenuation(float distance) {
+    switch (attenuationModel) {
+    case Mach1AttenuationInverse: {
+        float d = M1DecodeCore::clamp(distance, attenuationMinDistance, attenuationMaxDistance);
+        return attenuationMinDistance / (attenuationMinDistance + attenuationRolloff * (d - attenuationMinDistance));
+    }
+
+    case Mach1AttenuationLinear: {
+        float d = M1DecodeCore::clamp(distance, attenuationMinDistance, attenuationMaxDistance);
+        float range = attenuationMaxDistance - attenuationMinDistance;
+        return range > 0 ? M1DecodeCore::clamp(1 - attenuationRolloff * (d - attenuationMinDistance) / range, 0, 1) : 1;
+    }
+
+    case Mach1AttenuationExponential: {
+        float d = M1DecodeCore::clamp(distance, attenuationMinDistance, attenuationMaxDistance);
+        return deterministic ? m1DetPow(d / attenuationMinDistance, -attenuationRolloff) : powf(d / attenuationMinDistance, -attenuationRolloff);
+    }
+
+    case Mach1AttenuationTable: {
+        if (!hasAttenuationTable) {
+            return 1;
+        }
+        float range = attenuationTableMaxDistance - attenuationTableMinDistance;
+        float position = range > 0 ? M1DecodeCore::clamp((distance - attenuationTableMinDistance) / range, 0, 1) * (M1_ATTENUATION_TABLE_SIZE - 1) : 0;
+        int index = (int)position;
+        if (index >= M1_ATTENUATION_TABLE_SIZE - 1) {
+            return attenuationTable[M1_ATTENUATION_TABLE_SIZE - 1];
+        }
+        float t = position - index;
+        return attenuationTable[index] + (attenuationTable[index + 1] - attenuationTable[index]) * t;
+    }
+
+    case Mach1AttenuationCurve:
+    default:
+        return falloffCurve;
+    }
+}
+
+void Mach1DecodePositionalCore::setMuteWhenOutsideObject(bool _muteWhenOutsideObject) {
+    this->muteWhenOutsideObject = _muteWhenOutsideObject;
+}
+
+void Mach1DecodePositionalCore::setMuteWhenInsideObject(bool _muteWhenInsideObject) {
+    this->muteWhenOutsideObject = _muteWhenInsideObject;
+}
+
+void Mach1DecodePositionalCore::setUseAttenuation(bool useAttenuation) {
+    this->useFalloff = useAttenuation;
+}
+
+void Mach1DecodePositionalCore::setUsePlaneCalculation(bool usePlaneCalculation) {
+    this->useClosestPointRotationMuteInside = usePlaneCalculation;
+}
+
+void Mach1DecodePositionalCore::setUseYawForRotation(bool _useYawForRotation) {
+    this->useYawForRotation = _useYawForRotation;
+}
+
+void Mach1DecodePositionalCore::setUsePitchForRotation(bool _usePitchForRotation) {
+    this->usePitchForRotation = _usePitchForRotation;
+}
+
+void Mach1DecodePositionalCore::setUseRollForRotation(bool _useRollForRotation) {
+    this->useRollForRotation = _useRollForRotation;
+}
+
+void Mach1DecodePositionalCore::setListenerPosition(Mach1Point3D *pos) {
+    ConvertPositionToMach1(platformType, &pos->x, &pos->y, &pos->z);
+    cameraPosition = glm::vec3(pos->x, pos->y, pos->z);
+}
+
+void Mach1DecodePositionalCore::setListenerRotation(Mach1Point3D *euler) {
+    Mach1Point3D angle = {euler->x, euler->y, euler->z};
+    M1DecodeCore::convertAnglesToMach1(platformType, &angle.x, &angle.y, &angle.z);
+    cameraRotation = EulerToQuaternion(glm::vec3(angle.x, angle.y, angle.z) * DEG_TO_RAD_F, deterministic);
+}
+
+void Mach1DecodePositionalCore::setListenerRotationQuat(Mach1Point4D *quat) {
+    cameraRotation = glm::quat(quat->w, quat->x, quat->y, quat->z);
+}
+
+void Mach1DecodePositionalCore::setDecoderAlgoPosition(Mach1Point3D *pos) {
+    ConvertPositionToMach1(platformType, &pos->x, &pos->y, &pos->z);
+    soundPosition = glm::vec3(pos->x, pos->y, pos->z);
+}
+
+void Mach1DecodePositionalCore::setDecoderAlgoRotation(Mach1Point3D *euler) {
+    Mach1Point3D angle = {euler->x, euler->y, euler->z};
+    M1DecodeCore::convertAnglesToMach1(platformType, &angle.x, &angle.y, &angle.z);
+    soundRotation = EulerToQuaternion(glm::vec3(angle.x, angle.y, angle.z) * DEG_TO_RAD_F, deterministic);
+}
+
+void Mach1DecodePositionalCore::setDecoderAlgoRotationQuat(Mach1Point4D *quat) {
+    soundRotation = glm::quat(quat->w, quat->x, quat->y, quat->z);
+}
+
+void Mach1DecodePositionalCore::setDecoderAlgoScale(Mach1Point3D *scale) {
+    soundScale = glm::vec3(scale->x, scale->y, scale->z);
+}
+
+void Mach1DecodePositionalCore::evaluatePositionResults() {
+    long tStart = getCurrentTime();
+
+    gain = 1.0f;
+    dist = 0;
+    attenuationGain = 1.0f;
+
+    // Find closest point
+    glm::vec3 point = soundPosition;
+
+    glm::vec3 outsideClosestPoint;
+    // glm::vec3 insidePoint0, insidePoint1;
+
+    glm::vec3 soundRightVector = soundRotation * GetRightVector();     // glm::vec3(1, 0, 0);// GetRightVector(); // right
+    glm::vec3 soundUpVector = soundRotation * GetUpVector();           // glm::vec3(0, 1, 0); // up
+    glm::vec3 soundForwardVector = soundRotation * GetForwardVector(); // glm::vec3(0, 0, 1); // forward
+
+    bool isOutside = (ClosestPointOnBox(cameraPosition, soundPosition, soundRightVector, soundUpVector, soundForwardVector, soundScale / 2.0f, outsideClosestPoint) > 0);
+    bool hasSoundOutside = isOutside && !muteWhenOutsideObject;
+    bool hasSoundInside = !isOutside && !muteWhenInsideObject;
+
+    if (hasSoundOutside && useClosestPointRotationMuteInside) // useClosestPointRotation
+    {
+        point = outsideClosestPoint;
+
+        dist = glm::distance(cameraPosition, point);
+
+        if (useFalloff) {
+            attenuationGain = evaluateAttenuation(dist);
+            gain = gain * attenuationGain;
+        }
+    } else if (hasSoundOutside || hasSoundInside) // useCenterPointRotation
+    {
+        dist = glm::distance(cameraPosition, point);
+
+        if (useFalloff) {
+            if (hasSoundOutside) {
+                attenuationGain = evaluateAttenuation(dist);
+                gain = gain * attenuationGain;
+            }
+        }
+    } else {
+        gain = 0;
+    }
+    gain = gain * occlusionGain;
+
+    closestPointOnPlane = point;
+    glm::vec3 dir = point - cameraPosition;
+
+    if (glm::length(dir) > 0) {
+        // Compute rotation for sound
+        // http://www.aclockworkberry.com/world-coordinate-systems-in-3ds-max-unity-and-unreal-engine/
+        glm::quat quat;
+        quat = glm::quatLookAtLH(glm::normalize(dir), GetUpVector()) * glm::inverse(soundRotation);
+
+        glm::vec3 quatEulerAngles = QuaternionToEuler(glm::normalize(quat), deterministic);
+
+        bool useXForRotation = useYawForRotation;
+        bool useYForRotation = usePitchForRotation;
+        bool useZForRotation = useRollForRotation;
+
+        quat = EulerToQuaternion(glm::vec3(useXForRotation ? quatEulerAngles.x : 0, useYForRotation ? quatEulerAngles.y : 0, useZForRotation ? quatEulerAngles.z : 0), deterministic);
+        eulerAnglesCube = QuaternionToEuler(glm::normalize(quat), deterministic) * RAD_TO_DEG_F;
+
+        quat = glm::inverse(quat) * cameraRotation; // * glm::inverse(soundRotation);
+        eulerAngles = QuaternionToEuler(glm::normalize(quat), deterministic) * RAD_TO_DEG_F;
+
+        // SoundAlgorithm
+        mach1Decode.setRotationDegrees(Mach1Point3D{eulerAngles.x, eulerAngles.y, eulerAngles.z});
+        coeffs = mach1Decode.decodeCoeffs(0, 0);
+    } else {
+        // Fixed zero distance
+        eulerAngles = glm::vec3(0, 0, 0);
+
+        for (int i = 0; i < coeffs.size(); i++) {
+            coeffs[i] = 0;
+        }
+        gain = 0;
+    }
+    timeLastCalculation = getCurrentTime() - tStart;
+}
+
+void Mach1DecodePositionalCore::getCoefficients(float *result) {
+    for (int i = 0; i < coeffs.size(); i++) {
+        result[i] = gain * coeffs[i];
+    }
+}
+
+int Mach1DecodePositionalCore::getFormatChannelCount() {
+    return mach1Decode.getFormatChannelCount();
+}
+
+int Mach1DecodePositionalCore::getFormatCoeffCount() {
+    return mach1Decode.getFormatCoeffCount();
+}
+
+Mach1Point3D Mach1DecodePositionalCore::getCurrentAngle() {
+    glm::vec3 angle = eulerAngles;
+    M1DecodeCore::convertAnglesToPlatform(platformType, &angle.x, &angle.y, &angle.z);
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
+
+Mach1Point3D Mach1DecodePositionalCore::getCurrentAngleInternal() {
+    return Mach1Point3D{eulerAngles.x, eulerAngles.y, eulerAngles.z};
+}
+
+Mach1Point3D Mach1DecodePositionalCore::getPositionalRotation() {
+    glm::vec3 angle = eulerAnglesCube;
+    M1DecodeCore::convertAnglesToPlatform(platformType, &angle.x, &angle.y, &angle.z);
+    return Mach1Point3D{angle.x, angle.y, angle.z};
+}
+
+Mach1Point3D Mach1DecodePositionalCore::getClosestPointOnPlane() {
+    glm::vec3 p = closestPointOnPlane;
+    ConvertPositionToPlatform(platformType, &p.x, &p.y, &p.z);
+    return Mach1Point3D{p.x, p.y, p.z};
+}
+
+float Mach1DecodePositionalCore::getDist() {
+    return dist;
+}
+
+void Mach1DecodePositionalCore::setFilterSpeed(float filterSpeed) {
+    mach1Decode.setFilterSpeed(filterSpeed);
+}
+
+void Mach1DecodePositionalCore::setCoeffReuseThreshold(float thresholdDegrees) {
+    mach1Decode.setCoeffReuseThreshold(thresholdDegrees);
+}
+
+float Mach1DecodePositionalCore::getCoeffReuseRate() {
+    return mach1Decode.getCoeffReuseRate();
+}
+
+void Mach1DecodePositionalCore::setDeterministic(bool enable) {
+    deterministic = enable;
+    mach1Decode.setDeterministic(enable);
+}
+
+bool Mach1DecodePositionalCore::getDeterministic() {
+    return deterministic;
+}
+
+void Mach1DecodePositionalCore::setManualTime(long milliseconds) {
+    manualTime = milliseconds;
+    mach1Decode.setManualTime(milliseconds);
+}
+
+long Mach1DecodePositionalCore::getCurrentTime() {
+    if (deterministic) {
+        return manualTime;
+    }
+    return (long)(duration_cast<milliseconds>(system_clock::now().time_since_epoch()) - ms).count();
+}
+
+long Mach1DecodePositionalCore::getLastCalculationTime() {
+    return timeLastCalculation;
+}
+
+M1_DETERMINISTIC_FP_END
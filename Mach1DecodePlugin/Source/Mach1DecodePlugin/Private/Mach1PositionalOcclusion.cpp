@@ -0,0 +1,94 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+#include "Mach1PositionalOcclusion.h"
+#include <algorithm>
+
+Mach1PositionalOcclusion::Mach1PositionalOcclusion(float cellSize) : index(cellSize) {
+}
+
+int Mach1PositionalOcclusion::addOccluder(glm::vec3 center, glm::quat rotation, glm::vec3 scale, float transmission) {
+    int handle = index.insert(center, Mach1PositionalSpatialIndex::OrientedBoxHalfExtents(rotation, scale));
+
+    // handles are recycled by the index, so the box columns only grow to the peak occluder count
+    if (handle >= occluders.size()) {
+        occluders.resize(handle + 1);
+        transmissions.resize(handle + 1, 1.0f);
+    }
+    occluders.setBox(handle, center, rotation, scale);
+    setOccluderTransmission(handle, transmission);
+
+    return handle;
+}
+
+void Mach1PositionalOcclusion::updateOccluder(int handle, glm::vec3 center, glm::quat rotation, glm::vec3 scale) {
+    if (handle < 0 || handle >= occluders.size())
+        return;
+
+    index.update(handle, center, Mach1PositionalSpatialIndex::OrientedBoxHalfExtents(rotation, scale));
+    occluders.setBox(handle, center, rotation, scale);
+}
+
+void Mach1PositionalOcclusion::setOccluderTransmission(int handle, float transmission) {
+    if (handle < 0 || handle >= (int)transmissions.size())
+        return;
+
+    transmissions[handle] = std::max(0.0f, std::min(1.0f, transmission));
+}
+
+void Mach1PositionalOcclusion::removeOccluder(int handle) {
+    index.remove(handle);
+}
+
+void Mach1PositionalOcclusion::clear() {
+    index.clear();
+    occluders.resize(0);
+    transmissions.clear();
+}
+
+int Mach1PositionalOcclusion::getOccluderCount() const {
+    return index.getCount();
+}
+
+float Mach1PositionalOcclusion::evaluate(glm::vec3 listener, glm::vec3 emitter) {
+    float occlusionFactor = 1.0f;
+    evaluate(listener, &emitter, 1, &occlusionFactor);
+    return occlusionFactor;
+}
+
+void Mach1PositionalOcclusion::evaluate(glm::vec3 listener, const glm::vec3 *emitters, int count, float *occlusionFactors) {
+    for (int i = 0; i < count; i++) {
+        glm::vec3 direction = emitters[i] - listener;
+
+        // only occluders overlapping the segment's bounding sphere can be crossed
+        candidates.clear();
+        index.query(listener + direction * 0.5f, glm::length(direction) * 0.5f, candidates);
+        if (candidates.empty()) {
+            occlusionFactors[i] = 1.0f;
+            continue;
+        }
+
+        int candidateCount = (int)candidates.size();
+        candidateBoxes.resize(candidateCount);
+        hits.resize(candidateCount);
+        for (int c = 0; c < candidateCount; c++) {
+            candidateBoxes.copyBox(c, occluders, candidates[c]);
+        }
+
+        Mach1DecodePositionalCore::ClipSegmentAgainstBoxes(listener, direction, 0.0f, 1.0f, candidateBoxes, nullptr, nullptr, hits.data());
+
+        float occlusionFactor = 1.0f;
+        for (int c = 0; c < candidateCount; c++) {
+            if (hits[c]) {
+                occlusionFactor *= transmissions[candidates[c]];
+            }
+        }
+        occlusionFactors[i] = occlusionFactor;
+    }
+}
@@ -0,0 +1,219 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+#include "Mach1PositionalSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+Mach1PositionalSpatialIndex::Mach1PositionalSpatialIndex(float _cellSize) {
+    cellSize = _cellSize > 0 ? _cellSize : 1.0f;
+    activeCount = 0;
+}
+
+int64_t Mach1PositionalSpatialIndex::cellKey(int x, int y, int z) const {
+    // 21 bits per axis
+    const int64_t mask = (1 << 21) - 1;
+    return ((int64_t)(x & mask) << 42) | ((int64_t)(y & mask) << 21) | (int64_t)(z & mask);
+}
+
+glm::ivec3 Mach1PositionalSpatialIndex::cellCoord(glm::vec3 position) const {
+    return glm::ivec3((int)floorf(position.x / cellSize), (int)floorf(position.y / cellSize), (int)floorf(position.z / cellSize));
+}
+
+bool Mach1PositionalSpatialIndex::fitsCell(glm::vec3 halfExtents) const {
+    float maxHalfExtent = std::max(halfExtents.x, std::max(halfExtents.y, halfExtents.z));
+    return maxHalfExtent <= cellSize * 0.5f;
+}
+
+void Mach1PositionalSpatialIndex::link(int handle) {
+    Entry &entry = entries[handle];
+    entry.oversized = !fitsCell(entry.halfExtents);
+    if (entry.oversized) {
+        entry.slot = (int)oversized.size();
+        oversized.push_back(handle);
+    } else {
+        glm::ivec3 coord = cellCoord(entry.center);
+        entry.cell = cellKey(coord.x, coord.y, coord.z);
+        std::vector<int> &bucket = cells[entry.cell];
+        entry.slot = (int)bucket.size();
+        bucket.push_back(handle);
+    }
+}
+
+void Mach1PositionalSpatialIndex::unlink(int handle) {
+    Entry &entry = entries[handle];
+    std::vector<int> *bucket = &oversized;
+    std::unordered_map<int64_t, std::vector<int>>::iterator it;
+    if (!entry.oversized) {
+        it = cells.find(entry.cell);
+        bucket = &it->second;
+    }
+
+    // swap-remove, keeping the moved entry's slot in sync
+    int last = bucket->back();
+    (*bucket)[entry.slot] = last;
+    entries[last].slot = entry.slot;
+    bucket->pop_back();
+
+    if (!entry.oversized && bucket->empty()) {
+        cells.erase(it);
+    }
+}
+
+void Mach1PositionalSpatialIndex::setCellSize(float _cellSize) {
+    if (_cellSize <= 0 || _cellSize == cellSize)
+        return;
+
+    cellSize = _cellSize;
+    cells.clear();
+    oversized.clear();
+    for (int i = 0; i < (int)entries.size(); i++) {
+        if (entries[i].active) {
+            link(i);
+        }
+    }
+}
+
+float Mach1PositionalSpatialIndex::getCellSize() const {
+    return cellSize;
+}
+
+int Mach1PositionalSpatialIndex::insert(glm::vec3 center, glm::vec3 halfExtents) {
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = (int)entries.size();
+        entries.push_back(Entry());
+    }
+
+    Entry &entry = entries[handle];
+    entry.center = center;
+    entry.halfExtents = glm::abs(halfExtents);
+    entry.active = true;
+    link(handle);
+
+    activeCount++;
+    return handle;
+}
+
+void Mach1PositionalSpatialIndex::update(int handle, glm::vec3 center, glm::vec3 halfExtents) {
+    if (handle < 0 || handle >= (int)entries.size() || !entries[handle].active)
+        return;
+
+    Entry &entry = entries[handle];
+    halfExtents = glm::abs(halfExtents);
+
+    // most moves stay inside the same cell: only the stored bounds change
+    bool oversizedNow = !fitsCell(halfExtents);
+    if (oversizedNow == entry.oversized) {
+        if (oversizedNow) {
+            entry.center = center;
+            entry.halfExtents = halfExtents;
+            return;
+        }
+        glm::ivec3 coord = cellCoord(center);
+        if (cellKey(coord.x, coord.y, coord.z) == entry.cell) {
+            entry.center = center;
+            entry.halfExtents = halfExtents;
+            return;
+        }
+    }
+
+    unlink(handle);
+    entry.center = center;
+    entry.halfExtents = halfExtents;
+    link(handle);
+}
+
+void Mach1PositionalSpatialIndex::remove(int handle) {
+    if (handle < 0 || handle >= (int)entries.size() || !entries[handle].active)
+        return;
+
+    unlink(handle);
+    entries[handle].active = false;
+    freeHandles.push_back(handle);
+    activeCount--;
+}
+
+void Mach1PositionalSpatialIndex::clear() {
+    entries.clear();
+    freeHandles.clear();
+    cells.clear();
+    oversized.clear();
+    activeCount = 0;
+}
+
+bool Mach1PositionalSpatialIndex::overlapsSphere(const Entry &entry, glm::vec3 position, float radiusSquared) {
+    glm::vec3 delta = glm::max(glm::abs(position - entry.center) - entry.halfExtents, glm::vec3(0.0f));
+    return glm::dot(delta, delta) <= radiusSquared;
+}
+
+int Mach1PositionalSpatialIndex::query(glm::vec3 position, float radius, std::vector<int> &results) const {
+    const size_t initialSize = results.size();
+    const float radiusSquared = radius * radius;
+
+    for (int handle : oversized) {
+        if (overlapsSphere(entries[handle], position, radiusSquared)) {
+            results.push_back(handle);
+        }
+    }
+
+    // cells whose loose bounds (half a cell of margin) touch the query sphere
+    float reach = radius + cellSize * 0.5f;
+    glm::ivec3 lo = cellCoord(position - glm::vec3(reach));
+    glm::ivec3 hi = cellCoord(position + glm::vec3(reach));
+    glm::ivec3 span = hi - lo + glm::ivec3(1);
+    double cellRange = (double)span.x * span.y * span.z;
+
+    if (cellRange > (double)cells.size()) {
+        // sparse grid: cheaper to walk the occupied cells than the whole range
+        for (const auto &cell : cells) {
+            for (int handle : cell.second) {
+                if (overlapsSphere(entries[handle], position, radiusSquared)) {
+                    results.push_back(handle);
+                }
+            }
+        }
+    } else {
+        for (int x = lo.x; x <= hi.x; x++) {
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int z = lo.z; z <= hi.z; z++) {
+                    auto it = cells.find(cellKey(x, y, z));
+                    if (it == cells.end())
+                        continue;
+                    for (int handle : it->second) {
+                        if (overlapsSphere(entries[handle], position, radiusSquared)) {
+                            results.push_back(handle);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return (int)(results.size() - initialSize);
+}
+
+int Mach1PositionalSpatialIndex::getCount() const {
+    return activeCount;
+}
+
+int Mach1PositionalSpatialIndex::getOversizedCount() const {
+    return (int)oversized.size();
+}
+
+glm::vec3 Mach1PositionalSpatialIndex::OrientedBoxHalfExtents(glm::quat rotation, glm::vec3 scale) {
+    glm::vec3 halfExtents = scale / 2.0f;
+    glm::vec3 axis0 = glm::abs(rotation * glm::vec3(1, 0, 0)) * halfExtents.x;
+    glm::vec3 axis1 = glm::abs(rotation * glm::vec3(0, 1, 0)) * halfExtents.y;
+    glm::vec3 axis2 = glm::abs(rotation * glm::vec3(0, 0, 1)) * halfExtents.z;
+    return axis0 + axis1 + axis2;
+}
@@ -6,12 +6,14 @@
 
 #include "Mach1Decode.h"
 #include "Mach1DecodePositional.h"
+#include "Curves/CurveFloat.h"
 #include <sstream>
 
 #ifndef SMALL_NUMBER
     #define SMALL_NUMBER 0
 #endif
 #define MIN_SOUND_VOLUME (SMALL_NUMBER*2) // used if you want to make sure components never go silent and are restarted by UE
+#define DEVIRTUALIZE_FADE_DURATION 0.05f // fade applied when virtualized voices restart, hides the restart click
 
 class M1Common {
 public:
@@ -45,4 +47,46 @@ public:
 	{
 		return Mach1Point4D{ (float)quat.X, (float)quat.Y, (float)quat.Z, (float)quat.W };
 	}
+
+#if WITH_EDITOR
+	// Changes whenever a key of the curve is added, removed or edited, so a baked table can be refreshed without a change notification
+	static uint32 GetAttenuationCurveHash(UCurveFloat* curve)
+	{
+		uint32 hash = 0;
+		for (const FRichCurveKey& key : curve->FloatCurve.GetConstRefOfKeys())
+		{
+			hash = HashCombine(hash, GetTypeHash(key.Time));
+			hash = HashCombine(hash, GetTypeHash(key.Value));
+			hash = HashCombine(hash, GetTypeHash(key.ArriveTangent));
+			hash = HashCombine(hash, GetTypeHash(key.LeaveTangent));
+			hash = HashCombine(hash, GetTypeHash((uint8)key.InterpMode | ((uint8)key.TangentMode << 4)));
+		}
+		return hash;
+	}
+#endif
+
+	// Bakes the curve (distance -> gain) into the decoder's attenuation table so falloff is evaluated inside evaluatePositionResults()
+	static void BakeAttenuationCurve(UCurveFloat* curve, Mach1DecodePositional& positional, int numPoints = 64)
+	{
+		float minDistance = 0, maxDistance = 0;
+		curve->GetTimeRange(minDistance, maxDistance);
+		if (maxDistance <= minDistance)
+		{
+			numPoints = 1; // single key, the table needs strictly increasing distances
+		}
+
+		std::vector<float> distances(numPoints);
+		std::vector<float> gains(numPoints);
+		for (int i = 0; i < numPoints; i++)
+		{
+			distances[i] = numPoints > 1 ? FMath::Lerp(minDistance, maxDistance, (float)i / (numPoints - 1)) : minDistance;
+			gains[i] = curve->GetFloatValue(distances[i]);
+		}
+
+		if (!positional.setAttenuationTable(distances, gains))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Mach1: attenuation curve %s could not be baked, its keys are not in increasing distance order"), *curve->GetName());
+		}
+		positional.setAttenuationModel(Mach1AttenuationTable);
+	}
 };
@@ -11,6 +11,11 @@
 #include "Camera/CameraComponent.h"
 
 #include "M1Common.h"
+#include "M1DecodeLOD.h"
+#include "M1DecodeSourceEffect.h"
+#include "M1DecodeSyncStart.h"
+#include "M1DecodeVoices.h"
+#include "M1ListenerBinding.h"
 #include "Mach1Decode.h"
 #include "Mach1DecodePositional.h"
 
@@ -19,6 +24,8 @@
 #include "M1DecodeComponent.generated.h"
 
 class ACameraActor;
+struct FM1ListenerFrame;
+struct FM1VolumeBatch;
 
 //#define LEGACY_POSITIONAL
 
@@ -31,6 +38,15 @@ enum EMach1DecodeModeComponent
 	Mach1DecodeMode_Spatial_14_Component = 2 UMETA(DisplayName = "Spatial 14-Channel")
 };
 
+// Level of detail a decoder runs at, picked from listener distance and decoded gain
+UENUM(BlueprintType)
+enum EMach1DecodeLODComponent
+{
+	Mach1DecodeLOD_Full_Component = 0 	UMETA(DisplayName = "Full"),
+	Mach1DecodeLOD_Reduced_Component = 1 	UMETA(DisplayName = "Reduced"),
+	Mach1DecodeLOD_Virtual_Component = 2 	UMETA(DisplayName = "Virtual")
+};
+
 UCLASS(BlueprintType, Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class MACH1DECODEPLUGIN_API UM1DecodeComponent : public USceneComponent
 {
@@ -73,8 +89,36 @@ protected:
 	void SetupIndividualChannelPlayback();
 	void SetVolumeIndividualChannels(float masterGain);
 
+	// Set by ApplyDecodeGains() for the duration of one SetVolumeMain()
+	FM1VolumeBatch* PendingVolumeBatch = nullptr;
+
+	// Single-voice bed, synchronized start and channel volume updates, shared with AM1DecodeActor
+	UPROPERTY(Transient)
+		FM1DecodeVoices decodeVoices;
+
+	bool UsesSingleVoiceDecode();
+	void InitIndividualChannels();
+	void SetupSingleVoicePlayback();
+
+	// Attenuation curve currently baked into m1Positional's attenuation table
+	UCurveFloat* bakedAttenuationCurve = nullptr;
+	uint32 bakedAttenuationCurveHash = 0;
+	bool isAttenuationBaked = false;
+	void UpdateAttenuationModel();
+
 	Mach1DecodePositional m1Positional;
 
+	// Camera of manualPawn when useManualPawnCamera is set, resolved once instead of scanning its components every tick
+	FM1ListenerBinding listenerBinding;
+
+	// Set by EvaluateDecode() once GainCoeffs hold gains not yet pushed to the audio components
+	bool hasPendingGains = false;
+
+	// Level of detail, playback position and virtualization, the same state machine as AM1DecodeActor
+	FM1DecodeLOD decodeLOD;
+	void AdvancePlaybackTime(double audioTime);
+	void UpdateVirtualization(const FM1DecodeLODSettings& lodSettings, float deltaSeconds);
+
 public:
 	// Sets default values for this component's properties
 	UM1DecodeComponent();
@@ -84,9 +128,29 @@ public:
 	// Called when the game starts or when spawned
 	void BeginPlay(); // overriden
 
-	// Called every frame
+	// Called when removed from the world
+	void EndPlay(const EEndPlayReason::Type EndPlayReason); // overriden
+
+	// Called every frame, only while not registered with UM1DecodeWorldSubsystem
 	void TickComponent(float DeltaSeconds, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction); // overriden
 
+	// Per-frame decode, driven by UM1DecodeWorldSubsystem: evaluate against the shared listener, then push gains
+	void EvaluateDecode(const FM1ListenerFrame& Listener);
+	// Channel volumes go into VolumeBatch when given, sent by the caller once for every decoder
+	void ApplyDecodeGains(FM1VolumeBatch* VolumeBatch = nullptr);
+
+	// Listener distance beyond which EvaluateCulled() can stand in for EvaluateDecode(), 0 when this decoder
+	// does not use LOD or does not hear from the shared listener camera
+	float GetCullDistance(const FM1ListenerFrame& Listener);
+	// EvaluateDecode() of a decoder known to be beyond its cull distance: virtual LOD, only playback time advances
+	void EvaluateCulled(const FM1ListenerFrame& Listener);
+
+	// Stop every voice that has a sound and queue it on SyncStart, so several decoders can share one synchronized start
+	void QueueSynchronizedStart(FM1DecodeSyncStart& SyncStart, float startTime, float fadeIn);
+
+	// Play() without starting: queue on SyncStart if initialized, otherwise play once initialized
+	void PlayWith(FM1DecodeSyncStart& SyncStart);
+
 	/** When true automatically get the orientation from the first indexed camera's rotations. When false automatically use the parent component's Position and Rotation. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Find PlayerPawn Camera and Attach Automatically")
 		bool AttachToPlayerPawnCamera = true;
@@ -105,6 +169,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Manual Reference Pawn")
 		APawn* manualPawn = nullptr;
 
+	/** Hear from the active camera of the Manual Reference Pawn instead of its control rotation and actor location. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Use Manual Reference Pawn Camera")
+		bool useManualPawnCamera = false;
+
 	/** Reference a manual Actor/Object instead of this Actor. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Manual Reference Actor")
 		AActor* manualActor = nullptr;
@@ -116,12 +184,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Display Debug")
 		bool Debug = false;
 
+	/** A channel's volume is only re-sent to its audio component once it differs from the last sent value by more than this many dB. 0 only skips unchanged gains. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Class Settings", DisplayName = "Volume Update Threshold (dB)", meta = (ClampMin = "0.0"))
+		float volumeUpdateThresholdDb = 0.05f;
+
 	// ========== FLEXIBLE DECODE CONFIGURATION ==========
 
 	/** Select the Mach1 decode mode */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Decode Configuration", DisplayName = "Decode Mode")
 		TEnumAsByte<EMach1DecodeModeComponent> DecodeMode = Mach1DecodeMode_Spatial_8_Component;
 
+	/** Play one multichannel bed as a single voice and decode it on the audio render thread instead of 2 voices per channel. Spatial 4 and Spatial 8 only, Spatial 14 falls back to the mono channels. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Decode Configuration", DisplayName = "Single-Voice Decode")
+		bool useSingleVoiceDecode = false;
+
+	/** Multichannel bed used by Single-Voice Decode, channel order matches Channel 1..N */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Decode Configuration", DisplayName = "Multichannel Bed", meta = (EditCondition = "useSingleVoiceDecode"))
+		USoundBase* MultichannelBed = nullptr;
+
 	// ========== INDIVIDUAL MONO CHANNEL INPUTS ==========
 	
 	/** Channel 1 - Used for all decode types */
@@ -211,6 +291,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
 		void RefreshDecodeConfiguration();
 
+	/** True while the voices are stopped by virtualization */
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		bool IsVirtualized();
+
+	/** Playback position in seconds, also followed while virtualized */
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		float GetPlaybackTime();
+
+	/** Level of detail the decoder currently runs at */
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		TEnumAsByte<EMach1DecodeLODComponent> GetCurrentLOD();
+
+	/** Number of per-channel volume updates skipped because the gain changed by less than the volume update threshold */
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		int GetSuppressedVolumeUpdateCount();
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Options", DisplayName = "Autoplay")
 		bool autoplay = false;
 
@@ -223,12 +319,57 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Options", DisplayName = "Fade Out Duration")
 		float fadeOutDuration = 0;
 
+	/** Lower the evaluation rate and decode mode of far or quiet decoders, and virtualize their voices when out of range */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Use LOD")
+		bool useLOD = false;
+
+	/** Listener distance beyond which the decoder evaluates every LOD Reduced Interval with the next lower decode mode (14 > 8 > 4) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Reduced Distance", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodReducedDistance = 2000;
+
+	/** Listener distance beyond which voices are virtualized while the decoder keeps tracking the listener every LOD Virtual Interval */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Virtual Distance", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodVirtualDistance = 8000;
+
+	/** Decoders whose loudest decoded channel is below this level are treated as virtual */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Quiet Threshold (dB)", meta = (EditCondition = "useLOD"))
+		float lodQuietThresholdDb = -60;
+
+	/** A quiet decoder only leaves virtual once its loudest channel is this many dB above the Quiet Threshold */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Quiet Hysteresis (dB)", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodQuietHysteresisDb = 6;
+
+	/** Seconds a decoder has to stay below the Quiet Threshold before it is virtualized for being quiet */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Quiet Hold Time", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodQuietHoldTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Reduced Interval", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodReducedInterval = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 LOD", DisplayName = "Virtual Interval", meta = (EditCondition = "useLOD", ClampMin = "0.0"))
+		float lodVirtualInterval = 0.5f;
+
+	/** Stop the voices once the decoded gain stays below the audibility threshold, and restart them in sync at the current playback position when audible again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Virtualization", DisplayName = "Use Virtualization")
+		bool useVirtualization = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Virtualization", DisplayName = "Audibility Threshold (dB)", meta = (EditCondition = "useVirtualization"))
+		float virtualizeThresholdDb = -60;
+
+	/** Seconds the decoder has to stay below the audibility threshold before its voices are stopped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Virtualization", DisplayName = "Virtualize Delay", meta = (EditCondition = "useVirtualization", ClampMin = "0.0"))
+		float virtualizeDelay = 1.0f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attenuation & Rotation Settings", DisplayName = "Use Attenuation")
 		bool useAttenuation = false;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attenuation & Rotation Settings", DisplayName = "Attenuation Curve")
 		UCurveFloat* attenuationCurve;
 
+	/** Scale the sound by the Transmission of every M1 Occluder box between the listener and this decoder */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attenuation & Rotation Settings", DisplayName = "Use Occlusion")
+		bool useOcclusion = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attenuation & Rotation Settings", DisplayName = "Mute When Inside Object")
 		bool muteWhenInsideObject = false;
 
@@ -0,0 +1,98 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "M1DecodeDebugSubsystem.generated.h"
+
+class UCanvas;
+class APlayerController;
+
+// Debug overlay is compiled out of shipping builds; call sites wrap their use in #if M1_DEBUG_OVERLAY
+#define M1_DEBUG_OVERLAY !UE_BUILD_SHIPPING
+
+// Capacity of the per-frame buffer, entries past it are dropped for that frame
+#define M1_DEBUG_OVERLAY_MAX_LINES 256
+#define M1_DEBUG_OVERLAY_LINE_LENGTH 256
+#define M1_DEBUG_OVERLAY_MAX_SHAPES 1024
+
+/*
+Collects the debug state of every AM1DecodeActor / UM1DecodeComponent with Debug enabled into a
+preallocated per-frame buffer, and draws it once per viewport through UDebugDrawService.
+Text is formatted in place with FCString::Snprintf, so recording a frame does not allocate.
+*/
+UCLASS()
+class MACH1DECODEPLUGIN_API UM1DecodeDebugSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+#if M1_DEBUG_OVERLAY
+	// Screen text, listed top to bottom in the order it was added this frame.
+	// Format stays a TCHAR array, as FCString::Snprintf requires, so it only takes TEXT() literals
+	template <int32 N, typename... Types>
+	void AddLine(const FColor& Color, const TCHAR (&Format)[N], Types... Args)
+	{
+		if (TCHAR* Text = AddLineBuffer(Color))
+		{
+			FCString::Snprintf(Text, M1_DEBUG_OVERLAY_LINE_LENGTH, Format, Args...);
+		}
+	}
+
+	// One line holding Label followed by every value with two decimals
+	void AddValues(const FColor& Color, const TCHAR* Label, const float* Values, int32 NumValues);
+
+	// World space shapes, projected onto the viewport when drawn
+	void AddSphere(const FVector& Center, float Radius, const FColor& Color);
+	void AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color);
+	void AddIndexLabel(const FVector& Location, int32 Index);
+
+	int32 GetDroppedCount() const { return DroppedCount; }
+#endif
+
+private:
+#if M1_DEBUG_OVERLAY
+	struct FLine
+	{
+		FColor Color;
+		TCHAR Text[M1_DEBUG_OVERLAY_LINE_LENGTH];
+	};
+
+	enum class EShape : uint8
+	{
+		Sphere,
+		Box,
+		IndexLabel
+	};
+
+	struct FShape
+	{
+		EShape Type;
+		FColor Color;
+		FVector Center;
+		FVector Extent; // X holds the radius of a sphere
+		FQuat Rotation;
+		int32 Index;
+	};
+
+	// Clears the buffer when the first entry of a new frame arrives
+	void BeginFrameIfNeeded();
+	TCHAR* AddLineBuffer(const FColor& Color);
+	FShape* AddShape(EShape Type, const FColor& Color);
+
+	void Draw(UCanvas* Canvas, APlayerController* PlayerController);
+
+	TArray<FLine> Lines;
+	TArray<FShape> Shapes;
+	uint64 BufferFrame = 0;
+	int32 DroppedCount = 0;
+	FDelegateHandle DrawHandle;
+#endif
+};
@@ -0,0 +1,110 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+#include "Mach1DecodePositional.h"
+
+class USoundBase;
+
+// Level of detail of a decoder, same values as EMach1DecodeLOD and EMach1DecodeLODComponent
+enum class EM1DecodeLODLevel : uint8
+{
+	Full = 0,
+	Reduced = 1,
+	Virtual = 2
+};
+
+// LOD and virtualization properties of the decoder that owns an FM1DecodeLOD
+struct FM1DecodeLODSettings
+{
+	bool UseLOD = false;
+	float ReducedDistance = 0;
+	float VirtualDistance = 0;
+	float QuietThresholdDb = 0;
+	float QuietHysteresisDb = 0;
+	float QuietHoldTime = 0;
+	float ReducedInterval = 0;
+	float VirtualInterval = 0;
+	bool UseVirtualization = false;
+	float VirtualizeThresholdDb = 0;
+	float VirtualizeDelay = 0;
+	// Decoder volume, scales the peak gain before the quiet and audibility tests
+	float Volume = 1;
+	// Decode mode of the bed, Reduced decodes one mode lower
+	int DecodeMode = 0;
+	bool Debug = false;
+
+	// Reads the properties AM1DecodeActor and UM1DecodeComponent both declare under these names
+	template <typename DecoderType>
+	static FM1DecodeLODSettings From(const DecoderType& Decoder)
+	{
+		FM1DecodeLODSettings Settings;
+		Settings.UseLOD = Decoder.useLOD;
+		Settings.ReducedDistance = Decoder.lodReducedDistance;
+		Settings.VirtualDistance = Decoder.lodVirtualDistance;
+		Settings.QuietThresholdDb = Decoder.lodQuietThresholdDb;
+		Settings.QuietHysteresisDb = Decoder.lodQuietHysteresisDb;
+		Settings.QuietHoldTime = Decoder.lodQuietHoldTime;
+		Settings.ReducedInterval = Decoder.lodReducedInterval;
+		Settings.VirtualInterval = Decoder.lodVirtualInterval;
+		Settings.UseVirtualization = Decoder.useVirtualization;
+		Settings.VirtualizeThresholdDb = Decoder.virtualizeThresholdDb;
+		Settings.VirtualizeDelay = Decoder.virtualizeDelay;
+		Settings.Volume = Decoder.Volume;
+		Settings.DecodeMode = static_cast<int>(Decoder.DecodeMode.GetValue());
+		Settings.Debug = Decoder.Debug;
+		return Settings;
+	}
+};
+
+/*
+Level of detail, playback position and virtualization of one decoder, shared by AM1DecodeActor and UM1DecodeComponent.
+Far or quiet decoders evaluate less often with a lower decode mode, and their voices are stopped while virtual
+or inaudible. The playback position keeps following audio time, so stopped voices restart where they would be.
+*/
+struct MACH1DECODEPLUGIN_API FM1DecodeLOD
+{
+	// Picks the LOD from the listener distance and the last peak gain, false while the decoder can keep its last gains
+	bool Update(const FM1DecodeLODSettings& Settings, float Distance, float DeltaSeconds, Mach1DecodePositional& Positional);
+
+	void SetLOD(EM1DecodeLODLevel InLOD, const FM1DecodeLODSettings& Settings, Mach1DecodePositional& Positional);
+
+	// Loudest of the decoded gains, tested against the quiet and audibility thresholds
+	void SetPeakGain(const TArray<float>& GainCoeffs);
+
+	void StartPlayback(float StartTime, double AudioTime);
+	void StopPlayback();
+	void SetPaused(bool Paused);
+	// Moves the playback position without restarting anything, e.g. a seek while virtualized
+	void SetPlaybackTime(float Time, double AudioTime);
+	// Advances by the audio time elapsed since the last call, so time dilation does not change the position;
+	// loops or ends on the duration of Sound
+	void AdvancePlaybackTime(double AudioTime, USoundBase* Sound);
+
+	// Calls StopVoices once the decoder is virtual or stays inaudible, RestartVoices(StartTime, FadeIn) once it is audible again
+	void UpdateVirtualization(const FM1DecodeLODSettings& Settings, float DeltaSeconds, TFunctionRef<void()> StopVoices, TFunctionRef<void(float, float)> RestartVoices);
+
+	EM1DecodeLODLevel GetLOD() const { return LOD; }
+	float GetPlaybackTime() const { return PlaybackTime; }
+	bool IsPlaybackStarted() const { return PlaybackStarted; }
+	bool IsVirtualized() const { return Virtualized; }
+
+private:
+	EM1DecodeLODLevel LOD = EM1DecodeLODLevel::Full;
+	float TimeSinceEvaluate = 0;
+	float QuietTime = 0;
+	float PeakGain = 1;
+	float InaudibleTime = 0;
+
+	float PlaybackTime = 0;
+	// Audio time of the last AdvancePlaybackTime()
+	double PlaybackAudioTime = 0;
+	bool PlaybackStarted = false;
+	bool PlaybackPaused = false;
+	bool Virtualized = false;
+};
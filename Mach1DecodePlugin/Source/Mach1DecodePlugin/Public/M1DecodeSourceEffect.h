@@ -0,0 +1,96 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sound/SoundEffectSource.h"
+
+#include <atomic>
+
+#include "M1DecodeSourceEffect.generated.h"
+
+// UE multichannel sound waves carry at most 8 channels, so Spatial_14 stays on the per-channel path
+#define M1_SINGLE_VOICE_MAX_CHANNELS 8
+
+/*
+Triple-buffered L/R gain handoff from the game thread to the audio render thread.
+Publish() never waits for the reader and Acquire() never waits for the writer; the reader
+always picks up the most recent complete set of gains.
+*/
+class MACH1DECODEPLUGIN_API FM1DecodeGainHandoff
+{
+public:
+	FM1DecodeGainHandoff();
+
+	// Game thread: gains are interleaved L/R per input channel, as returned by getCoefficients()
+	void Publish(const float* Gains, int32 NumGains);
+
+	// Audio render thread: false when nothing was published since the previous call
+	bool Acquire(const float*& OutGains, int32& OutNumGains);
+
+	// Registry used by FM1DecodeSourceEffect to find the handoff named in its preset settings
+	static int32 Register(TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> Handoff);
+	static void Unregister(int32 HandoffId);
+	static TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> Find(int32 HandoffId);
+
+private:
+	static const int32 MaxGains = M1_SINGLE_VOICE_MAX_CHANNELS * 2;
+	static const int32 DirtyFlag = 4;
+
+	float Buffers[3][MaxGains];
+	int32 Counts[3];
+
+	// index of the buffer between writer and reader, | DirtyFlag when it holds unread gains
+	std::atomic<int32> Middle;
+	int32 WriteIndex;
+	int32 ReadIndex;
+};
+
+USTRUCT(BlueprintType)
+struct MACH1DECODEPLUGIN_API FM1DecodeSourceEffectSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Id of the gain handoff published by the owning Mach1 decoder */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1")
+		int32 HandoffId = 0;
+};
+
+/*
+Decodes a Mach1 Spatial bed playing as one voice: every input channel is mixed into L/R with
+the gains from FM1DecodeGainHandoff (ramped across the block, like Mach1Decode::decodeBuffer),
+L/R are written to output channels 0/1 and the remaining channels are cleared.
+*/
+class MACH1DECODEPLUGIN_API FM1DecodeSourceEffect : public FSoundEffectSource
+{
+public:
+	virtual void Init(const FSoundEffectSourceInitData& InitData) override;
+	virtual void OnPresetChanged() override;
+	virtual void ProcessAudio(const FSoundEffectSourceInputData& InData, float* OutAudioBufferData) override;
+
+private:
+	TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> Handoff;
+	int32 HandoffId = 0;
+	int32 NumChannels = 0;
+
+	float CurrentGains[M1_SINGLE_VOICE_MAX_CHANNELS * 2];
+	float TargetGains[M1_SINGLE_VOICE_MAX_CHANNELS * 2];
+	bool HasGains = false;
+};
+
+UCLASS(ClassGroup = AudioSourceEffect, meta = (BlueprintSpawnableComponent))
+class MACH1DECODEPLUGIN_API UM1DecodeSourceEffectPreset : public USoundEffectSourcePreset
+{
+	GENERATED_BODY()
+
+public:
+	EFFECT_PRESET_METHODS(M1DecodeSourceEffect)
+
+	UFUNCTION(BlueprintCallable, Category = "Audio|Effects")
+		void SetSettings(const FM1DecodeSourceEffectSettings& InSettings);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SourceEffectPreset, Meta = (ShowOnlyInnerProperties))
+		FM1DecodeSourceEffectSettings Settings;
+};
@@ -0,0 +1,62 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "Components/AudioComponent.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+// Quartz quantized playback is available from UE 4.26
+#define M1_SYNC_START_QUARTZ ((ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 26) || ENGINE_MAJOR_VERSION == 5)
+
+// Quartz clock shared by every Mach1 decoder in a world
+#define M1_SYNC_CLOCK_NAME TEXT("Mach1DecodeSyncClock")
+
+// Tick rate of the shared clock; a synchronized start lands on the next tick, so this bounds the added latency
+#define M1_SYNC_CLOCK_TICKS_PER_SECOND 100.0f
+
+// Time StartAtAudioTime() leaves for its commands to reach the audio renderer before the target tick
+#define M1_SYNC_COMMAND_MARGIN_SECONDS 0.1f
+
+/*
+Collects audio components and starts them on the same audio render block.
+Start() queues every component with UAudioComponent::PlayQuantized against the next tick of the
+shared Quartz clock, so nothing waits on the audio thread. Without Quartz the components are
+started back to back in the same frame, from a game-thread timer when delayed.
+*/
+class MACH1DECODEPLUGIN_API FM1DecodeSyncStart
+{
+public:
+	FM1DecodeSyncStart(const UObject* WorldContextObject);
+
+	// Queue Component to start StartTime seconds into its sound, fading in over FadeInDuration
+	void Add(UAudioComponent* Component, float StartTime, float FadeInDuration);
+
+	// Start every queued component together, DelaySeconds from now rounded up to a clock tick; returns how many were queued
+	int Start(float DelaySeconds = 0);
+
+	// Start every queued component together at a world audio time (UWorld::GetAudioTimeSeconds), as a tick of the
+	// shared clock's transport; a time already passed or within M1_SYNC_COMMAND_MARGIN_SECONDS starts like Start()
+	int StartAtAudioTime(double StartAudioTime);
+
+	int Num() const { return Entries.Num(); }
+
+private:
+	struct FEntry
+	{
+		UAudioComponent* Component;
+		float StartTime;
+		float FadeInDuration;
+	};
+
+	const UObject* WorldContextObject;
+	TArray<FEntry> Entries;
+
+#if M1_SYNC_START_QUARTZ
+	// Shared clock of the world, created and started on first use
+	class UQuartzClockHandle* GetSyncClock();
+	// Boundary by value: UAudioComponent::PlayQuantized takes it by non-const reference
+	int PlayQuantized(UQuartzClockHandle* Clock, struct FQuartzQuantizationBoundary Boundary);
+#endif
+};
@@ -0,0 +1,65 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/AudioComponent.h"
+
+#include "M1DecodeSourceEffect.h"
+
+#include "M1DecodeVoices.generated.h"
+
+class FM1DecodeSyncStart;
+struct FM1VolumeBatch;
+
+/*
+Voice control shared by AM1DecodeActor and UM1DecodeComponent: the single-voice bed with its decode effect,
+the synchronized start of either the bed or the L/R mono channel voices, and the per-channel volume updates.
+The mono channel voices stay with the decoder and are passed in, this holds what both decoders kept next to them.
+*/
+USTRUCT()
+struct MACH1DECODEPLUGIN_API FM1DecodeVoices
+{
+	GENERATED_BODY()
+
+	// Creates the bed voice under AttachComponent and its decode effect chain under Outer, once
+	void InitSingleVoice(UObject* Outer, USceneComponent* AttachComponent);
+
+	// Unregisters the gain handoff of the bed voice, called from EndPlay()
+	void Release();
+
+	// Stop every voice that has a sound, the bed when IsSingleVoiceActive, and queue it on SyncStart
+	void QueueSynchronizedStart(FM1DecodeSyncStart& SyncStart, const TArray<UAudioComponent*>& LeftChannels, const TArray<UAudioComponent*>& RightChannels, int NumChannels, float StartTime, float FadeIn) const;
+
+	// Sends GainCoeffs * MasterGain to the channel voices, into Batch when given. A channel within ThresholdDb
+	// of the volume last sent is skipped, every volume change being an audio thread command
+	void SetChannelVolumes(const TArray<float>& GainCoeffs, float MasterGain, float ThresholdDb, const TArray<UAudioComponent*>& LeftChannels, const TArray<UAudioComponent*>& RightChannels, int NumChannels, FM1VolumeBatch* Batch);
+
+	// Forces the next SetChannelVolumes() to send every channel
+	void ResetAppliedChannelVolumes(int NumChannels);
+
+	// Publishes GainCoeffs * MasterGain to the decode effect of the bed voice, applied on the audio render thread
+	void SetSingleVoiceGains(const TArray<float>& GainCoeffs, float MasterGain, int NumChannels);
+
+	// MultichannelBed plays on this one audio component and is decoded into L/R by FM1DecodeSourceEffect
+	UPROPERTY(Transient)
+		UAudioComponent* SingleVoiceMain = nullptr;
+
+	bool IsSingleVoiceActive = false;
+
+	// Channel volume updates skipped by SetChannelVolumes()
+	int32 SuppressedVolumeUpdates = 0;
+
+private:
+	UPROPERTY(Transient)
+		UM1DecodeSourceEffectPreset* SingleVoicePreset = nullptr;
+	UPROPERTY(Transient)
+		USoundEffectSourcePresetChain* SingleVoiceChain = nullptr;
+	TSharedPtr<FM1DecodeGainHandoff, ESPMode::ThreadSafe> SingleVoiceGains;
+	int32 SingleVoiceHandoffId = 0;
+
+	// Volume multipliers last sent to the channel voices, interleaved L/R like GainCoeffs; negative forces a resend
+	TArray<float> AppliedChannelVolumes;
+};
@@ -0,0 +1,140 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "M1DecodeActor.h"
+#include "M1DecodeComponent.h"
+#include "M1OccluderComponent.h"
+#include "M1VolumeBatch.h"
+#include "Mach1PositionalOcclusion.h"
+#include "Mach1PositionalSpatialIndex.h"
+
+#include <vector>
+
+#include "M1DecodeWorldSubsystem.generated.h"
+
+// Emitter index cell edge in centimeters, on the order of the default LOD virtual distance so a query visits few cells
+#ifndef M1_EMITTER_INDEX_CELL_SIZE
+#define M1_EMITTER_INDEX_CELL_SIZE 5000.0f
+#endif
+
+// Occluder index cell edge in centimeters, about the size of a room
+#ifndef M1_OCCLUDER_INDEX_CELL_SIZE
+#define M1_OCCLUDER_INDEX_CELL_SIZE 1000.0f
+#endif
+
+class APlayerController;
+class APawn;
+
+// Listener state shared by every decoder for one frame
+struct FM1ListenerFrame
+{
+	APlayerController* PlayerController = nullptr;
+	APawn* PlayerPawn = nullptr;
+
+	float DeltaSeconds = 0;
+	// UWorld::GetAudioTimeSeconds(): stops while paused and ignores time dilation, like the voices
+	double AudioTimeSeconds = 0;
+
+	bool HasHMD = false;
+	FVector HMDPosition = FVector::ZeroVector;
+	FQuat HMDRotation = FQuat::Identity;
+
+	bool HasCameraManager = false;
+	FVector CameraPosition = FVector::ZeroVector;
+	FQuat CameraRotation = FQuat::Identity;
+};
+
+// A registered decoder and its entry in the emitter index
+template<typename DecoderType>
+struct TM1RegisteredDecoder
+{
+	TWeakObjectPtr<DecoderType> Decoder;
+	int32 IndexHandle = -1;
+	FVector IndexedLocation = FVector::ZeroVector;
+
+	// this frame's GetCullDistance(), 0 if the decoder is always evaluated
+	float CullDistance = 0;
+};
+
+// A registered occluder and the box last given to the occlusion stage
+struct FM1RegisteredOccluder
+{
+	TWeakObjectPtr<UM1OccluderComponent> Occluder;
+	int32 Handle = -1;
+	FTransform IndexedTransform;
+	FVector IndexedExtent = FVector::ZeroVector;
+};
+
+/*
+Drives every registered AM1DecodeActor / UM1DecodeComponent from one tick: the listener is
+resolved once and shared by every decoder, and gains are pushed after all decoders have been
+evaluated. The positional evaluation itself still runs decoder by decoder through
+EvaluateDecode(). Registered decoders disable their own tick.
+
+Decoder locations are kept in a Mach1PositionalSpatialIndex. One query around the listener
+finds the LOD decoders within their virtual distance; the others only advance their playback
+time instead of being evaluated.
+
+UM1OccluderComponent boxes are followed in a Mach1PositionalOcclusion stage that decoders with
+Use Occlusion query through EvaluateOcclusion().
+*/
+UCLASS()
+class MACH1DECODEPLUGIN_API UM1DecodeWorldSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterDecoder(AM1DecodeActor* Decoder);
+	void RegisterDecoder(UM1DecodeComponent* Decoder);
+	void UnregisterDecoder(AM1DecodeActor* Decoder);
+	void UnregisterDecoder(UM1DecodeComponent* Decoder);
+
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		int GetRegisteredDecoderCount() const;
+
+	void RegisterOccluder(UM1OccluderComponent* Occluder);
+	void UnregisterOccluder(UM1OccluderComponent* Occluder);
+
+	UFUNCTION(BlueprintCallable, Category = "Mach1Spatial Functions")
+		int GetRegisteredOccluderCount() const;
+
+	// Product of the transmissions of the occluders crossed from Listener to Emitter, 1 when nothing is in between
+	float EvaluateOcclusion(FVector Listener, FVector Emitter);
+
+	// World audio time at which FM1DecodeSyncStart started the shared Quartz clock, negative until then
+	double GetSyncClockStartAudioTime() const { return SyncClockStartAudioTime; }
+	void SetSyncClockStartAudioTime(double AudioTime) { SyncClockStartAudioTime = AudioTime; }
+
+	// HMD, camera manager and first player pawn, queried once
+	static FM1ListenerFrame ResolveListenerFrame(UWorld* World);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+
+private:
+	TArray<TM1RegisteredDecoder<AM1DecodeActor>> DecodeActors;
+	TArray<TM1RegisteredDecoder<UM1DecodeComponent>> DecodeComponents;
+
+	Mach1PositionalSpatialIndex EmitterIndex{ M1_EMITTER_INDEX_CELL_SIZE };
+
+	// scratch reused between ticks: handles returned by the listener query, as a mask over index handles
+	std::vector<int> NearHandles;
+	TBitArray<> IsNear;
+
+	double SyncClockStartAudioTime = -1;
+
+	TArray<FM1RegisteredOccluder> Occluders;
+	Mach1PositionalOcclusion Occlusion{ M1_OCCLUDER_INDEX_CELL_SIZE };
+
+	// Moves the boxes of occluders that moved, resized or changed transmission since the last tick
+	void SyncOccluders();
+};
@@ -0,0 +1,40 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "Camera/CameraComponent.h"
+
+// Resolve() calls between two searches for a camera on a pawn that had no active one, e.g. a camera added or activated after spawn
+#ifndef M1_LISTENER_CAMERA_RETRY_INTERVAL
+#define M1_LISTENER_CAMERA_RETRY_INTERVAL 30
+#endif
+
+/*
+Camera of a reference pawn, found once and reused every tick.
+The binding is rebuilt when the pawn changes, when it is possessed by another controller,
+or when the bound camera is destroyed or deactivated. A pawn without an active camera is
+searched again every M1_LISTENER_CAMERA_RETRY_INTERVAL calls.
+*/
+struct MACH1DECODEPLUGIN_API FM1ListenerBinding
+{
+	// Active camera of InPawn, nullptr if it has none
+	UCameraComponent* Resolve(APawn* InPawn);
+
+	void Reset();
+
+	int32 GetResolveCount() const { return ResolveCount; }
+
+private:
+	bool IsStale(APawn* InPawn) const;
+
+	TWeakObjectPtr<APawn> Pawn;
+	TWeakObjectPtr<AController> Controller;
+	TWeakObjectPtr<UCameraComponent> Camera;
+	bool IsBound = false;
+	int32 ResolveCount = 0;
+	int32 CameraRetryCount = 0;
+};
@@ -0,0 +1,31 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "Components/BoxComponent.h"
+
+#include "M1OccluderComponent.generated.h"
+
+/*
+Box that occludes AM1DecodeActor / UM1DecodeComponent decoders with Use Occlusion enabled: a decoder
+whose line to the listener crosses the box is scaled by its Transmission. Registered with
+UM1DecodeWorldSubsystem while playing, which follows its transform every frame.
+*/
+UCLASS(BlueprintType, Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class MACH1DECODEPLUGIN_API UM1OccluderComponent : public UBoxComponent
+{
+	GENERATED_BODY()
+
+public:
+	UM1OccluderComponent();
+
+	/** Share of the sound that passes through the box, 0 blocks it, 1 passes it unchanged */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mach1 Occlusion", DisplayName = "Transmission", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+		float Transmission = 0.25f;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
@@ -8,9 +8,10 @@
 #include "GameFramework/Pawn.h"
 
 #include "M1DecodeActor.h"
+#include "M1DecodeComponent.h"
+#include "M1DecodeSyncStart.h"
 
 #include <vector>
-#include <thread>
 
 #include "M1Scheduler.generated.h"
 
@@ -19,26 +20,65 @@ class MACH1DECODEPLUGIN_API UM1Scheduler : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
-/*
-	UFUNCTION(BlueprintCallable, Category = "M1 Utility")
-	static inline void PlayArrayAsync(TArray<AM1DecodeActor*> AM1Actors) {
+public:
+	/** Starts all given decoders together on the next tick of the shared clock, see PlayScheduled. */
+	UFUNCTION(BlueprintCallable, Category = "M1 Utility", meta = (WorldContext = "WorldContextObject", AutoCreateRefTerm = "AM1Components"))
+	static inline void PlaySync(UObject* WorldContextObject, TArray<AM1DecodeActor*> AM1Actors, const TArray<UM1DecodeComponent*>& AM1Components) {
+		PlayScheduled(WorldContextObject, AM1Actors, AM1Components, 0);
+	}
+
+	/** Actors only, for C++ callers of the original signature; the world is taken from the first actor. */
+	static inline void PlaySync(TArray<AM1DecodeActor*> AM1Actors) {
+		UObject* WorldContextObject = nullptr;
 		for (auto& actor : AM1Actors)
 		{
-			auto t = std::thread([&] {
-				actor->Play();
-			});
-			//t.detach();
-			t.join();
+			if (actor)
+			{
+				WorldContextObject = actor;
+				break;
+			}
 		}
+		PlaySync(WorldContextObject, AM1Actors, TArray<UM1DecodeComponent*>());
 	}
-*/
 
-	UFUNCTION(BlueprintCallable, Category = "M1 Utility")
-	static inline void PlaySync(TArray<AM1DecodeActor*> AM1Actors) {
+	/** Starts all given decoders together on one audio render block, DelaySeconds from now (rounded up to 10 ms). Never blocks the game thread; decoders that are not initialized yet play once they are. Returns the number of voices scheduled. */
+	UFUNCTION(BlueprintCallable, Category = "M1 Utility", meta = (WorldContext = "WorldContextObject"))
+	static inline int PlayScheduled(UObject* WorldContextObject, TArray<AM1DecodeActor*> AM1Actors, TArray<UM1DecodeComponent*> AM1Components, float DelaySeconds = 0) {
+		if (AM1Actors.Num() == 0 && AM1Components.Num() == 0)
+		{
+			return 0;
+		}
+
+		FM1DecodeSyncStart SyncStart(WorldContextObject);
 		for (auto& actor : AM1Actors)
 		{
-			actor->Play();
+			if (actor) actor->PlayWith(SyncStart);
+		}
+		for (auto& component : AM1Components)
+		{
+			if (component) component->PlayWith(SyncStart);
+		}
+		return SyncStart.Start(DelaySeconds);
+	}
+
+	/** Same as PlayScheduled, with the start given as a world audio time (UWorld::GetAudioTimeSeconds), placed on the shared Quartz clock's timeline so groups started from different frames for the same time stay aligned. A time already passed starts on the next clock tick. Takes a double like GetAudioTimeSeconds, which a float truncates after long sessions. */
+	UFUNCTION(BlueprintCallable, Category = "M1 Utility", meta = (WorldContext = "WorldContextObject"))
+	static inline int PlayAtAudioTime(UObject* WorldContextObject, TArray<AM1DecodeActor*> AM1Actors, TArray<UM1DecodeComponent*> AM1Components, double StartAudioTime) {
+		if (AM1Actors.Num() == 0 && AM1Components.Num() == 0)
+		{
+			return 0;
+		}
+
+		FM1DecodeSyncStart SyncStart(WorldContextObject);
+		for (auto& actor : AM1Actors)
+		{
+			if (actor) actor->PlayWith(SyncStart);
+		}
+		for (auto& component : AM1Components)
+		{
+			if (component) component->PlayWith(SyncStart);
 		}
+		return SyncStart.StartAtAudioTime(StartAudioTime);
 	}
 
 };
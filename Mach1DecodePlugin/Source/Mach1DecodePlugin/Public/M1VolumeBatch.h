@@ -0,0 +1,28 @@
+//  Mach1 SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+//
+
+#pragma once
+
+#include "Components/AudioComponent.h"
+
+class FAudioDevice;
+
+/*
+Volume multipliers of many audio components, sent to the audio thread as one command.
+UAudioComponent::SetVolumeMultiplier() queues a command per component; a frame of per-channel
+gains for every decoder is collected here instead and applied to the active sounds in one pass.
+*/
+struct MACH1DECODEPLUGIN_API FM1VolumeBatch
+{
+	// Sets the component's multiplier on the game thread now, on its active sound once Send() runs
+	void Add(UAudioComponent* Component, float Volume);
+
+	void Send();
+
+	int32 Num() const { return Volumes.Num(); }
+
+private:
+	FAudioDevice* AudioDevice = nullptr;
+	TMap<uint64, float> Volumes;
+};
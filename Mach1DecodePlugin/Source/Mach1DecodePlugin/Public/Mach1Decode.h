@@ -1,467 +1,908 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#ifndef MACH1SPATIALSDK_MACH1DECODE_H
-#define MACH1SPATIALSDK_MACH1DECODE_H
-
-#include "Mach1DecodeCAPI.h"
-#include <cstring>
-#include <string>
-#include <vector>
-
-template <typename PCM>
-class Mach1Decode {
-  public:
-    Mach1Decode();
-
-    ~Mach1Decode();
-
-    /**
-     * @brief Set the device's angle order and convention if applicable.
-     */
-    void setPlatformType(Mach1PlatformType type);
-
-    /**
-     * @brief Set the decoding mode.
-     */
-    void setDecodeMode(Mach1DecodeMode mode);
-    
-    /**
-     * @brief Get the device's angle order and convention if applicable.
-     */
-    Mach1PlatformType getPlatformType();
-
-    /**
-     * @brief Get the decoding mode.
-     */
-    Mach1DecodeMode getDecodeMode();
-
-    /**
-     * @brief Get the get amount of channels that this Mach1Decode expects to decode, based on the
-     * currently active decoding mode.
-     */
-    int getFormatChannelCount();
-
-    /**
-     * @brief Get the get amount of decoding coefficients this Mach1Decode will generate, based on the
-     * currently active decoding algorithm.
-     */
-    int getFormatCoeffCount();
-
-    /**
-     * @brief Set current buffer/sample intended decoding orientation YPR.
-     * @param newRotationFromMinusOnetoOne
-     * <ul>
-     *      <li> Yaw:   [Range: 0.0 -> 1.0 | -0.5 -> 0.5];  [Range: 0.0 -> 360 | -180 -> 180] </li>
-     *      <li> Pitch: [Range: -0.25 -> 0.25];             [Range: -90 -> 90] </li>
-     *      <li> Roll:  [Range: -0.25 -> 0.25];             [Range: -90 -> 90] </li>
-     * </ul>
-     */
-    void setRotation(Mach1Point3D newRotationFromMinusOnetoOne);
-
-    /**
-     * @brief Set current buffer/sample intended decoding orientation YPR.
-     * @param newRotationFromMinusOnetoOne
-     * <ul>
-     *      <li> Yaw:   [Range: 0.0 -> 360 | -180 -> 180] </li>
-     *      <li> Pitch: [Range: -90 -> 90] </li>
-     *      <li> Roll:  [Range: -90 -> 90] </li>
-     * </ul>
-     */
-    void setRotationDegrees(Mach1Point3D newRotationDegrees);
-
-    /**
-     * @brief Set current buffer/sample intended decoding orientation YPR.
-     * @param newRotationFromMinusOnetoOne
-     * <ul>
-     *      <li> Yaw:   [Range: 0.0 -> 2PI | -PI  -> PI];   [Range: 0.0 -> 360 | -180 -> 180] </li>
-     *      <li> Pitch: [Range: -PI/2 -> PI/2];             [Range: -90   -> 90] </li>
-     *      <li> Roll:  [Range: -PI/2 -> PI/2];             [Range: -90   -> 90] </li>
-     * </ul>
-     */
-    void setRotationRadians(Mach1Point3D newRotationRadians);
-
-    /**
-     * @brief Set current buffer/sample intended decoding orientation YPR.
-     * @param newRotationFromMinusOnetoOne
-     * <ul>
-     *      <li> W: [Range: -1.0 -> 1.0] </li>
-     *      <li> X: [Range: -1.0 -> 1.0] </li>
-     *      <li> Y: [Range: -1.0 -> 1.0] </li>
-     *      <li> Z: [Range: -1.0 -> 1.0] </li>
-     * </ul>
-     */
-    void setRotationQuat(Mach1Point4D newRotationQuat);
-
-    /**
-     * @brief Set the amount of angle smoothing applied to the orientation angles used for this Mach1Decode.
-     * @param filterSpeed floating point value between [0.0001 -> 1.0], where 1.0 represents no filter.
-     */
-    void setFilterSpeed(float filterSpeed);
-
-    /**
-     * @brief Get the current elapsed time in milliseconds (ms) this Mach1Decode has been constructed.
-     */
-    long getCurrentTime();
-
-    /**
-     * @brief Get this Mach1Decode's current 3D angle for feedback design.
-     */
-    Mach1Point3D getCurrentAngle();
-
-    /**
-     * Call with current update's angles to return the coefficients with which an incoming audio buffer
-     * may be decoded.
-     *
-     * Includes two modes of use:
-     * <ol>
-     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
-     *      buffer size and sample index as parameters.</li>
-     *      <li>Update decode results via main loop (or any loop)</li>
-     * </ol>
-     *
-     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
-     *
-     * @param Yaw float for device/listener yaw angle: [Range: 0->360 | -180->180]
-     * @param Pitch float for device/listener pitch angle: [Range: -90->90]
-     * @param Roll float for device/listener roll angle: [Range: -90->90]
-     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
-     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
-     */
-    std::vector<PCM> decode(float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
-
-    /**
-     * Call with current update's angles to return the coefficients with which an incoming audio buffer
-     * may be decoded.
-     *
-     * Includes two modes of use:
-     * <ol>
-     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
-     *      buffer size and sample index as parameters.</li>
-     *      <li>Update decode results via main loop (or any loop)</li>
-     * </ol>
-     *
-     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
-     *
-     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
-     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
-     */
-    std::vector<PCM> decodeCoeffs(int bufferSize = 0, int sampleIndex = 0);
-
-    /**
-     * Call with current update's angles to return the coefficients with which an incoming audio buffer
-     * may be decoded.
-     *
-     * Includes two modes of use:
-     * <ol>
-     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
-     *      buffer size and sample index as parameters.</li>
-     *      <li>Update decode results via main loop (or any loop)</li>
-     * </ol>
-     *
-     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
-     *
-     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
-     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
-     * @param applyPanLaw bool for control over panLaw application.
-     */
-    std::vector<PCM> decodePannedCoeffs(int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
-
-    std::vector<PCM> decodeCoeffsUsingTranscodeMatrix(std::vector<std::vector<float> > matrix, int channels, int bufferSize = 0, int sampleIndex = 0);
-
-    inline void decodeBuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size);
-
-    inline void decodeBufferInPlace(std::vector<std::vector<PCM> > &buffer, int size);
-
-    inline void decodeBufferRebuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size);
-
-    inline void decodeBufferInPlaceRebuffer(std::vector<std::vector<PCM> > &buffer, int size);
-
-#ifndef __EMSCRIPTEN__
-    void decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
-    void decodeCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0);
-    void decodePannedCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
-
-    /**
-     * @brief Get the internal log that has been accumulated into this Mach1Decode.
-     */
-    char *getLog();
-#else
-    /**
-     * @brief Get the internal log that has been accumulated into this Mach1Decode.
-     */
-    std::string getLog();
-#endif
-
-  private:
-    void *M1obj;
-
-    std::vector<float> old_decode_gains;
-    std::vector<std::vector<float> > intermediary_buffer;
-    int ib_channel_count;
-    size_t ib_buffer_size;
-};
-
-#endif // MACH1SPATIALSDK_MACH1DECODE_H
-
-// Implementation of Mach1Decode<PCM>
-#ifndef MACH1SPATIALSDK_MACH1DECODE_TPP
-#define MACH1SPATIALSDK_MACH1DECODE_TPP
-
-template <typename PCM>
-Mach1Decode<PCM>::Mach1Decode() {
-    M1obj = Mach1DecodeCAPI_create();
-}
-
-template <typename PCM>
-Mach1Decode<PCM>::~Mach1Decode() {
-    Mach1DecodeCAPI_delete(M1obj);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setPlatformType(Mach1PlatformType type) {
-    Mach1DecodeCAPI_setPlatformType(M1obj, type);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setDecodeMode(Mach1DecodeMode mode) {
-    Mach1DecodeCAPI_setDecodeMode(M1obj, mode);
-}
-
-template <typename PCM>
-Mach1PlatformType Mach1Decode<PCM>::getPlatformType() {
-    return Mach1DecodeCAPI_getPlatformType(M1obj);
-}
-
-template <typename PCM>
-Mach1DecodeMode Mach1Decode<PCM>::getDecodeMode() {
-    return Mach1DecodeCAPI_getDecodeMode(M1obj);
-}
-
-#ifndef __EMSCRIPTEN__
-template <typename PCM>
-void Mach1Decode<PCM>::decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
-    Mach1DecodeCAPI_decode(M1obj, Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodeCoeffs(float *result, int bufferSize, int sampleIndex) {
-    Mach1DecodeCAPI_decodeCoeffs(M1obj, result, bufferSize, sampleIndex);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodePannedCoeffs(float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
-    Mach1DecodeCAPI_decodePannedCoeffs(M1obj, result, bufferSize, sampleIndex, applyPanLaw);
-}
-#endif
-
-template <typename PCM>
-std::vector<PCM> Mach1Decode<PCM>::decode(float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
-    std::vector<PCM> vec(getFormatCoeffCount());
-
-    Mach1DecodeCAPI_decode(M1obj, Yaw, Pitch, Roll, vec.data(), bufferSize, sampleIndex);
-
-    return vec;
-}
-
-template <typename PCM>
-std::vector<PCM> Mach1Decode<PCM>::decodeCoeffs(int bufferSize, int sampleIndex) {
-    std::vector<PCM> vec(getFormatCoeffCount());
-
-    Mach1DecodeCAPI_decodeCoeffs(M1obj, vec.data(), bufferSize, sampleIndex);
-
-    return vec;
-}
-
-template <typename PCM>
-std::vector<PCM> Mach1Decode<PCM>::decodePannedCoeffs(int bufferSize, int sampleIndex, bool applyPanLaw) {
-    std::vector<PCM> vec(getFormatCoeffCount());
-
-    Mach1DecodeCAPI_decodePannedCoeffs(M1obj, vec.data(), bufferSize, sampleIndex, applyPanLaw);
-
-    return vec;
-}
-
-template <typename PCM>
-std::vector<PCM> Mach1Decode<PCM>::decodeCoeffsUsingTranscodeMatrix(std::vector<std::vector<float> > matrix, int channels, int bufferSize, int sampleIndex) {
-    std::vector<PCM> vec(2 * channels);
-
-    int inChans = channels;
-    int outChans = getFormatChannelCount();
-
-    float *m = new float[inChans * outChans];
-    for (int i = 0; i < outChans; i++) {
-        for (int j = 0; j < inChans; j++) {
-            m[i * inChans + j] = matrix[i][j];
-        }
-    }
-
-    Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(M1obj, m, channels, vec.data(), bufferSize, sampleIndex);
-
-    delete[] m;
-    return vec;
-}
-
-template <typename PCM>
-int Mach1Decode<PCM>::getFormatChannelCount() {
-    return Mach1DecodeCAPI_getFormatChannelCount(M1obj);
-}
-
-template <typename PCM>
-int Mach1Decode<PCM>::getFormatCoeffCount() {
-    return Mach1DecodeCAPI_getFormatCoeffCount(M1obj);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setRotation(Mach1Point3D newRotationFromMinusOnetoOne) {
-    Mach1DecodeCAPI_setRotation(M1obj, newRotationFromMinusOnetoOne);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setRotationDegrees(Mach1Point3D newRotationDegrees) {
-    Mach1DecodeCAPI_setRotationDegrees(M1obj, newRotationDegrees);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setRotationRadians(Mach1Point3D newRotationRadians) {
-    Mach1DecodeCAPI_setRotationRadians(M1obj, newRotationRadians);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setRotationQuat(Mach1Point4D newRotationQuat) {
-    Mach1DecodeCAPI_setRotationQuat(M1obj, newRotationQuat);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::setFilterSpeed(float filterSpeed) {
-    Mach1DecodeCAPI_setFilterSpeed(M1obj, filterSpeed);
-}
-
-template <typename PCM>
-long Mach1Decode<PCM>::getCurrentTime() {
-    return Mach1DecodeCAPI_getCurrentTime(M1obj);
-}
-
-#ifndef __EMSCRIPTEN__
-template <typename PCM>
-char *Mach1Decode<PCM>::getLog() {
-    return Mach1DecodeCAPI_getLog(M1obj);
-}
-#else
-template <typename PCM>
-std::string Mach1Decode<PCM>::getLog() {
-    return std::string(Mach1DecodeCAPI_getLog(M1obj));
-    /// Returns the current elapsed time in milliseconds (ms) since Mach1Decode object creation
-}
-#endif
-
-template <typename PCM>
-Mach1Point3D Mach1Decode<PCM>::getCurrentAngle() {
-    return Mach1DecodeCAPI_getCurrentAngle(M1obj);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodeBuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size) {
-    // get output gain multipliers
-    auto decode_gains = decodeCoeffs(); // TODO: Implement interpolation between coeffs.
-
-    if (old_decode_gains.size() != decode_gains.size()) {
-        old_decode_gains = decode_gains;
-    }
-
-    float size_reciprocal = 1.0f / (float)size;
-
-    // process the samples manually
-    for (int decode_idx = 0, output_idx = 0; decode_idx < decode_gains.size(); decode_idx += 2, output_idx += 1) {
-        auto left_gain = decode_gains[decode_idx + 0];
-        auto right_gain = decode_gains[decode_idx + 1];
-        auto old_left_gain = old_decode_gains[decode_idx + 0];
-        auto old_right_gain = old_decode_gains[decode_idx + 1];
-
-        for (int sample_idx = 0; sample_idx < size; sample_idx++) {
-            auto prc = (float)sample_idx * size_reciprocal;
-            auto left = left_gain * (1.0f - prc) + old_left_gain * prc;
-            auto right = right_gain * (1.0f - prc) + old_right_gain * prc;
-
-            // get the sample in each loop
-            float sample = in[output_idx][sample_idx];
-
-            // clear the output for the new values to come in
-            out[output_idx][sample_idx] = 0;
-            out[0][sample_idx] += sample * left;
-            out[1][sample_idx] += sample * right;
-        }
-    }
-
-    old_decode_gains = decode_gains;
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodeBufferInPlace(std::vector<std::vector<PCM> > &buffer, int size) {
-    decodeBuffer(buffer, buffer, size);
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodeBufferRebuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size) {
-    auto channel_count = 2;
-
-    // restructure intermediary buffer
-    if (ib_channel_count != channel_count || ib_buffer_size != size) {
-        intermediary_buffer.resize(channel_count);
-
-        for (int i = 0; i < channel_count; i++) {
-            intermediary_buffer[i].resize(size);
-        }
-
-        ib_channel_count = channel_count;
-        ib_buffer_size = size;
-    }
-
-    // clear intermediary buffer
-    for (int i = 0; i < ib_channel_count; i++) {
-        memset(intermediary_buffer[i].data(), 0, sizeof(float) * ib_buffer_size);
-    }
-
-    // get output gain multipliers
-    auto decode_gains = decodeCoeffs(); // TODO: Implement interpolation between coeffs.
-
-    if (old_decode_gains.size() != decode_gains.size()) {
-        old_decode_gains = decode_gains;
-    }
-
-    float size_reciprocal = 1.0f / (float)size;
-
-    // process the samples manually
-    for (int decode_idx = 0, output_idx = 0; decode_idx < decode_gains.size(); decode_idx += 2, output_idx += 1) {
-        auto left_gain = decode_gains[decode_idx + 0];
-        auto right_gain = decode_gains[decode_idx + 1];
-        auto old_left_gain = old_decode_gains[decode_idx + 0];
-        auto old_right_gain = old_decode_gains[decode_idx + 1];
-
-        for (int sample_idx = 0; sample_idx < size; sample_idx++) {
-            auto prc = (float)sample_idx * size_reciprocal;
-            auto left = left_gain * (1.0f - prc) + old_left_gain * prc;
-            auto right = right_gain * (1.0f - prc) + old_right_gain * prc;
-
-            // get the sample in each loop
-            float sample = in[output_idx][sample_idx];
-
-            intermediary_buffer[0][sample_idx] += sample * left;
-            intermediary_buffer[1][sample_idx] += sample * right;
-        }
-    }
-
-    // copy over values in intermediary buffer to output buffer
-    for (int output_idx = 0; output_idx < channel_count; output_idx++) {
-        memcpy(out[output_idx].data(), intermediary_buffer[output_idx].data(), sizeof(float) * size);
-    }
-
-    old_decode_gains = decode_gains;
-}
-
-template <typename PCM>
-void Mach1Decode<PCM>::decodeBufferInPlaceRebuffer(std::vector<std::vector<PCM> > &buffer, int size) {
-    decodeBufferRebuffer(buffer, buffer, size);
-}
-
-#endif // MACH1SPATIALSDK_MACH1DECODE_TPP
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#ifndef MACH1SPATIALSDK_MACH1DECODE_H
+#define MACH1SPATIALSDK_MACH1DECODE_H
+
+#include "Mach1DecodeCAPI.h"
+#include "Mach1OrientationQueue.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+template <typename PCM>
+class Mach1Decode {
+  public:
+    Mach1Decode();
+
+    /**
+     * @brief Acquire the decoder from a pool created with Mach1DecodeCAPI_createPool instead of allocating it.
+     * The slot is returned to the pool on destruction, so the pool must outlive this Mach1Decode.
+     */
+    Mach1Decode(void *M1pool);
+
+    ~Mach1Decode();
+
+    /**
+     * @brief Run this decoder's angle filter in a filter bank created with Mach1DecodeCAPI_createFilterBank,
+     * updated once per frame with Mach1DecodeCAPI_filterBankUpdate after the rotations are set and before
+     * decoding. nullptr returns the decoder to its own filter. The bank must outlive this Mach1Decode.
+     */
+    void setFilterBank(void *M1filterBank);
+
+    /**
+     * @brief Set the device's angle order and convention if applicable.
+     */
+    void setPlatformType(Mach1PlatformType type);
+
+    /**
+     * @brief Set the decoding mode.
+     */
+    void setDecodeMode(Mach1DecodeMode mode);
+    
+    /**
+     * @brief Get the device's angle order and convention if applicable.
+     */
+    Mach1PlatformType getPlatformType();
+
+    /**
+     * @brief Get the decoding mode.
+     */
+    Mach1DecodeMode getDecodeMode();
+
+    /**
+     * @brief Evaluate a cheaper decoding mode and transcode its coefficients to the channels of
+     * the decoding mode. Has no effect unless it is lower than the decoding mode.
+     */
+    void setReducedDecodeMode(Mach1DecodeMode mode);
+
+    /**
+     * @brief Get the reduced decoding mode.
+     */
+    Mach1DecodeMode getReducedDecodeMode();
+
+    /**
+     * @brief Ignore the listener's pitch. With pitch and roll both ignored (or both zero),
+     * Spatial_4 and Spatial_8 are decoded with a cheaper yaw-only kernel.
+     */
+    void setUsePitchForRotation(bool usePitchForRotation);
+    bool getUsePitchForRotation();
+
+    /**
+     * @brief Ignore the listener's roll, see setUsePitchForRotation().
+     */
+    void setUseRollForRotation(bool useRollForRotation);
+    bool getUseRollForRotation();
+
+    /**
+     * @brief Reuse the previous coefficients while the filtered orientation stays within
+     * thresholdDegrees of the one they were computed for, on every axis. 0 disables reuse.
+     */
+    void setCoeffReuseThreshold(float thresholdDegrees);
+    float getCoeffReuseThreshold();
+
+    /**
+     * @brief Share of coefficient evaluations answered by reuse since the last reset, 0 to 1.
+     */
+    float getCoeffReuseRate();
+    void resetCoeffReuseRate();
+
+    /**
+     * @brief Get the get amount of channels that this Mach1Decode expects to decode, based on the
+     * currently active decoding mode.
+     */
+    int getFormatChannelCount();
+
+    /**
+     * @brief Get the get amount of decoding coefficients this Mach1Decode will generate, based on the
+     * currently active decoding algorithm.
+     */
+    int getFormatCoeffCount();
+
+    /**
+     * @brief Set current buffer/sample intended decoding orientation YPR.
+     * @param newRotationFromMinusOnetoOne
+     * <ul>
+     *      <li> Yaw:   [Range: 0.0 -> 1.0 | -0.5 -> 0.5];  [Range: 0.0 -> 360 | -180 -> 180] </li>
+     *      <li> Pitch: [Range: -0.25 -> 0.25];             [Range: -90 -> 90] </li>
+     *      <li> Roll:  [Range: -0.25 -> 0.25];             [Range: -90 -> 90] </li>
+     * </ul>
+     */
+    void setRotation(Mach1Point3D newRotationFromMinusOnetoOne);
+
+    /**
+     * @brief Set current buffer/sample intended decoding orientation YPR.
+     * @param newRotationFromMinusOnetoOne
+     * <ul>
+     *      <li> Yaw:   [Range: 0.0 -> 360 | -180 -> 180] </li>
+     *      <li> Pitch: [Range: -90 -> 90] </li>
+     *      <li> Roll:  [Range: -90 -> 90] </li>
+     * </ul>
+     */
+    void setRotationDegrees(Mach1Point3D newRotationDegrees);
+
+    /**
+     * @brief Set current buffer/sample intended decoding orientation YPR.
+     * @param newRotationFromMinusOnetoOne
+     * <ul>
+     *      <li> Yaw:   [Range: 0.0 -> 2PI | -PI  -> PI];   [Range: 0.0 -> 360 | -180 -> 180] </li>
+     *      <li> Pitch: [Range: -PI/2 -> PI/2];             [Range: -90   -> 90] </li>
+     *      <li> Roll:  [Range: -PI/2 -> PI/2];             [Range: -90   -> 90] </li>
+     * </ul>
+     */
+    void setRotationRadians(Mach1Point3D newRotationRadians);
+
+    /**
+     * @brief Set current buffer/sample intended decoding orientation YPR.
+     * @param newRotationFromMinusOnetoOne
+     * <ul>
+     *      <li> W: [Range: -1.0 -> 1.0] </li>
+     *      <li> X: [Range: -1.0 -> 1.0] </li>
+     *      <li> Y: [Range: -1.0 -> 1.0] </li>
+     *      <li> Z: [Range: -1.0 -> 1.0] </li>
+     * </ul>
+     */
+    void setRotationQuat(Mach1Point4D newRotationQuat);
+
+    /**
+     * @brief Set the decoding orientation in degrees together with the time it was sampled.
+     * Timestamped orientations feed the head-pose predictor; any other setRotation call resets it.
+     * @param newRotationDegrees same ranges as setRotationDegrees
+     * @param timeSeconds sample time in seconds, on the same clock as setPredictionTargetTime
+     */
+    void setRotationDegreesAtTime(Mach1Point3D newRotationDegrees, double timeSeconds);
+
+    /**
+     * @brief Set the time the next decoded coefficients will be heard, e.g. now plus the output latency.
+     * The last timestamped orientation is extrapolated to it, by at most the prediction horizon.
+     */
+    void setPredictionTargetTime(double timeSeconds);
+
+    /**
+     * @brief Set how far ahead orientation may be extrapolated.
+     * @param maxSeconds [Range: 0.0 -> 0.25], where 0.0 (default) disables prediction.
+     */
+    void setPredictionHorizon(float maxSeconds);
+
+    /**
+     * @brief Get the current prediction horizon in seconds.
+     */
+    float getPredictionHorizon();
+
+    /**
+     * @brief Get the orientation in degrees the next decode will use after prediction.
+     */
+    Mach1Point3D getPredictedRotation();
+
+    /**
+     * @brief Set the amount of angle smoothing applied to the orientation angles used for this Mach1Decode.
+     * @param filterSpeed floating point value between [0.0001 -> 1.0], where 1.0 represents no filter.
+     */
+    void setFilterSpeed(float filterSpeed);
+
+    /**
+     * @brief Drive the angle filter from a caller supplied clock instead of the system clock, e.g. the
+     * audio device's sample clock or a simulated timeline. Enabled by the first setManualTime call.
+     * @param milliseconds current time, must not go backwards
+     */
+    void setManualTime(long milliseconds);
+
+    /**
+     * @brief Return the angle filter to the system clock.
+     */
+    void clearManualTime();
+
+    /**
+     * @brief Make decoding reproducible across platforms: trig is evaluated with the SDK's own
+     * polynomials instead of the platform math library, and the angle filter only advances with the
+     * time given to setManualTime. Use it when coefficients are cached, shared or replayed.
+     * Bit identical results are verified with GCC on x86-64 only, see Mach1DeterministicMath.h.
+     */
+    void setDeterministic(bool enable);
+
+    /**
+     * @brief Get whether deterministic decoding is enabled.
+     */
+    bool getDeterministic();
+
+    /**
+     * @brief Get the current elapsed time in milliseconds (ms) this Mach1Decode has been constructed.
+     */
+    long getCurrentTime();
+
+    /**
+     * @brief Get this Mach1Decode's current 3D angle for feedback design.
+     */
+    Mach1Point3D getCurrentAngle();
+
+    /**
+     * Call with current update's angles to return the coefficients with which an incoming audio buffer
+     * may be decoded.
+     *
+     * Includes two modes of use:
+     * <ol>
+     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
+     *      buffer size and sample index as parameters.</li>
+     *      <li>Update decode results via main loop (or any loop)</li>
+     * </ol>
+     *
+     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
+     *
+     * @param Yaw float for device/listener yaw angle: [Range: 0->360 | -180->180]
+     * @param Pitch float for device/listener pitch angle: [Range: -90->90]
+     * @param Roll float for device/listener roll angle: [Range: -90->90]
+     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
+     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
+     */
+    std::vector<PCM> decode(float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
+
+    /**
+     * Call with current update's angles to return the coefficients with which an incoming audio buffer
+     * may be decoded.
+     *
+     * Includes two modes of use:
+     * <ol>
+     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
+     *      buffer size and sample index as parameters.</li>
+     *      <li>Update decode results via main loop (or any loop)</li>
+     * </ol>
+     *
+     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
+     *
+     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
+     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
+     */
+    std::vector<PCM> decodeCoeffs(int bufferSize = 0, int sampleIndex = 0);
+
+    /**
+     * Call with current update's angles to return the coefficients with which an incoming audio buffer
+     * may be decoded.
+     *
+     * Includes two modes of use:
+     * <ol>
+     *      <li>Use your audio player's buffersize and current sample index for sync callbacks, with
+     *      buffer size and sample index as parameters.</li>
+     *      <li>Update decode results via main loop (or any loop)</li>
+     * </ol>
+     *
+     * Setting bufferSize and sampleIndex to 0 will enable the second mode.
+     *
+     * @param bufferSize int for number of samples in a buffer, ideally supplied from your audioplayer/engine
+     * @param sampleIndex int for current sample index array, ideally supplied from your audioplayer/engine
+     * @param applyPanLaw bool for control over panLaw application.
+     */
+    std::vector<PCM> decodePannedCoeffs(int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
+
+    std::vector<PCM> decodeCoeffsUsingTranscodeMatrix(std::vector<std::vector<float> > matrix, int channels, int bufferSize = 0, int sampleIndex = 0);
+
+    inline void decodeBuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size);
+
+    inline void decodeBufferInPlace(std::vector<std::vector<PCM> > &buffer, int size);
+
+    inline void decodeBufferRebuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size);
+
+    inline void decodeBufferInPlaceRebuffer(std::vector<std::vector<PCM> > &buffer, int size);
+
+    /**
+     * @brief Drive decodeBuffer from a queue of timestamped orientations instead of the last set rotation.
+     * Each queued orientation becomes a gain breakpoint at the sample offset matching its time, and gains
+     * are ramped linearly between breakpoints. Samples later than the current block stay queued.
+     * The angle filter steps by the time between queued samples, on its own clock that leaves setManualTime untouched.
+     * Breakpoint storage is reserved here from the queue capacity, so decodeBuffer does not allocate; a block
+     * that pops more orientations than that, pushed while it was being consumed, collapses the rest into its last breakpoint.
+     * @param queue filled by the tracker thread, consumed on the thread calling decodeBuffer; nullptr disables
+     * @param sampleRate of the buffers passed to decodeBuffer
+     */
+    void setOrientationQueue(Mach1OrientationQueue *queue, float sampleRate);
+
+    /**
+     * @brief Set the time in seconds, on the orientation queue's clock, of the first sample of the next
+     * decodeBuffer block. decodeBuffer advances it by the block length, so it only needs to be set again
+     * to resynchronize with the audio device clock.
+     */
+    void setBufferStartTime(double timeSeconds);
+
+    /**
+     * @brief Set how many samples decodeBuffer takes to move from the previous gains to the new ones,
+     * after which the new gains are held. 0 (default) ramps across the whole block or queue segment.
+     */
+    void setRampLength(int samples);
+
+    /**
+     * @brief Get the gain ramp length in samples.
+     */
+    int getRampLength();
+
+#ifndef __EMSCRIPTEN__
+    void decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
+    void decodeCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0);
+    void decodePannedCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
+
+    /**
+     * Return the coefficients together with their derivatives per degree of yaw, pitch and roll, so
+     * gains can be extrapolated inside a block from one evaluation:
+     * coeff[i] + dYaw * gradient[i] + dPitch * gradient[n + i] + dRoll * gradient[2 * n + i]
+     *
+     * Always evaluates the full decoding mode, the reduced decoding mode and coefficient reuse are ignored.
+     * The gains are not differentiable in pitch at a pitch of 0 (the vertical attenuation switches between the
+     * lower and upper channels); there d/dPitch is the one-sided derivative towards positive pitch.
+     *
+     * @param result float array of getFormatCoeffCount() coefficients
+     * @param gradient float array of 3 * getFormatCoeffCount() derivatives: all d/dYaw, then d/dPitch, then d/dRoll
+     */
+    void decodeCoeffsWithGradient(float *result, float *gradient);
+
+    /**
+     * @brief Get the internal log that has been accumulated into this Mach1Decode.
+     */
+    char *getLog();
+#else
+    /**
+     * @brief Get the internal log that has been accumulated into this Mach1Decode.
+     */
+    std::string getLog();
+#endif
+
+  private:
+    void *M1obj;
+    void *M1pool;
+    int M1poolIndex;
+    void *M1filterBank;
+
+    std::vector<float> old_decode_gains;
+
+    int ramp_length;
+
+    Mach1OrientationQueue *orientation_queue;
+    float queue_sample_rate;
+    double buffer_start_time;
+    std::vector<int> breakpoint_offsets;
+    std::vector<float> breakpoint_gains;
+    // breakpoints reserved by setOrientationQueue, including the two block ends
+    int max_breakpoints;
+    // angle filter clock running on the queue's timestamps, swapped in for each block
+    Mach1FilterClock queue_filter_clock;
+
+    inline void decodeBufferFromQueue(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size);
+    std::vector<std::vector<float> > intermediary_buffer;
+    int ib_channel_count;
+    size_t ib_buffer_size;
+};
+
+#endif // MACH1SPATIALSDK_MACH1DECODE_H
+
+// Implementation of Mach1Decode<PCM>
+#ifndef MACH1SPATIALSDK_MACH1DECODE_TPP
+#define MACH1SPATIALSDK_MACH1DECODE_TPP
+
+template <typename PCM>
+Mach1Decode<PCM>::Mach1Decode() {
+    M1obj = Mach1DecodeCAPI_create();
+    M1pool = nullptr;
+    M1poolIndex = -1;
+    M1filterBank = nullptr;
+    orientation_queue = nullptr;
+    queue_sample_rate = 48000;
+    max_breakpoints = 0;
+    queue_filter_clock = {true, 0, 0};
+    buffer_start_time = 0;
+    ramp_length = 0;
+}
+
+template <typename PCM>
+Mach1Decode<PCM>::Mach1Decode(void *pool) {
+    M1pool = pool;
+    M1poolIndex = Mach1DecodeCAPI_poolAcquire(M1pool);
+    M1obj = Mach1DecodeCAPI_poolGet(M1pool, M1poolIndex);
+
+    if (M1obj == nullptr) {
+        // pool is exhausted, fall back to a regular allocation
+        M1pool = nullptr;
+        M1poolIndex = -1;
+        M1obj = Mach1DecodeCAPI_create();
+    }
+
+    M1filterBank = nullptr;
+    orientation_queue = nullptr;
+    queue_sample_rate = 48000;
+    max_breakpoints = 0;
+    queue_filter_clock = {true, 0, 0};
+    buffer_start_time = 0;
+    ramp_length = 0;
+}
+
+template <typename PCM>
+Mach1Decode<PCM>::~Mach1Decode() {
+    setFilterBank(nullptr);
+
+    if (M1pool != nullptr) {
+        Mach1DecodeCAPI_poolRelease(M1pool, M1poolIndex);
+    } else {
+        Mach1DecodeCAPI_delete(M1obj);
+    }
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setFilterBank(void *filterBank) {
+    if (M1filterBank == filterBank) {
+        return;
+    }
+
+    if (M1filterBank != nullptr) {
+        Mach1DecodeCAPI_filterBankRemove(M1filterBank, M1obj);
+    }
+
+    M1filterBank = filterBank;
+
+    if (M1filterBank != nullptr) {
+        Mach1DecodeCAPI_filterBankAdd(M1filterBank, M1obj);
+    }
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setPlatformType(Mach1PlatformType type) {
+    Mach1DecodeCAPI_setPlatformType(M1obj, type);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setDecodeMode(Mach1DecodeMode mode) {
+    Mach1DecodeCAPI_setDecodeMode(M1obj, mode);
+}
+
+template <typename PCM>
+Mach1PlatformType Mach1Decode<PCM>::getPlatformType() {
+    return Mach1DecodeCAPI_getPlatformType(M1obj);
+}
+
+template <typename PCM>
+Mach1DecodeMode Mach1Decode<PCM>::getDecodeMode() {
+    return Mach1DecodeCAPI_getDecodeMode(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setReducedDecodeMode(Mach1DecodeMode mode) {
+    Mach1DecodeCAPI_setReducedDecodeMode(M1obj, mode);
+}
+
+template <typename PCM>
+Mach1DecodeMode Mach1Decode<PCM>::getReducedDecodeMode() {
+    return Mach1DecodeCAPI_getReducedDecodeMode(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setUsePitchForRotation(bool usePitchForRotation) {
+    Mach1DecodeCAPI_setUsePitchForRotation(M1obj, usePitchForRotation);
+}
+
+template <typename PCM>
+bool Mach1Decode<PCM>::getUsePitchForRotation() {
+    return Mach1DecodeCAPI_getUsePitchForRotation(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setUseRollForRotation(bool useRollForRotation) {
+    Mach1DecodeCAPI_setUseRollForRotation(M1obj, useRollForRotation);
+}
+
+template <typename PCM>
+bool Mach1Decode<PCM>::getUseRollForRotation() {
+    return Mach1DecodeCAPI_getUseRollForRotation(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setCoeffReuseThreshold(float thresholdDegrees) {
+    Mach1DecodeCAPI_setCoeffReuseThreshold(M1obj, thresholdDegrees);
+}
+
+template <typename PCM>
+float Mach1Decode<PCM>::getCoeffReuseThreshold() {
+    return Mach1DecodeCAPI_getCoeffReuseThreshold(M1obj);
+}
+
+template <typename PCM>
+float Mach1Decode<PCM>::getCoeffReuseRate() {
+    return Mach1DecodeCAPI_getCoeffReuseRate(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::resetCoeffReuseRate() {
+    Mach1DecodeCAPI_resetCoeffReuseRate(M1obj);
+}
+
+#ifndef __EMSCRIPTEN__
+template <typename PCM>
+void Mach1Decode<PCM>::decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex) {
+    Mach1DecodeCAPI_decode(M1obj, Yaw, Pitch, Roll, result, bufferSize, sampleIndex);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeCoeffs(float *result, int bufferSize, int sampleIndex) {
+    Mach1DecodeCAPI_decodeCoeffs(M1obj, result, bufferSize, sampleIndex);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodePannedCoeffs(float *result, int bufferSize, int sampleIndex, bool applyPanLaw) {
+    Mach1DecodeCAPI_decodePannedCoeffs(M1obj, result, bufferSize, sampleIndex, applyPanLaw);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeCoeffsWithGradient(float *result, float *gradient) {
+    Mach1DecodeCAPI_decodeCoeffsWithGradient(M1obj, result, gradient);
+}
+#endif
+
+template <typename PCM>
+std::vector<PCM> Mach1Decode<PCM>::decode(float Yaw, float Pitch, float Roll, int bufferSize, int sampleIndex) {
+    std::vector<PCM> vec(getFormatCoeffCount());
+
+    Mach1DecodeCAPI_decode(M1obj, Yaw, Pitch, Roll, vec.data(), bufferSize, sampleIndex);
+
+    return vec;
+}
+
+template <typename PCM>
+std::vector<PCM> Mach1Decode<PCM>::decodeCoeffs(int bufferSize, int sampleIndex) {
+    std::vector<PCM> vec(getFormatCoeffCount());
+
+    Mach1DecodeCAPI_decodeCoeffs(M1obj, vec.data(), bufferSize, sampleIndex);
+
+    return vec;
+}
+
+template <typename PCM>
+std::vector<PCM> Mach1Decode<PCM>::decodePannedCoeffs(int bufferSize, int sampleIndex, bool applyPanLaw) {
+    std::vector<PCM> vec(getFormatCoeffCount());
+
+    Mach1DecodeCAPI_decodePannedCoeffs(M1obj, vec.data(), bufferSize, sampleIndex, applyPanLaw);
+
+    return vec;
+}
+
+template <typename PCM>
+std::vector<PCM> Mach1Decode<PCM>::decodeCoeffsUsingTranscodeMatrix(std::vector<std::vector<float> > matrix, int channels, int bufferSize, int sampleIndex) {
+    std::vector<PCM> vec(2 * channels);
+
+    int inChans = channels;
+    int outChans = getFormatChannelCount();
+
+    float *m = new float[inChans * outChans];
+    for (int i = 0; i < outChans; i++) {
+        for (int j = 0; j < inChans; j++) {
+            m[i * inChans + j] = matrix[i][j];
+        }
+    }
+
+    Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(M1obj, m, channels, vec.data(), bufferSize, sampleIndex);
+
+    delete[] m;
+    return vec;
+}
+
+template <typename PCM>
+int Mach1Decode<PCM>::getFormatChannelCount() {
+    return Mach1DecodeCAPI_getFormatChannelCount(M1obj);
+}
+
+template <typename PCM>
+int Mach1Decode<PCM>::getFormatCoeffCount() {
+    return Mach1DecodeCAPI_getFormatCoeffCount(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRotation(Mach1Point3D newRotationFromMinusOnetoOne) {
+    Mach1DecodeCAPI_setRotation(M1obj, newRotationFromMinusOnetoOne);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRotationDegrees(Mach1Point3D newRotationDegrees) {
+    Mach1DecodeCAPI_setRotationDegrees(M1obj, newRotationDegrees);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRotationRadians(Mach1Point3D newRotationRadians) {
+    Mach1DecodeCAPI_setRotationRadians(M1obj, newRotationRadians);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRotationQuat(Mach1Point4D newRotationQuat) {
+    Mach1DecodeCAPI_setRotationQuat(M1obj, newRotationQuat);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRotationDegreesAtTime(Mach1Point3D newRotationDegrees, double timeSeconds) {
+    Mach1DecodeCAPI_setRotationDegreesAtTime(M1obj, newRotationDegrees, timeSeconds);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setPredictionTargetTime(double timeSeconds) {
+    Mach1DecodeCAPI_setPredictionTargetTime(M1obj, timeSeconds);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setPredictionHorizon(float maxSeconds) {
+    Mach1DecodeCAPI_setPredictionHorizon(M1obj, maxSeconds);
+}
+
+template <typename PCM>
+float Mach1Decode<PCM>::getPredictionHorizon() {
+    return Mach1DecodeCAPI_getPredictionHorizon(M1obj);
+}
+
+template <typename PCM>
+Mach1Point3D Mach1Decode<PCM>::getPredictedRotation() {
+    return Mach1DecodeCAPI_getPredictedRotation(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setFilterSpeed(float filterSpeed) {
+    Mach1DecodeCAPI_setFilterSpeed(M1obj, filterSpeed);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setManualTime(long milliseconds) {
+    Mach1DecodeCAPI_setManualTime(M1obj, milliseconds);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::clearManualTime() {
+    Mach1DecodeCAPI_clearManualTime(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setDeterministic(bool enable) {
+    Mach1DecodeCAPI_setDeterministic(M1obj, enable);
+}
+
+template <typename PCM>
+bool Mach1Decode<PCM>::getDeterministic() {
+    return Mach1DecodeCAPI_getDeterministic(M1obj);
+}
+
+template <typename PCM>
+long Mach1Decode<PCM>::getCurrentTime() {
+    return Mach1DecodeCAPI_getCurrentTime(M1obj);
+}
+
+#ifndef __EMSCRIPTEN__
+template <typename PCM>
+char *Mach1Decode<PCM>::getLog() {
+    return Mach1DecodeCAPI_getLog(M1obj);
+}
+#else
+template <typename PCM>
+std::string Mach1Decode<PCM>::getLog() {
+    return std::string(Mach1DecodeCAPI_getLog(M1obj));
+    /// Returns the current elapsed time in milliseconds (ms) since Mach1Decode object creation
+}
+#endif
+
+template <typename PCM>
+Mach1Point3D Mach1Decode<PCM>::getCurrentAngle() {
+    return Mach1DecodeCAPI_getCurrentAngle(M1obj);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeBuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size) {
+    if (orientation_queue != nullptr) {
+        decodeBufferFromQueue(in, out, size);
+        return;
+    }
+
+    // get output gain multipliers
+    auto decode_gains = decodeCoeffs(); // TODO: Implement interpolation between coeffs.
+
+    if (old_decode_gains.size() != decode_gains.size()) {
+        old_decode_gains = decode_gains;
+    }
+
+    int ramp_samples = (ramp_length > 0 && ramp_length < size) ? ramp_length : size;
+    float ramp_reciprocal = 1.0f / (float)ramp_samples;
+
+    // process the samples manually
+    for (int decode_idx = 0, output_idx = 0; decode_idx < decode_gains.size(); decode_idx += 2, output_idx += 1) {
+        auto left_gain = decode_gains[decode_idx + 0];
+        auto right_gain = decode_gains[decode_idx + 1];
+        auto old_left_gain = old_decode_gains[decode_idx + 0];
+        auto old_right_gain = old_decode_gains[decode_idx + 1];
+
+        for (int sample_idx = 0; sample_idx < size; sample_idx++) {
+            auto prc = sample_idx < ramp_samples ? (float)sample_idx * ramp_reciprocal : 1.0f;
+            auto left = old_left_gain * (1.0f - prc) + left_gain * prc;
+            auto right = old_right_gain * (1.0f - prc) + right_gain * prc;
+
+            // get the sample in each loop
+            float sample = in[output_idx][sample_idx];
+
+            // clear the output for the new values to come in
+            out[output_idx][sample_idx] = 0;
+            out[0][sample_idx] += sample * left;
+            out[1][sample_idx] += sample * right;
+        }
+    }
+
+    old_decode_gains = decode_gains;
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setOrientationQueue(Mach1OrientationQueue *queue, float sampleRate) {
+    orientation_queue = queue;
+    queue_sample_rate = sampleRate;
+    queue_filter_clock = {true, 0, 0};
+
+    // a block holds at most a queue's worth of samples plus its two end points, decodeBuffer enforces the bound
+    if (queue != nullptr) {
+        max_breakpoints = queue->getCapacity() + 2;
+        breakpoint_offsets.reserve(max_breakpoints);
+        breakpoint_gains.reserve(max_breakpoints * 14 * 2);
+        old_decode_gains.reserve(14 * 2);
+    }
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setBufferStartTime(double timeSeconds) {
+    buffer_start_time = timeSeconds;
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::setRampLength(int samples) {
+    ramp_length = samples < 0 ? 0 : samples;
+}
+
+template <typename PCM>
+int Mach1Decode<PCM>::getRampLength() {
+    return ramp_length;
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeBufferFromQueue(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size) {
+    int coeff_count = getFormatCoeffCount();
+    double buffer_end_time = buffer_start_time + size / (double)queue_sample_rate;
+
+    if ((int)old_decode_gains.size() != coeff_count) {
+        old_decode_gains.resize(coeff_count);
+        Mach1DecodeCAPI_decodeCoeffs(M1obj, old_decode_gains.data(), 0, 0);
+    }
+
+    // breakpoint 0 is the end of the previous block, then one per orientation due in this block
+    breakpoint_offsets.clear();
+    breakpoint_offsets.push_back(0);
+    breakpoint_gains.resize(coeff_count);
+    memcpy(breakpoint_gains.data(), old_decode_gains.data(), sizeof(float) * coeff_count);
+
+    // the angle filter steps by the time between samples rather than by when the block happens to be processed
+    Mach1FilterClock caller_clock = Mach1DecodeCAPI_swapFilterClock(M1obj, queue_filter_clock);
+
+    Mach1OrientationSample sample;
+    while (orientation_queue->peek(sample) && sample.time < buffer_end_time) {
+        orientation_queue->pop(sample);
+
+        int offset = (int)((sample.time - buffer_start_time) * queue_sample_rate);
+        if (offset < breakpoint_offsets.back()) {
+            offset = breakpoint_offsets.back(); // late or out of order samples apply immediately
+        }
+
+        // several orientations landing on the same sample collapse into the newest one, and so does every
+        // orientation past the reserved breakpoints, which keeps room for the end of the block
+        bool is_new_offset = offset != breakpoint_offsets.back() || breakpoint_offsets.size() == 1;
+        if (is_new_offset && (int)breakpoint_offsets.size() + 1 < max_breakpoints) {
+            breakpoint_offsets.push_back(offset);
+            breakpoint_gains.resize(breakpoint_gains.size() + coeff_count);
+        }
+
+        Mach1DecodeCAPI_setRotationDegreesAtTime(M1obj, sample.rotationDegrees, sample.time);
+        Mach1DecodeCAPI_setManualTime(M1obj, (long)(sample.time * 1000.0));
+        Mach1DecodeCAPI_decodeCoeffs(M1obj, breakpoint_gains.data() + breakpoint_gains.size() - coeff_count, 0, 0);
+    }
+
+    queue_filter_clock = Mach1DecodeCAPI_swapFilterClock(M1obj, caller_clock);
+
+    // hold the last breakpoint to the end of the block
+    breakpoint_offsets.push_back(size);
+    breakpoint_gains.resize(breakpoint_gains.size() + coeff_count);
+    memcpy(breakpoint_gains.data() + breakpoint_gains.size() - coeff_count, breakpoint_gains.data() + breakpoint_gains.size() - 2 * coeff_count, sizeof(float) * coeff_count);
+
+    int breakpoint_count = (int)breakpoint_offsets.size();
+
+    for (int decode_idx = 0, output_idx = 0; decode_idx < coeff_count; decode_idx += 2, output_idx += 1) {
+        for (int segment = 0; segment + 1 < breakpoint_count; segment++) {
+            int segment_start = breakpoint_offsets[segment];
+            int segment_end = breakpoint_offsets[segment + 1];
+            if (segment_end <= segment_start) {
+                continue;
+            }
+
+            const float *from = breakpoint_gains.data() + segment * coeff_count + decode_idx;
+            const float *to = from + coeff_count;
+            int ramp_samples = (ramp_length > 0 && ramp_length < segment_end - segment_start) ? ramp_length : segment_end - segment_start;
+            float ramp_reciprocal = 1.0f / (float)ramp_samples;
+
+            for (int sample_idx = segment_start; sample_idx < segment_end; sample_idx++) {
+                auto prc = sample_idx - segment_start < ramp_samples ? (float)(sample_idx - segment_start) * ramp_reciprocal : 1.0f;
+                auto left = from[0] * (1.0f - prc) + to[0] * prc;
+                auto right = from[1] * (1.0f - prc) + to[1] * prc;
+
+                // get the sample in each loop
+                float sample_value = in[output_idx][sample_idx];
+
+                // clear the output for the new values to come in
+                out[output_idx][sample_idx] = 0;
+                out[0][sample_idx] += sample_value * left;
+                out[1][sample_idx] += sample_value * right;
+            }
+        }
+    }
+
+    memcpy(old_decode_gains.data(), breakpoint_gains.data() + breakpoint_gains.size() - coeff_count, sizeof(float) * coeff_count);
+    buffer_start_time = buffer_end_time;
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeBufferInPlace(std::vector<std::vector<PCM> > &buffer, int size) {
+    decodeBuffer(buffer, buffer, size);
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeBufferRebuffer(std::vector<std::vector<PCM> > &in, std::vector<std::vector<PCM> > &out, int size) {
+    auto channel_count = 2;
+
+    // restructure intermediary buffer
+    if (ib_channel_count != channel_count || ib_buffer_size != size) {
+        intermediary_buffer.resize(channel_count);
+
+        for (int i = 0; i < channel_count; i++) {
+            intermediary_buffer[i].resize(size);
+        }
+
+        ib_channel_count = channel_count;
+        ib_buffer_size = size;
+    }
+
+    // clear intermediary buffer
+    for (int i = 0; i < ib_channel_count; i++) {
+        memset(intermediary_buffer[i].data(), 0, sizeof(float) * ib_buffer_size);
+    }
+
+    // get output gain multipliers
+    auto decode_gains = decodeCoeffs(); // TODO: Implement interpolation between coeffs.
+
+    if (old_decode_gains.size() != decode_gains.size()) {
+        old_decode_gains = decode_gains;
+    }
+
+    int ramp_samples = (ramp_length > 0 && ramp_length < size) ? ramp_length : size;
+    float ramp_reciprocal = 1.0f / (float)ramp_samples;
+
+    // process the samples manually
+    for (int decode_idx = 0, output_idx = 0; decode_idx < decode_gains.size(); decode_idx += 2, output_idx += 1) {
+        auto left_gain = decode_gains[decode_idx + 0];
+        auto right_gain = decode_gains[decode_idx + 1];
+        auto old_left_gain = old_decode_gains[decode_idx + 0];
+        auto old_right_gain = old_decode_gains[decode_idx + 1];
+
+        for (int sample_idx = 0; sample_idx < size; sample_idx++) {
+            auto prc = sample_idx < ramp_samples ? (float)sample_idx * ramp_reciprocal : 1.0f;
+            auto left = old_left_gain * (1.0f - prc) + left_gain * prc;
+            auto right = old_right_gain * (1.0f - prc) + right_gain * prc;
+
+            // get the sample in each loop
+            float sample = in[output_idx][sample_idx];
+
+            intermediary_buffer[0][sample_idx] += sample * left;
+            intermediary_buffer[1][sample_idx] += sample * right;
+        }
+    }
+
+    // copy over values in intermediary buffer to output buffer
+    for (int output_idx = 0; output_idx < channel_count; output_idx++) {
+        memcpy(out[output_idx].data(), intermediary_buffer[output_idx].data(), sizeof(float) * size);
+    }
+
+    old_decode_gains = decode_gains;
+}
+
+template <typename PCM>
+void Mach1Decode<PCM>::decodeBufferInPlaceRebuffer(std::vector<std::vector<PCM> > &buffer, int size) {
+    decodeBufferRebuffer(buffer, buffer, size);
+}
+
+#endif // MACH1SPATIALSDK_MACH1DECODE_TPP
@@ -1,78 +1,124 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#pragma once
-
-#include "Mach1Point3D.h"
-#include "Mach1Point4D.h"
-
-#if defined(Mach1DecodeCore_h) || defined(Mach1EncodeCore_h) || defined(Mach1PositionalCore_h) || defined(Mach1TranscodeCore_h) || defined(Mach1AudioTimelineCore_h)
-#    ifndef M1_API
-#        if defined(_WINDOWS) || defined(_WIN32)
-#            define M1_API __declspec(dllexport)
-#        else
-#            define M1_API
-#        endif
-#    endif
-#else
-#    ifndef M1_API
-#        if !defined(M1_STATIC) && (defined(_WINDOWS) || defined(_WIN32))
-#            define M1_API __declspec(dllimport)
-#        else
-#            define M1_API
-#        endif
-#    endif
-#endif
-
-enum Mach1PlatformType {
-    Mach1PlatformDefault = (int)0,
-    Mach1PlatformUnity,
-    Mach1PlatformUE,
-    Mach1PlatformOfEasyCam,
-    Mach1PlatformAndroid,
-    Mach1PlatformiOS,
-    Mach1PlatformiOSTableTop_ZVertical,
-    Mach1PlatformiOSPortraitHandheld_YVertical,
-    Mach1PlatformiOSPortrait_YawOnly
-};
-
-enum Mach1DecodeMode {
-    M1DecodeSpatial_4 = (int)0,
-    M1DecodeSpatial_8,
-    M1DecodeSpatial_14,
-};
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-M1_API void *Mach1DecodeCAPI_create();
-M1_API void Mach1DecodeCAPI_delete(void *M1obj);
-
-M1_API void Mach1DecodeCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
-M1_API void Mach1DecodeCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType platformType);
-
-M1_API enum Mach1DecodeMode Mach1DecodeCAPI_getDecodeMode(void *M1obj);
-M1_API enum Mach1PlatformType Mach1DecodeCAPI_getPlatformType(void *M1obj);
-
-M1_API void Mach1DecodeCAPI_decode(void *M1obj, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex);
-M1_API void Mach1DecodeCAPI_decodeCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex);
-M1_API void Mach1DecodeCAPI_decodePannedCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex, bool applyPanLaw);
-M1_API void Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex);
-
-M1_API void Mach1DecodeCAPI_setFilterSpeed(void *M1obj, float filterSpeed);
-M1_API int Mach1DecodeCAPI_getFormatChannelCount(void *M1obj);
-M1_API int Mach1DecodeCAPI_getFormatCoeffCount(void *M1obj);
-M1_API void Mach1DecodeCAPI_setRotation(void *M1obj, Mach1Point3D newRotationFromMinusOnetoOne);
-M1_API void Mach1DecodeCAPI_setRotationDegrees(void *M1obj, Mach1Point3D newRotationDegrees);
-M1_API void Mach1DecodeCAPI_setRotationRadians(void *M1obj, Mach1Point3D newRotationRadians);
-M1_API void Mach1DecodeCAPI_setRotationQuat(void *M1obj, Mach1Point4D newRotationQuat);
-
-M1_API long Mach1DecodeCAPI_getCurrentTime(void *M1obj);
-M1_API long Mach1DecodeCAPI_getLastCalculationTime(void *M1obj);
-
-M1_API char *Mach1DecodeCAPI_getLog(void *M1obj);
-
-M1_API Mach1Point3D Mach1DecodeCAPI_getCurrentAngle(void *M1obj);
-#ifdef __cplusplus
-}
-#endif
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#pragma once
+
+#include "Mach1Point3D.h"
+#include "Mach1Point4D.h"
+
+#if defined(Mach1DecodeCore_h) || defined(Mach1EncodeCore_h) || defined(Mach1PositionalCore_h) || defined(Mach1TranscodeCore_h) || defined(Mach1AudioTimelineCore_h)
+#    ifndef M1_API
+#        if defined(_WINDOWS) || defined(_WIN32)
+#            define M1_API __declspec(dllexport)
+#        else
+#            define M1_API
+#        endif
+#    endif
+#else
+#    ifndef M1_API
+#        if !defined(M1_STATIC) && (defined(_WINDOWS) || defined(_WIN32))
+#            define M1_API __declspec(dllimport)
+#        else
+#            define M1_API
+#        endif
+#    endif
+#endif
+
+enum Mach1PlatformType {
+    Mach1PlatformDefault = (int)0,
+    Mach1PlatformUnity,
+    Mach1PlatformUE,
+    Mach1PlatformOfEasyCam,
+    Mach1PlatformAndroid,
+    Mach1PlatformiOS,
+    Mach1PlatformiOSTableTop_ZVertical,
+    Mach1PlatformiOSPortraitHandheld_YVertical,
+    Mach1PlatformiOSPortrait_YawOnly
+};
+
+enum Mach1DecodeMode {
+    M1DecodeSpatial_4 = (int)0,
+    M1DecodeSpatial_8,
+    M1DecodeSpatial_14,
+};
+
+// Angle filter clock of a decoder: caller supplied or system time, and the time of the filter's last step
+struct Mach1FilterClock {
+    bool useManualTime;
+    long manualTime;
+    long timeLastUpdate;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+M1_API void *Mach1DecodeCAPI_create();
+M1_API void Mach1DecodeCAPI_delete(void *M1obj);
+
+// Pooled decoders: slots are reserved up front in one contiguous arena and handed out by index
+M1_API void *Mach1DecodeCAPI_createPool(int capacity);
+M1_API void Mach1DecodeCAPI_deletePool(void *M1pool);
+M1_API int Mach1DecodeCAPI_poolAcquire(void *M1pool);
+M1_API void Mach1DecodeCAPI_poolRelease(void *M1pool, int index);
+M1_API void *Mach1DecodeCAPI_poolGet(void *M1pool, int index);
+M1_API int Mach1DecodeCAPI_poolGetIndex(void *M1pool, void *M1obj);
+M1_API int Mach1DecodeCAPI_poolGetCapacity(void *M1pool);
+M1_API int Mach1DecodeCAPI_poolGetActiveCount(void *M1pool);
+
+// Filter banks: run the angle filter of many decoders in one pass, see Mach1DecodeFilterBank.h
+M1_API void *Mach1DecodeCAPI_createFilterBank();
+M1_API void Mach1DecodeCAPI_deleteFilterBank(void *M1filterBank);
+M1_API int Mach1DecodeCAPI_filterBankAdd(void *M1filterBank, void *M1obj);
+M1_API void Mach1DecodeCAPI_filterBankRemove(void *M1filterBank, void *M1obj);
+M1_API void Mach1DecodeCAPI_filterBankUpdate(void *M1filterBank, long currentTimeMilliseconds);
+M1_API int Mach1DecodeCAPI_filterBankGetCount(void *M1filterBank);
+
+M1_API void Mach1DecodeCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
+M1_API void Mach1DecodeCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType platformType);
+
+M1_API enum Mach1DecodeMode Mach1DecodeCAPI_getDecodeMode(void *M1obj);
+M1_API void Mach1DecodeCAPI_setReducedDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
+M1_API enum Mach1DecodeMode Mach1DecodeCAPI_getReducedDecodeMode(void *M1obj);
+M1_API void Mach1DecodeCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation);
+M1_API bool Mach1DecodeCAPI_getUsePitchForRotation(void *M1obj);
+M1_API void Mach1DecodeCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation);
+M1_API bool Mach1DecodeCAPI_getUseRollForRotation(void *M1obj);
+M1_API void Mach1DecodeCAPI_setCoeffReuseThreshold(void *M1obj, float thresholdDegrees);
+M1_API float Mach1DecodeCAPI_getCoeffReuseThreshold(void *M1obj);
+M1_API float Mach1DecodeCAPI_getCoeffReuseRate(void *M1obj);
+M1_API void Mach1DecodeCAPI_resetCoeffReuseRate(void *M1obj);
+M1_API enum Mach1PlatformType Mach1DecodeCAPI_getPlatformType(void *M1obj);
+
+M1_API void Mach1DecodeCAPI_decode(void *M1obj, float Yaw, float Pitch, float Roll, float *result, int bufferSize, int sampleIndex);
+M1_API void Mach1DecodeCAPI_decodeCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex);
+M1_API void Mach1DecodeCAPI_decodePannedCoeffs(void *M1obj, float *result, int bufferSize, int sampleIndex, bool applyPanLaw);
+M1_API void Mach1DecodeCAPI_decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize, int sampleIndex);
+M1_API void Mach1DecodeCAPI_decodeCoeffsWithGradient(void *M1obj, float *result, float *gradient);
+
+M1_API void Mach1DecodeCAPI_setFilterSpeed(void *M1obj, float filterSpeed);
+M1_API int Mach1DecodeCAPI_getFormatChannelCount(void *M1obj);
+M1_API int Mach1DecodeCAPI_getFormatCoeffCount(void *M1obj);
+M1_API void Mach1DecodeCAPI_setRotation(void *M1obj, Mach1Point3D newRotationFromMinusOnetoOne);
+M1_API void Mach1DecodeCAPI_setRotationDegrees(void *M1obj, Mach1Point3D newRotationDegrees);
+M1_API void Mach1DecodeCAPI_setRotationRadians(void *M1obj, Mach1Point3D newRotationRadians);
+M1_API void Mach1DecodeCAPI_setRotationQuat(void *M1obj, Mach1Point4D newRotationQuat);
+M1_API void Mach1DecodeCAPI_setRotationDegreesAtTime(void *M1obj, Mach1Point3D newRotationDegrees, double timeSeconds);
+M1_API void Mach1DecodeCAPI_setPredictionTargetTime(void *M1obj, double timeSeconds);
+M1_API void Mach1DecodeCAPI_setPredictionHorizon(void *M1obj, float maxSeconds);
+M1_API float Mach1DecodeCAPI_getPredictionHorizon(void *M1obj);
+M1_API Mach1Point3D Mach1DecodeCAPI_getPredictedRotation(void *M1obj);
+
+M1_API long Mach1DecodeCAPI_getCurrentTime(void *M1obj);
+M1_API void Mach1DecodeCAPI_setManualTime(void *M1obj, long milliseconds);
+M1_API void Mach1DecodeCAPI_clearManualTime(void *M1obj);
+M1_API struct Mach1FilterClock Mach1DecodeCAPI_swapFilterClock(void *M1obj, struct Mach1FilterClock clock);
+M1_API void Mach1DecodeCAPI_setDeterministic(void *M1obj, bool enable);
+M1_API bool Mach1DecodeCAPI_getDeterministic(void *M1obj);
+M1_API long Mach1DecodeCAPI_getLastCalculationTime(void *M1obj);
+
+M1_API char *Mach1DecodeCAPI_getLog(void *M1obj);
+
+M1_API Mach1Point3D Mach1DecodeCAPI_getCurrentAngle(void *M1obj);
+#ifdef __cplusplus
+}
+#endif
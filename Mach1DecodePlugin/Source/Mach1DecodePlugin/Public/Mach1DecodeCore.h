@@ -1,149 +1,266 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-/*
-DISCLAIMER:
-This header file is not an example of use but an decoder that will require periodic
-updates and should not be integrated in sections but remain as an update-able factored file.
-*/
-
-/*
-Internal Orientation Implementation:
-    -  Yaw   [0]+ = rotate right 0-1 [Range: 0->360 | -180->180]
-    -  Yaw   [0]- = rotate left 0-1  [Range: 0->360 | -180->180]
-    -  Pitch [1]+ = rotate up 0-1    [Range: -90->90]
-    -  Pitch [1]- = rotate down 0-1  [Range: -90->90]
-    -  Roll  [2]+ = rotate up 0-1    [Range: -90->90]
-    -  Roll  [2]- = rotate down 0-1  [Range: -90->90]
-
-M1DecodeCore normalizes all input ranges to an unsigned "0 to 1" range for Yaw, Pitch and Roll.
- */
-
-#pragma once
-
-#include <chrono>
-#include <string>
-#include <vector>
-
-#include "Mach1DecodeCAPI.h"
-#include "Mach1Point3D.h"
-#include "Mach1Point4D.h"
-
-#ifndef SWIG
-using namespace std::chrono;
-#endif
-
-#ifndef PI
-#    define PI 3.14159265358979323846f
-#endif
-
-//////////////
-
-class M1DecodeCore {
-
-  public:
-    static float mDegToRad(float degrees);
-    static float mmap(float value, float inputMin, float inputMax, float outputMin, float outputMax, bool clamp = false);
-    static float clamp(float a, float min, float max);
-
-  private:
-    // TODO: Why do we use typedef? Can we remove it?
-    typedef std::vector<float> (M1DecodeCore::*processSampleForMultichannel)(float Yaw, float Pitch, float Roll);
-    typedef void (M1DecodeCore::*processSampleForMultichannelPtr)(float Yaw, float Pitch, float Roll, float *result);
-
-    std::vector<float> processSample(processSampleForMultichannel _processSampleForMultichannel, float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
-    void processSample(processSampleForMultichannelPtr _processSampleForMultichannelPtr, float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
-
-    // Math utilities
-    static float alignAngle(float a, float min = -180, float max = 180);
-    static float lerp(float x1, float x2, float t);
-    float radialDistance(float angle1, float angle2);
-    float targetDirectionMultiplier(float angleCurrent, float angleTarget);
-    inline float _dot(const Mach1Point3D &p1, const Mach1Point3D &p2) const;
-    bool linePlaneIntersection(Mach1Point3D &contact, Mach1Point3D ray, Mach1Point3D rayOrigin, Mach1Point3D normal, Mach1Point3D coord);
-    
-    // Filter features
-    // Envelope follower feature is defined here, in updateAngles()
-    void updateAngles();
-    float currentYaw, currentPitch, currentRoll;
-    float targetYaw, targetPitch, targetRoll;
-    float previousYaw, previousPitch, previousRoll;
-
-    milliseconds ms;
-    long timeLastUpdate;
-    long timeLastCalculation;
-
-    Mach1PlatformType platformType;
-    Mach1DecodeMode decodeMode;
-
-    void spatialMultichannelAlgo(Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *result);
-    
-    void spatialAlgo_4(float Yaw, float Pitch, float Roll, float *result);
-    std::vector<float> spatialAlgo_4(float Yaw, float Pitch, float Roll);
-
-    void spatialAlgo_8(float Yaw, float Pitch, float Roll, float *result);
-    std::vector<float> spatialAlgo_8(float Yaw, float Pitch, float Roll);
-
-    void spatialAlgo_14(float Yaw, float Pitch, float Roll, float *result);
-    std::vector<float> spatialAlgo_14(float Yaw, float Pitch, float Roll);
-
-    // log
-    std::vector<std::string> strLog;
-    void addToLog(std::string str, int maxCount = 100);
-
-    Mach1Point3D rotation;
-
-  public:
-    char *getLog();
-    float filterSpeed;
-
-    // Angular settings functions
-    static void convertAnglesToMach1(Mach1PlatformType platformType, float *Y, float *P, float *R);
-    static void convertAnglesToPlatform(Mach1PlatformType platformType, float *Y, float *P, float *R);
-    // static void convertQuaternionToMach1(Mach1PlatformType platformType, float* X, float* Y, float* Z, float* W);
-    // static void convertQuaternionToPlatform(Mach1PlatformType platformType, float* Y, float* P, float* R);
-
-    Mach1Point3D getCurrentAngle();
-
-    M1DecodeCore();
-
-    void setPlatformType(Mach1PlatformType type);
-    Mach1PlatformType getPlatformType();
-
-    int getFormatChannelCount();
-    int getFormatCoeffCount();
-
-    void setRotation(Mach1Point3D newRotationFromMinusOnetoOne);
-    void setRotationDegrees(Mach1Point3D newRotationDegrees);
-    void setRotationRadians(Mach1Point3D newRotationRadians);
-    void setRotationQuat(Mach1Point4D newRotationQuat);
-
-    void setFilterSpeed(float filterSpeed);
-
-    long getCurrentTime();
-    long getLastCalculationTime();
-
-    // Set the algorithm type to use when decoding
-
-    void setDecodeMode(Mach1DecodeMode mode);
-    Mach1DecodeMode getDecodeMode();
-
-    // Decode using the current algorithm type
-
-    //  Order of input angles:
-    //  Y = Yaw in degrees
-    //  P = Pitch in degrees
-    //  R = Roll in degrees
-
-    std::vector<float> decode(float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
-    std::vector<float> decodeCoeffs(int bufferSize = 0, int sampleIndex = 0);
-    std::vector<float> decodePannedCoeffs(int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
-
-    // Decode using the current algorithm type in a more efficient way
-
-    void decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
-    void decodeCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0);
-    void decodePannedCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
-    void decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize = 0, int sampleIndex = 0);
-
-};
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This header file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+/*
+Internal Orientation Implementation:
+    -  Yaw   [0]+ = rotate right 0-1 [Range: 0->360 | -180->180]
+    -  Yaw   [0]- = rotate left 0-1  [Range: 0->360 | -180->180]
+    -  Pitch [1]+ = rotate up 0-1    [Range: -90->90]
+    -  Pitch [1]- = rotate down 0-1  [Range: -90->90]
+    -  Roll  [2]+ = rotate up 0-1    [Range: -90->90]
+    -  Roll  [2]- = rotate down 0-1  [Range: -90->90]
+
+M1DecodeCore normalizes all input ranges to an unsigned "0 to 1" range for Yaw, Pitch and Roll.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Mach1DecodeCAPI.h"
+#include "Mach1Point3D.h"
+#include "Mach1Point4D.h"
+
+#ifndef SWIG
+using namespace std::chrono;
+#endif
+
+#ifndef PI
+#    define PI 3.14159265358979323846f
+#endif
+
+#ifndef M1_ROTATION_HISTORY_SIZE
+#    define M1_ROTATION_HISTORY_SIZE 3
+#endif
+
+#ifndef M1_MAX_PREDICTION_HORIZON
+#    define M1_MAX_PREDICTION_HORIZON 0.25f // seconds, beyond this head motion is not predictable
+#endif
+
+//////////////
+
+class Mach1DecodeFilterBank;
+
+class M1DecodeCore {
+
+  public:
+    static float mDegToRad(float degrees);
+    static float mmap(float value, float inputMin, float inputMax, float outputMin, float outputMax, bool clamp = false);
+    static float clamp(float a, float min, float max);
+
+  private:
+    // TODO: Why do we use typedef? Can we remove it?
+    typedef std::vector<float> (M1DecodeCore::*processSampleForMultichannel)(float Yaw, float Pitch, float Roll);
+    typedef void (M1DecodeCore::*processSampleForMultichannelPtr)(float Yaw, float Pitch, float Roll, float *result);
+
+    std::vector<float> processSample(processSampleForMultichannel _processSampleForMultichannel, float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
+    void processSample(processSampleForMultichannelPtr _processSampleForMultichannelPtr, float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
+
+    // Math utilities
+    static float alignAngle(float a, float min = -180, float max = 180);
+    void sinCosDegrees(float degrees, float &s, float &c);
+    static float lerp(float x1, float x2, float t);
+    float radialDistance(float angle1, float angle2);
+    float targetDirectionMultiplier(float angleCurrent, float angleTarget);
+    inline float _dot(const Mach1Point3D &p1, const Mach1Point3D &p2) const;
+    bool linePlaneIntersection(Mach1Point3D &contact, Mach1Point3D ray, Mach1Point3D rayOrigin, Mach1Point3D normal, Mach1Point3D coord);
+    
+    // Filter features
+    // Envelope follower feature is defined here, in updateAngles()
+    void updateAngles();
+    // Zeroes the locked axes of a target before it is filtered, so the filter glides them to a level listener
+    void lockAngles(float &Pitch, float &Roll);
+    void filterAngles(float &Yaw, float &Pitch, float &Roll);
+    float currentYaw, currentPitch, currentRoll;
+    float targetYaw, targetPitch, targetRoll;
+    float previousYaw, previousPitch, previousRoll;
+
+    milliseconds ms;
+    long timeLastUpdate;
+    long timeLastCalculation;
+    bool useManualTime;
+    long manualTime;
+    bool deterministic;
+
+    // When set, the bank runs this decoder's angle filter in its per-frame update
+    Mach1DecodeFilterBank *filterBank;
+    int filterBankLane;
+
+    Mach1PlatformType platformType;
+    Mach1DecodeMode decodeMode;
+    Mach1DecodeMode reducedDecodeMode;
+    bool usePitchForRotation;
+    bool useRollForRotation;
+
+    // Coefficients of the reduced algorithm before they are transcoded to decodeMode
+    float reducedCoeffs[14 * 2];
+    static void transcodeReducedCoeffs(Mach1DecodeMode reducedMode, Mach1DecodeMode mode, const float *reduced, float *result);
+
+    void spatialMultichannelAlgo(const Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *result);
+    void spatialAlgoYaw_Corners(float Yaw, int numLayers, float *result);
+    void spatialMultichannelGradient(const Mach1Point3D *channelPoints, int numChannelPoints, float Yaw, float Pitch, float Roll, float *gradient);
+
+    // Coefficient reuse: last evaluated (filtered) orientation and its coefficients
+    float coeffReuseThreshold;
+    int cachedNumChannelPoints;
+    float cachedAngles[3];
+    float cachedCoeffs[14 * 2];
+    long long coeffReuseCount;
+    long long coeffEvaluateCount;
+    bool reuseCachedCoeffs(int numChannelPoints, float Yaw, float Pitch, float Roll, float *result);
+    void storeCachedCoeffs(int numChannelPoints, float Yaw, float Pitch, float Roll, const float *result);
+    
+    void spatialAlgo_4(float Yaw, float Pitch, float Roll, float *result);
+    std::vector<float> spatialAlgo_4(float Yaw, float Pitch, float Roll);
+
+    void spatialAlgo_8(float Yaw, float Pitch, float Roll, float *result);
+    std::vector<float> spatialAlgo_8(float Yaw, float Pitch, float Roll);
+
+    void spatialAlgo_14(float Yaw, float Pitch, float Roll, float *result);
+    std::vector<float> spatialAlgo_14(float Yaw, float Pitch, float Roll);
+
+    // log
+    std::vector<std::string> strLog;
+    void addToLog(std::string str, int maxCount = 100);
+
+    Mach1Point3D rotation;
+
+    // Timestamped rotations for the prediction stage, oldest first
+    Mach1Point3D rotationHistory[M1_ROTATION_HISTORY_SIZE];
+    double rotationHistoryTime[M1_ROTATION_HISTORY_SIZE];
+    int rotationHistoryCount;
+    double predictionTargetTime;
+    float predictionHorizon;
+
+  public:
+    char *getLog();
+    float filterSpeed;
+
+    // Angular settings functions
+    static void convertAnglesToMach1(Mach1PlatformType platformType, float *Y, float *P, float *R);
+    static void convertAnglesToPlatform(Mach1PlatformType platformType, float *Y, float *P, float *R);
+    // static void convertQuaternionToMach1(Mach1PlatformType platformType, float* X, float* Y, float* Z, float* W);
+    // static void convertQuaternionToPlatform(Mach1PlatformType platformType, float* Y, float* P, float* R);
+
+    Mach1Point3D getCurrentAngle();
+
+    M1DecodeCore();
+    // Leaves its filter bank, if any
+    ~M1DecodeCore();
+    // A copy takes the decoder state but not the filter bank lane, which stays with the original;
+    // assigning over a bound decoder leaves its bank first
+    M1DecodeCore(const M1DecodeCore &other);
+    M1DecodeCore &operator=(const M1DecodeCore &other);
+
+    // Back to the constructed state in place, keeping the capacity of internal buffers; also leaves its filter bank
+    void reset();
+
+    void setPlatformType(Mach1PlatformType type);
+    Mach1PlatformType getPlatformType();
+
+    int getFormatChannelCount();
+    int getFormatCoeffCount();
+
+    void setRotation(Mach1Point3D newRotationFromMinusOnetoOne);
+    void setRotationDegrees(Mach1Point3D newRotationDegrees);
+    void setRotationRadians(Mach1Point3D newRotationRadians);
+    void setRotationQuat(Mach1Point4D newRotationQuat);
+
+    // Prediction: rotations set with a timestamp feed an angular velocity estimate, and decoding
+    // extrapolates the last one to the target time (e.g. when the next buffer will be heard),
+    // at most maxSeconds ahead. setRotation* without a time clear the estimate.
+    // Times are in seconds on any clock shared by both calls; a horizon of 0 disables prediction
+
+    void setRotationDegreesAtTime(Mach1Point3D newRotationDegrees, double timeSeconds);
+    void setPredictionTargetTime(double timeSeconds);
+    void setPredictionHorizon(float maxSeconds);
+    float getPredictionHorizon();
+    Mach1Point3D getPredictedRotation();
+
+    void setFilterSpeed(float filterSpeed);
+
+    long getCurrentTime();
+    long getLastCalculationTime();
+
+    // Caller supplied clock in milliseconds for the angle filter, replaces the system clock until cleared
+    void setManualTime(long milliseconds);
+    void clearManualTime();
+
+    // Install another angle filter clock and return the current one, so decodes on a separate timeline
+    // (e.g. orientation queue timestamps) can run without disturbing the caller's clock or filter step
+    Mach1FilterClock swapFilterClock(Mach1FilterClock clock);
+
+    // Deterministic mode: self-contained polynomial trig instead of libm and only the time given to
+    // setManualTime() for the angle filter, so coefficients are reproducible across platforms (see Mach1DeterministicMath.h)
+    void setDeterministic(bool enable);
+    bool getDeterministic();
+
+    // Filter bank binding, managed by Mach1DecodeFilterBank::add()/remove()
+    void setFilterBank(Mach1DecodeFilterBank *bank, int lane);
+    // The angles the next decode will pass to the angle filter, after prediction, platform conversion and the pitch/roll locks
+    Mach1Point3D getFilterTarget();
+
+    // Set the algorithm type to use when decoding
+
+    void setDecodeMode(Mach1DecodeMode mode);
+    Mach1DecodeMode getDecodeMode();
+
+    // Evaluate a cheaper algorithm and transcode its coefficients back to the decode mode's channels
+    // (14 -> 8: each mid point folds into the 4 corners on its side, 8 -> 4: lower corners fold onto upper)
+    // Has no effect when it is not lower than the decode mode
+
+    void setReducedDecodeMode(Mach1DecodeMode mode);
+    Mach1DecodeMode getReducedDecodeMode();
+
+    // Lock the listener to the horizontal plane by ignoring its pitch and/or roll
+    // With both locked (or both zero) once filtered, Spatial_4 and Spatial_8 use a yaw-only kernel
+
+    void setUsePitchForRotation(bool usePitchForRotation);
+    bool getUsePitchForRotation();
+    void setUseRollForRotation(bool useRollForRotation);
+    bool getUseRollForRotation();
+
+    // Reuse the previous coefficients while the filtered yaw, pitch and roll all stay within
+    // thresholdDegrees of the orientation they were evaluated for (0 disables reuse)
+    // The reuse rate is the share of evaluations answered from the cache since the last reset
+
+    void setCoeffReuseThreshold(float thresholdDegrees);
+    float getCoeffReuseThreshold();
+    float getCoeffReuseRate();
+    void resetCoeffReuseRate();
+
+    // Decode using the current algorithm type
+
+    //  Order of input angles:
+    //  Y = Yaw in degrees
+    //  P = Pitch in degrees
+    //  R = Roll in degrees
+
+    std::vector<float> decode(float Yaw, float Pitch, float Roll, int bufferSize = 0, int sampleIndex = 0);
+    std::vector<float> decodeCoeffs(int bufferSize = 0, int sampleIndex = 0);
+    std::vector<float> decodePannedCoeffs(int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
+
+    // Decode using the current algorithm type in a more efficient way
+
+    void decode(float Yaw, float Pitch, float Roll, float *result, int bufferSize = 0, int sampleIndex = 0);
+    void decodeCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0);
+    void decodePannedCoeffs(float *result, int bufferSize = 0, int sampleIndex = 0, bool applyPanLaw = true);
+    void decodeCoeffsUsingTranscodeMatrix(void *M1obj, float *matrix, int channels, float *result, int bufferSize = 0, int sampleIndex = 0);
+
+    // Coefficients plus their derivatives per degree of yaw, pitch and roll at the filtered orientation,
+    // so gains can be extrapolated inside a block: coeff + dYaw * gradient[0 * n] + dPitch * gradient[1 * n] + dRoll * gradient[2 * n]
+    // gradient holds 3 * getFormatCoeffCount() floats (all d/dYaw, then all d/dPitch, then all d/dRoll)
+    // Always evaluates the full decode mode, the reduced decode mode and coefficient reuse are ignored
+    // The gains have a kink at pitch 0: there d/dPitch is the one-sided derivative towards positive pitch
+
+    void decodeCoeffsWithGradient(float *result, float *gradient);
+
+};
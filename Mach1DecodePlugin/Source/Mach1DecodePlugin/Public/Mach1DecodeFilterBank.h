@@ -0,0 +1,58 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This header file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+/*
+Angle filter state of many M1DecodeCore instances in structure of arrays form.
+
+A decoder added to the bank stops running its own updateAngles(). Instead update() gathers
+every decoder's target orientation, runs the envelope follower for all of them four lanes
+at a time with one clock value, and the decoders read their filtered angles back on their
+next decode. Per frame:
+
+    set each decoder's rotation -> bank.update(now) -> decode each decoder
+
+With the same targets and clock the filtered angles are identical to the per-instance
+filter's, pitch/roll locks included since both filter the locked target. A decoder leaves
+the bank when it is destroyed or reset, e.g. released back to a Mach1ObjectPool; the bank
+itself must outlive or clear() its decoders.
+*/
+
+#pragma once
+
+#include <vector>
+
+class M1DecodeCore;
+
+class Mach1DecodeFilterBank {
+
+  private:
+    std::vector<M1DecodeCore *> decoders;
+
+    // one entry per lane, padded to a multiple of 4
+    std::vector<float> targetYaw, targetPitch, targetRoll;
+    std::vector<float> currentYaw, currentPitch, currentRoll;
+    std::vector<float> filterSpeed;
+    std::vector<float> speedAngle;
+    std::vector<long> timeLastUpdate;
+
+    void resizeLanes(int count);
+
+  public:
+    // Binds the decoder to a lane, starting from its current filtered angles
+    int add(M1DecodeCore *decoder);
+    // Unbinds the decoder, the last lane moves into its place
+    void remove(M1DecodeCore *decoder);
+    void clear();
+
+    // Filters every lane toward its decoder's current target, time in milliseconds on any monotonic clock
+    void update(long currentTimeMilliseconds);
+
+    void getCurrentAngles(int lane, float &Yaw, float &Pitch, float &Roll) const;
+    int getCount() const;
+};
@@ -0,0 +1,177 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+Offline motion-to-gain latency measurement for Mach1Decode<float>::decodeBuffer.
+
+A simulated timeline renders a DC signal on the first input channel block by block while
+the listener's yaw steps between two angles at known times. Orientation reaches the decoder
+the way an application would deliver it: every updateInterval seconds, either as a rotation
+set before the next block (game thread tick) or pushed into an orientation queue (tracker
+thread). The angle filter runs on a manual clock that follows the rendered samples, so
+results do not depend on the speed of the machine running the harness.
+
+Latency of a step is the time from the step to the first output sample that crosses halfway
+between the settled gains before and after it. Steps that do not get there before the next
+step are counted as missed.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Mach1Decode.h"
+
+struct Mach1DecodeLatencyConfig {
+    Mach1DecodeMode decodeMode = M1DecodeSpatial_8;
+    float filterSpeed = 1.0f;
+    int bufferSize = 512;
+    int rampLength = 0;            // samples, 0 ramps across the whole block
+    float sampleRate = 48000;
+    float updateInterval = 0;      // seconds between orientation updates, 0 updates before every block
+    bool useOrientationQueue = false;
+    int steps = 64;
+    float stepAngle = 90;          // degrees of yaw between the two alternating orientations
+    float stepSpacing = 0.5f;      // seconds between steps, long enough for the filter to settle
+};
+
+struct Mach1DecodeLatencyResult {
+    float p50 = 0; // milliseconds
+    float p95 = 0;
+    float p99 = 0;
+    float max = 0;
+    int detected = 0;
+    int missed = 0;
+};
+
+class Mach1DecodeLatencyHarness {
+  public:
+    static Mach1DecodeLatencyResult measure(const Mach1DecodeLatencyConfig &config) {
+        Mach1DecodeLatencyResult result;
+        if (config.bufferSize <= 0 || config.sampleRate <= 0 || config.steps <= 0)
+            return result;
+
+        // settled gains of the measured output for both orientations
+        Mach1Decode<float> reference;
+        reference.setDecodeMode(config.decodeMode);
+        reference.setFilterSpeed(1.0f);
+        float settled[2];
+        for (int i = 0; i < 2; i++) {
+            reference.setRotationDegrees({i * config.stepAngle, 0, 0});
+            settled[i] = reference.decodeCoeffs()[0];
+        }
+        if (fabsf(settled[1] - settled[0]) < 1e-3f)
+            return result; // step is not visible on this output
+
+        Mach1Decode<float> decoder;
+        decoder.setDecodeMode(config.decodeMode);
+        decoder.setFilterSpeed(config.filterSpeed);
+        decoder.setRampLength(config.rampLength);
+
+        Mach1OrientationQueue queue;
+        if (config.useOrientationQueue) {
+            decoder.setOrientationQueue(&queue, config.sampleRate);
+            decoder.setBufferStartTime(0);
+        }
+
+        int channels = decoder.getFormatChannelCount();
+        std::vector<std::vector<float> > in(channels, std::vector<float>(config.bufferSize, 0));
+        std::vector<std::vector<float> > out(channels, std::vector<float>(config.bufferSize, 0));
+
+        // step times spread over the block and update phases with a fixed LCG so runs are repeatable
+        std::vector<double> stepTimes(config.steps);
+        unsigned int seed = 1;
+        for (int i = 0; i < config.steps; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            stepTimes[i] = config.stepSpacing * (i + 1) + (seed >> 8) * (0.05 / 16777216.0);
+        }
+
+        double blockLength = config.bufferSize / (double)config.sampleRate;
+        double endTime = stepTimes.back() + config.stepSpacing;
+        double nextUpdate = 0;
+        float appliedYaw = 0;
+
+        std::vector<float> latencies;
+        int step = -1;
+        bool stepDetected = true;
+
+        decoder.setRotationDegrees({0, 0, 0});
+
+        for (double blockTime = 0; blockTime < endTime; blockTime += blockLength) {
+            double blockEnd = blockTime + blockLength;
+
+            if (config.updateInterval <= 0) {
+                appliedYaw = yawAt(config, stepTimes, blockTime);
+                if (config.useOrientationQueue)
+                    queue.push(blockTime, {appliedYaw, 0, 0});
+            } else {
+                for (; nextUpdate < blockEnd; nextUpdate += config.updateInterval) {
+                    if (config.useOrientationQueue) {
+                        queue.push(nextUpdate, {yawAt(config, stepTimes, nextUpdate), 0, 0});
+                    } else if (nextUpdate <= blockTime) {
+                        appliedYaw = yawAt(config, stepTimes, nextUpdate);
+                    } else {
+                        break; // a tick inside the block is only seen by the next block
+                    }
+                }
+            }
+
+            if (!config.useOrientationQueue)
+                decoder.setRotationDegrees({appliedYaw, 0, 0});
+
+            // the filter clock follows the rendered audio, offset so it never reads 0 (unset)
+            decoder.setManualTime(1 + (long)(blockTime * 1000));
+
+            for (int c = 0; c < channels; c++)
+                std::fill(in[c].begin(), in[c].end(), c == 0 ? 1.0f : 0.0f);
+            decoder.decodeBuffer(in, out, config.bufferSize);
+
+            for (int s = 0; s < config.bufferSize; s++) {
+                double sampleTime = blockTime + s / (double)config.sampleRate;
+
+                while (step + 1 < config.steps && sampleTime >= stepTimes[step + 1]) {
+                    if (!stepDetected)
+                        result.missed++;
+                    step++;
+                    stepDetected = false;
+                }
+
+                if (step < 0 || stepDetected)
+                    continue;
+
+                float from = settled[step % 2];
+                float to = settled[(step + 1) % 2];
+                if ((out[0][s] - from) * (to - from) >= 0.5f * (to - from) * (to - from)) {
+                    latencies.push_back((float)((sampleTime - stepTimes[step]) * 1000));
+                    stepDetected = true;
+                }
+            }
+        }
+        if (!stepDetected)
+            result.missed++;
+
+        result.detected = (int)latencies.size();
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            result.p50 = percentile(latencies, 0.50f);
+            result.p95 = percentile(latencies, 0.95f);
+            result.p99 = percentile(latencies, 0.99f);
+            result.max = latencies.back();
+        }
+        return result;
+    }
+
+  private:
+    static float yawAt(const Mach1DecodeLatencyConfig &config, const std::vector<double> &stepTimes, double time) {
+        int passed = (int)(std::upper_bound(stepTimes.begin(), stepTimes.end(), time) - stepTimes.begin());
+        return (passed % 2) * config.stepAngle;
+    }
+
+    // nearest rank on sorted values
+    static float percentile(const std::vector<float> &sorted, float p) {
+        int rank = (int)ceilf(p * sorted.size());
+        return sorted[std::max(rank, 1) - 1];
+    }
+};
@@ -1,58 +1,75 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#pragma once
-
-#include <string>
-#include <vector>
-
-#include "Mach1DecodePositionalCAPI.h"
-
-class Mach1DecodePositional {
-    void *M1obj;
-
-  public:
-    Mach1DecodePositional();
-    ~Mach1DecodePositional();
-
-    void setPlatformType(Mach1PlatformType platformType);
-    void setDecodeMode(Mach1DecodeMode mode);
-
-    // settings
-    void setMuteWhenOutsideObject(bool muteWhenOutsideObject);
-    void setMuteWhenInsideObject(bool muteWhenInsideObject);
-
-    void setUseAttenuation(bool useAttenuation);
-    void setAttenuationCurve(float attenuationCurve);
-
-    void setUsePlaneCalculation(bool usePlaneCalculation);
-
-    void setUseYawForRotation(bool useYawForRotation);
-    void setUsePitchForRotation(bool usePitchForRotation);
-    void setUseRollForRotation(bool useRollForRotation);
-
-    void setListenerPosition(Mach1Point3D point);
-    void setListenerRotation(Mach1Point3D point);
-    void setListenerRotationQuat(Mach1Point4D quat);
-    void setDecoderAlgoPosition(Mach1Point3D point);
-    void setDecoderAlgoRotation(Mach1Point3D point);
-    void setDecoderAlgoRotationQuat(Mach1Point4D quat);
-    void setDecoderAlgoScale(Mach1Point3D point);
-
-    void evaluatePositionResults();
-
-#ifndef __EMSCRIPTEN__
-    void getCoefficients(float *result);
-#endif
-    void getCoefficients(std::vector<float> &result);
-
-    float getDist();
-    int getFormatChannelCount();
-    int getFormatCoeffCount();
-    Mach1Point3D getCurrentAngle();
-    Mach1Point3D getCurrentAngleInternal();
-    Mach1Point3D getPositionalRotation();
-    void setFilterSpeed(float filterSpeed);
-
-    Mach1Point3D getClosestPointOnPlane();
-};
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Mach1DecodePositionalCAPI.h"
+
+class Mach1DecodePositional {
+    void *M1obj;
+    void *M1pool;
+    int M1poolIndex;
+
+  public:
+    Mach1DecodePositional();
+    Mach1DecodePositional(void *M1pool);
+    ~Mach1DecodePositional();
+
+    void setPlatformType(Mach1PlatformType platformType);
+    void setDecodeMode(Mach1DecodeMode mode);
+    void setReducedDecodeMode(Mach1DecodeMode mode);
+
+    // settings
+    void setMuteWhenOutsideObject(bool muteWhenOutsideObject);
+    void setMuteWhenInsideObject(bool muteWhenInsideObject);
+
+    void setUseAttenuation(bool useAttenuation);
+    void setAttenuationCurve(float attenuationCurve);
+    void setAttenuationModel(Mach1AttenuationModel model);
+    void setAttenuationRange(float minDistance, float maxDistance);
+    void setAttenuationRolloff(float rolloff);
+    bool setAttenuationTable(const std::vector<float> &distances, const std::vector<float> &gains);
+    float getAttenuationGain();
+
+    void setOcclusionGain(float occlusionGain);
+    float getOcclusionGain();
+
+    void setUsePlaneCalculation(bool usePlaneCalculation);
+
+    void setUseYawForRotation(bool useYawForRotation);
+    void setUsePitchForRotation(bool usePitchForRotation);
+    void setUseRollForRotation(bool useRollForRotation);
+
+    void setListenerPosition(Mach1Point3D point);
+    void setListenerRotation(Mach1Point3D point);
+    void setListenerRotationQuat(Mach1Point4D quat);
+    void setDecoderAlgoPosition(Mach1Point3D point);
+    void setDecoderAlgoRotation(Mach1Point3D point);
+    void setDecoderAlgoRotationQuat(Mach1Point4D quat);
+    void setDecoderAlgoScale(Mach1Point3D point);
+
+    void evaluatePositionResults();
+
+#ifndef __EMSCRIPTEN__
+    void getCoefficients(float *result);
+#endif
+    void getCoefficients(std::vector<float> &result);
+
+    float getDist();
+    int getFormatChannelCount();
+    int getFormatCoeffCount();
+    Mach1Point3D getCurrentAngle();
+    Mach1Point3D getCurrentAngleInternal();
+    Mach1Point3D getPositionalRotation();
+    void setFilterSpeed(float filterSpeed);
+    void setCoeffReuseThreshold(float thresholdDegrees);
+    float getCoeffReuseRate();
+    void setDeterministic(bool enable);
+    bool getDeterministic();
+    void setManualTime(long milliseconds);
+
+    Mach1Point3D getClosestPointOnPlane();
+};
@@ -1,71 +1,103 @@
-//  Mach1 Spatial SDK
-//  Copyright © 2017 Mach1. All rights reserved.
-
-#pragma once
-
-#include "Mach1DecodeCAPI.h"
-
-#if defined(Mach1DecodeCore_h) || defined(Mach1EncodeCore_h) || defined(Mach1PositionalCore_h) || defined(Mach1TranscodeCore_h) || defined(Mach1AudioTimelineCore_h)
-#    ifndef M1_API
-#        if defined(_WINDOWS) || defined(_WIN32)
-#            define M1_API __declspec(dllexport)
-#        else
-#            define M1_API
-#        endif
-#    endif
-#else
-#    ifndef M1_API
-#        if !defined(M1_STATIC) && (defined(_WINDOWS) || defined(_WIN32))
-#            define M1_API __declspec(dllimport)
-#        else
-#            define M1_API
-#        endif
-#    endif
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-M1_API void *Mach1DecodePositionalCAPI_create();
-M1_API void Mach1DecodePositionalCAPI_delete(void *M1obj);
-
-M1_API void Mach1DecodePositionalCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType platformType);
-M1_API void Mach1DecodePositionalCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
-
-M1_API void Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(void *M1obj, bool muteWhenOutsideObject);
-M1_API void Mach1DecodePositionalCAPI_setMuteWhenInsideObject(void *M1obj, bool muteWhenInsideObject);
-
-M1_API void Mach1DecodePositionalCAPI_setUseAttenuation(void *M1obj, bool useAttenuation);
-M1_API void Mach1DecodePositionalCAPI_setAttenuationCurve(void *M1obj, float attenuationCurve);
-
-// Default uses `usePointCalculation`
-M1_API void Mach1DecodePositionalCAPI_setUsePlaneCalculation(void *M1obj, bool usePlaneCalculation);
-
-M1_API void Mach1DecodePositionalCAPI_setUseYawForRotation(void *M1obj, bool useYawForRotation);
-M1_API void Mach1DecodePositionalCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation);
-M1_API void Mach1DecodePositionalCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation);
-
-M1_API void Mach1DecodePositionalCAPI_setListenerPosition(void *M1obj, Mach1Point3D point);
-M1_API void Mach1DecodePositionalCAPI_setListenerRotation(void *M1obj, Mach1Point3D point);
-M1_API void Mach1DecodePositionalCAPI_setListenerRotationQuat(void *M1obj, Mach1Point4D point);
-M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoPosition(void *M1obj, Mach1Point3D point);
-M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoRotation(void *M1obj, Mach1Point3D point);
-M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(void *M1obj, Mach1Point4D point);
-M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoScale(void *M1obj, Mach1Point3D point);
-
-M1_API void Mach1DecodePositionalCAPI_evaluatePositionResults(void *M1obj);
-M1_API void Mach1DecodePositionalCAPI_getCoefficients(void *M1obj, float *result);
-M1_API float Mach1DecodePositionalCAPI_getDist(void *M1obj);
-M1_API int Mach1DecodePositionalCAPI_getFormatChannelCount(void *M1obj);
-M1_API int Mach1DecodePositionalCAPI_getFormatCoeffCount(void *M1obj);
-M1_API Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngle(void *M1obj);
-M1_API Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngleInternal(void *M1obj);
-M1_API Mach1Point3D Mach1DecodePositionalCAPI_getPositionalRotation(void *M1obj);
-M1_API void Mach1DecodePositionalCAPI_setFilterSpeed(void *M1obj, float filterSpeed);
-
-M1_API Mach1Point3D Mach1DecodePositionalCAPI_getClosestPointOnPlane(void *M1obj);
-
-M1_API long Mach1DecodePositionalCAPI_getLastCalculationTime(void *M1obj);
-#ifdef __cplusplus
-}
-#endif
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+#pragma once
+
+#include "Mach1DecodeCAPI.h"
+
+#if defined(Mach1DecodeCore_h) || defined(Mach1EncodeCore_h) || defined(Mach1PositionalCore_h) || defined(Mach1TranscodeCore_h) || defined(Mach1AudioTimelineCore_h)
+#    ifndef M1_API
+#        if defined(_WINDOWS) || defined(_WIN32)
+#            define M1_API __declspec(dllexport)
+#        else
+#            define M1_API
+#        endif
+#    endif
+#else
+#    ifndef M1_API
+#        if !defined(M1_STATIC) && (defined(_WINDOWS) || defined(_WIN32))
+#            define M1_API __declspec(dllimport)
+#        else
+#            define M1_API
+#        endif
+#    endif
+#endif
+
+enum Mach1AttenuationModel {
+    Mach1AttenuationCurve = (int)0, // gain is the value last passed to setAttenuationCurve
+    Mach1AttenuationInverse,
+    Mach1AttenuationLinear,
+    Mach1AttenuationExponential,
+    Mach1AttenuationTable,
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+M1_API void *Mach1DecodePositionalCAPI_create();
+M1_API void Mach1DecodePositionalCAPI_delete(void *M1obj);
+
+// Pooled decoders: slots are reserved up front in one contiguous arena and handed out by index
+M1_API void *Mach1DecodePositionalCAPI_createPool(int capacity);
+M1_API void Mach1DecodePositionalCAPI_deletePool(void *M1pool);
+M1_API int Mach1DecodePositionalCAPI_poolAcquire(void *M1pool);
+M1_API void Mach1DecodePositionalCAPI_poolRelease(void *M1pool, int index);
+M1_API void *Mach1DecodePositionalCAPI_poolGet(void *M1pool, int index);
+M1_API int Mach1DecodePositionalCAPI_poolGetIndex(void *M1pool, void *M1obj);
+M1_API int Mach1DecodePositionalCAPI_poolGetCapacity(void *M1pool);
+M1_API int Mach1DecodePositionalCAPI_poolGetActiveCount(void *M1pool);
+
+M1_API void Mach1DecodePositionalCAPI_setPlatformType(void *M1obj, enum Mach1PlatformType platformType);
+M1_API void Mach1DecodePositionalCAPI_setDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
+M1_API void Mach1DecodePositionalCAPI_setReducedDecodeMode(void *M1obj, enum Mach1DecodeMode mode);
+
+M1_API void Mach1DecodePositionalCAPI_setMuteWhenOutsideObject(void *M1obj, bool muteWhenOutsideObject);
+M1_API void Mach1DecodePositionalCAPI_setMuteWhenInsideObject(void *M1obj, bool muteWhenInsideObject);
+
+M1_API void Mach1DecodePositionalCAPI_setUseAttenuation(void *M1obj, bool useAttenuation);
+M1_API void Mach1DecodePositionalCAPI_setAttenuationCurve(void *M1obj, float attenuationCurve);
+M1_API void Mach1DecodePositionalCAPI_setAttenuationModel(void *M1obj, enum Mach1AttenuationModel model);
+M1_API void Mach1DecodePositionalCAPI_setAttenuationRange(void *M1obj, float minDistance, float maxDistance);
+M1_API void Mach1DecodePositionalCAPI_setAttenuationRolloff(void *M1obj, float rolloff);
+M1_API bool Mach1DecodePositionalCAPI_setAttenuationTable(void *M1obj, float *distances, float *gains, int count);
+M1_API float Mach1DecodePositionalCAPI_getAttenuationGain(void *M1obj);
+
+M1_API void Mach1DecodePositionalCAPI_setOcclusionGain(void *M1obj, float occlusionGain);
+M1_API float Mach1DecodePositionalCAPI_getOcclusionGain(void *M1obj);
+
+// Default uses `usePointCalculation`
+M1_API void Mach1DecodePositionalCAPI_setUsePlaneCalculation(void *M1obj, bool usePlaneCalculation);
+
+M1_API void Mach1DecodePositionalCAPI_setUseYawForRotation(void *M1obj, bool useYawForRotation);
+M1_API void Mach1DecodePositionalCAPI_setUsePitchForRotation(void *M1obj, bool usePitchForRotation);
+M1_API void Mach1DecodePositionalCAPI_setUseRollForRotation(void *M1obj, bool useRollForRotation);
+
+M1_API void Mach1DecodePositionalCAPI_setListenerPosition(void *M1obj, Mach1Point3D point);
+M1_API void Mach1DecodePositionalCAPI_setListenerRotation(void *M1obj, Mach1Point3D point);
+M1_API void Mach1DecodePositionalCAPI_setListenerRotationQuat(void *M1obj, Mach1Point4D point);
+M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoPosition(void *M1obj, Mach1Point3D point);
+M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoRotation(void *M1obj, Mach1Point3D point);
+M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoRotationQuat(void *M1obj, Mach1Point4D point);
+M1_API void Mach1DecodePositionalCAPI_setDecoderAlgoScale(void *M1obj, Mach1Point3D point);
+
+M1_API void Mach1DecodePositionalCAPI_evaluatePositionResults(void *M1obj);
+M1_API void Mach1DecodePositionalCAPI_getCoefficients(void *M1obj, float *result);
+M1_API float Mach1DecodePositionalCAPI_getDist(void *M1obj);
+M1_API int Mach1DecodePositionalCAPI_getFormatChannelCount(void *M1obj);
+M1_API int Mach1DecodePositionalCAPI_getFormatCoeffCount(void *M1obj);
+M1_API Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngle(void *M1obj);
+M1_API Mach1Point3D Mach1DecodePositionalCAPI_getCurrentAngleInternal(void *M1obj);
+M1_API Mach1Point3D Mach1DecodePositionalCAPI_getPositionalRotation(void *M1obj);
+M1_API void Mach1DecodePositionalCAPI_setFilterSpeed(void *M1obj, float filterSpeed);
+M1_API void Mach1DecodePositionalCAPI_setCoeffReuseThreshold(void *M1obj, float thresholdDegrees);
+M1_API float Mach1DecodePositionalCAPI_getCoeffReuseRate(void *M1obj);
+M1_API void Mach1DecodePositionalCAPI_setDeterministic(void *M1obj, bool enable);
+M1_API bool Mach1DecodePositionalCAPI_getDeterministic(void *M1obj);
+M1_API void Mach1DecodePositionalCAPI_setManualTime(void *M1obj, long milliseconds);
+
+M1_API Mach1Point3D Mach1DecodePositionalCAPI_getClosestPointOnPlane(void *M1obj);
+
+M1_API long Mach1DecodePositionalCAPI_getLastCalculationTime(void *M1obj);
+#ifdef __cplusplus
+}
+#endif
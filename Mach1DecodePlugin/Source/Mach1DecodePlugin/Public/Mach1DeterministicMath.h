@@ -0,0 +1,208 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+Self-contained float math for the deterministic decode mode.
+
+Every function is built only from IEEE 754 single precision +, -, *, /, sqrt, floor and exact
+exponent manipulation (frexp/ldexp), evaluated in a fixed order, so the same inputs give the
+same bits on every platform. The polynomials follow the Cephes single precision kernels
+(about 1-2 ulp), in place of the platform libm whose sinf/cosf/atan2f/powf differ between
+MSVC, Bionic, glibc and Apple.
+
+Bit identical results also need the compiler to keep the written evaluation order. Code between
+M1_DETERMINISTIC_FP_BEGIN and M1_DETERMINISTIC_FP_END is compiled without FMA contraction or
+fast-math reassociation; the regions push and pop the floating point state, so nothing leaks into
+the rest of a unity or PCH build. They wrap the functions below and the decode kernels in
+Mach1DecodeCore.cpp and Mach1DecodePositionalCore.cpp, the latter opening its region before it
+includes glm. Inline code first parsed outside a region (e.g. in the engine's PCH) keeps the
+build's own settings.
+
+Only verified bit identical with GCC on x86-64, across -O0 to -O3, -mfma -ffp-contract=fast and
+-ffast-math. The MSVC and clang pragmas are the documented equivalents but are untested.
+*/
+
+#pragma once
+
+#ifndef M1_DETERMINISTIC_FP
+#    define M1_DETERMINISTIC_FP 1
+#endif
+
+#if M1_DETERMINISTIC_FP
+#    if defined(_MSC_VER) && !defined(__clang__)
+// fp_contract has no push of its own, it is left off like the /fp:precise default
+#        define M1_DETERMINISTIC_FP_BEGIN __pragma(float_control(push)) __pragma(float_control(precise, on)) __pragma(fp_contract(off))
+#        define M1_DETERMINISTIC_FP_END __pragma(float_control(pop))
+#    elif defined(__clang__)
+#        define M1_DETERMINISTIC_FP_BEGIN _Pragma("float_control(push)") _Pragma("float_control(precise, on)") _Pragma("clang fp contract(off)")
+#        define M1_DETERMINISTIC_FP_END _Pragma("float_control(pop)")
+#    elif defined(__GNUC__)
+#        define M1_DETERMINISTIC_FP_BEGIN _Pragma("GCC push_options") _Pragma("GCC optimize(\"no-fast-math\", \"fp-contract=off\")")
+#        define M1_DETERMINISTIC_FP_END _Pragma("GCC pop_options")
+#    endif
+#endif
+
+#ifndef M1_DETERMINISTIC_FP_BEGIN
+#    define M1_DETERMINISTIC_FP_BEGIN
+#    define M1_DETERMINISTIC_FP_END
+#endif
+
+#include <cmath>
+
+M1_DETERMINISTIC_FP_BEGIN
+
+#define M1_DET_PI_F 3.14159265358979323846f
+
+// sin and cos of an angle in radians, |x| < 8192 for full accuracy
+inline void m1DetSinCos(float x, float &s, float &c) {
+    const float FOPI = 1.27323954473516f; // 4 / pi
+    const float DP1 = 0.78515625f;        // pi / 4 split in three parts so y * DP1 and y * DP2 are exact
+    const float DP2 = 2.4187564849853515625e-4f;
+    const float DP3 = 3.77489497744594108e-8f;
+
+    float sign = 1;
+    if (x < 0) {
+        x = -x;
+        sign = -1;
+    }
+
+    int j = (int)(x * FOPI);
+    float y = (float)j;
+    if (j & 1) {
+        j += 1;
+        y += 1;
+    }
+    j &= 7;
+
+    // octants 4-7 are octants 0-3 with both signs flipped
+    float signSin = sign;
+    float signCos = 1;
+    if (j > 3) {
+        j -= 4;
+        signSin = -signSin;
+        signCos = -signCos;
+    }
+    if (j > 1) {
+        signCos = -signCos;
+    }
+
+    x = ((x - y * DP1) - y * DP2) - y * DP3;
+    float z = x * x;
+
+    float polySin = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+    float polyCos = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+    if (j == 1 || j == 2) {
+        s = signSin * polyCos;
+        c = signCos * polySin;
+    } else {
+        s = signSin * polySin;
+        c = signCos * polyCos;
+    }
+}
+
+inline float m1DetSin(float x) {
+    float s, c;
+    m1DetSinCos(x, s, c);
+    return s;
+}
+
+inline float m1DetCos(float x) {
+    float s, c;
+    m1DetSinCos(x, s, c);
+    return c;
+}
+
+inline float m1DetAtan(float x) {
+    float sign = 1;
+    if (x < 0) {
+        x = -x;
+        sign = -1;
+    }
+
+    float y = 0;
+    if (x > 2.414213562373095f) { // tan(3 pi / 8)
+        y = M1_DET_PI_F / 2;
+        x = -1.0f / x;
+    } else if (x > 0.4142135623730950f) { // tan(pi / 8)
+        y = M1_DET_PI_F / 4;
+        x = (x - 1.0f) / (x + 1.0f);
+    }
+
+    float z = x * x;
+    y += (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * x + x;
+    return sign * y;
+}
+
+inline float m1DetAtan2(float y, float x) {
+    if (x == 0) {
+        if (y > 0)
+            return M1_DET_PI_F / 2;
+        if (y < 0)
+            return -M1_DET_PI_F / 2;
+        return 0;
+    }
+
+    float a = m1DetAtan(y / x);
+    if (x < 0) {
+        a += (y < 0) ? -M1_DET_PI_F : M1_DET_PI_F;
+    }
+    return a;
+}
+
+inline float m1DetAsin(float x) {
+    if (x >= 1)
+        return M1_DET_PI_F / 2;
+    if (x <= -1)
+        return -M1_DET_PI_F / 2;
+    return m1DetAtan2(x, sqrtf((1 - x) * (1 + x)));
+}
+
+// natural log, x > 0
+inline float m1DetLog(float x) {
+    if (x <= 0)
+        return -INFINITY;
+
+    int e;
+    x = frexpf(x, &e);
+    if (x < 0.707106781186547524f) { // sqrt(1/2)
+        e -= 1;
+        x = x + x - 1.0f;
+    } else {
+        x = x - 1.0f;
+    }
+
+    float z = x * x;
+    float y = ((((((((7.0376836292e-2f * x - 1.1514610310e-1f) * x + 1.1676998740e-1f) * x - 1.2420140846e-1f) * x + 1.4249322787e-1f) * x - 1.6668057665e-1f) * x + 2.0000714765e-1f) * x - 2.4999993993e-1f) * x + 3.3333331174e-1f) * x * z;
+
+    float fe = (float)e;
+    y += -2.12194440e-4f * fe;
+    y += -0.5f * z;
+    x = x + y;
+    x += 0.693359375f * fe;
+    return x;
+}
+
+inline float m1DetExp(float x) {
+    if (x > 88.72283905206835f)
+        return INFINITY;
+    if (x < -103.278929903431851103f)
+        return 0;
+
+    float z = floorf(1.44269504088896341f * x + 0.5f);
+    x = (x - z * 0.693359375f) - z * -2.12194440e-4f;
+    int n = (int)z;
+
+    float xx = x * x;
+    float p = (((((1.9875691500e-4f * x + 1.3981999507e-3f) * x + 8.3334519073e-3f) * x + 4.1665795894e-2f) * x + 1.6666665459e-1f) * x + 5.0000001201e-1f) * xx + x + 1.0f;
+    return ldexpf(p, n);
+}
+
+// base > 0
+inline float m1DetPow(float base, float exponent) {
+    if (exponent == 0)
+        return 1;
+    return m1DetExp(exponent * m1DetLog(base));
+}
+
+M1_DETERMINISTIC_FP_END
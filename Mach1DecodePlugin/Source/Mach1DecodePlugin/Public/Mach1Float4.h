@@ -0,0 +1,131 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+Minimal 4-wide float vector used by the batch kernels.
+
+Maps to SSE2 on x86/x64, NEON on AArch64 and falls back to plain arrays elsewhere.
+Comparison results are full bit masks stored in a Mach1Float4 and are consumed by
+m1Select4() / m1MoveMask4().
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define M1_SIMD_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define M1_SIMD_NEON 1
+#endif
+
+struct Mach1Float4 {
+#if defined(M1_SIMD_SSE)
+    __m128 v;
+#elif defined(M1_SIMD_NEON)
+    float32x4_t v;
+#else
+    float v[4];
+#endif
+};
+
+#if defined(M1_SIMD_SSE)
+
+inline Mach1Float4 m1Load4(const float *p) { return {_mm_loadu_ps(p)}; }
+inline void m1Store4(float *p, Mach1Float4 a) { _mm_storeu_ps(p, a.v); }
+inline Mach1Float4 m1Set4(float f) { return {_mm_set1_ps(f)}; }
+inline Mach1Float4 m1Add4(Mach1Float4 a, Mach1Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Sub4(Mach1Float4 a, Mach1Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Mul4(Mach1Float4 a, Mach1Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Div4(Mach1Float4 a, Mach1Float4 b) { return {_mm_div_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Min4(Mach1Float4 a, Mach1Float4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Max4(Mach1Float4 a, Mach1Float4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Sqrt4(Mach1Float4 a) { return {_mm_sqrt_ps(a.v)}; }
+inline Mach1Float4 m1Abs4(Mach1Float4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline Mach1Float4 m1Trunc4(Mach1Float4 a) { return {_mm_cvtepi32_ps(_mm_cvttps_epi32(a.v))}; } // |a| < 2^31
+inline Mach1Float4 m1CmpLt4(Mach1Float4 a, Mach1Float4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mach1Float4 m1CmpLe4(Mach1Float4 a, Mach1Float4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mach1Float4 m1CmpGt4(Mach1Float4 a, Mach1Float4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mach1Float4 m1And4(Mach1Float4 a, Mach1Float4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Or4(Mach1Float4 a, Mach1Float4 b) { return {_mm_or_ps(a.v, b.v)}; }
+inline Mach1Float4 m1Select4(Mach1Float4 mask, Mach1Float4 a, Mach1Float4 b) { return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))}; }
+inline int m1MoveMask4(Mach1Float4 mask) { return _mm_movemask_ps(mask.v); }
+
+#elif defined(M1_SIMD_NEON)
+
+inline Mach1Float4 m1Load4(const float *p) { return {vld1q_f32(p)}; }
+inline void m1Store4(float *p, Mach1Float4 a) { vst1q_f32(p, a.v); }
+inline Mach1Float4 m1Set4(float f) { return {vdupq_n_f32(f)}; }
+inline Mach1Float4 m1Add4(Mach1Float4 a, Mach1Float4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Sub4(Mach1Float4 a, Mach1Float4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Mul4(Mach1Float4 a, Mach1Float4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Div4(Mach1Float4 a, Mach1Float4 b) { return {vdivq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Min4(Mach1Float4 a, Mach1Float4 b) { return {vminq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Max4(Mach1Float4 a, Mach1Float4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline Mach1Float4 m1Sqrt4(Mach1Float4 a) { return {vsqrtq_f32(a.v)}; }
+inline Mach1Float4 m1Abs4(Mach1Float4 a) { return {vabsq_f32(a.v)}; }
+inline Mach1Float4 m1Trunc4(Mach1Float4 a) { return {vcvtq_f32_s32(vcvtq_s32_f32(a.v))}; } // |a| < 2^31
+inline Mach1Float4 m1CmpLt4(Mach1Float4 a, Mach1Float4 b) { return {vreinterpretq_f32_u32(vcltq_f32(a.v, b.v))}; }
+inline Mach1Float4 m1CmpLe4(Mach1Float4 a, Mach1Float4 b) { return {vreinterpretq_f32_u32(vcleq_f32(a.v, b.v))}; }
+inline Mach1Float4 m1CmpGt4(Mach1Float4 a, Mach1Float4 b) { return {vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v))}; }
+inline Mach1Float4 m1And4(Mach1Float4 a, Mach1Float4 b) { return {vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))}; }
+inline Mach1Float4 m1Or4(Mach1Float4 a, Mach1Float4 b) { return {vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))}; }
+inline Mach1Float4 m1Select4(Mach1Float4 mask, Mach1Float4 a, Mach1Float4 b) { return {vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v)}; }
+inline int m1MoveMask4(Mach1Float4 mask) {
+    uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask.v), 31);
+    return (int)(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+}
+
+#else
+
+inline float m1MaskBits4(bool b) {
+    uint32_t bits = b ? 0xFFFFFFFFu : 0u;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline uint32_t m1LaneBits4(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+#    define M1_FLOAT4_LANEWISE(expr) \
+        Mach1Float4 r;               \
+        for (int i = 0; i < 4; i++)  \
+            r.v[i] = (expr);         \
+        return r;
+
+inline Mach1Float4 m1Load4(const float *p) { M1_FLOAT4_LANEWISE(p[i]) }
+inline void m1Store4(float *p, Mach1Float4 a) { memcpy(p, a.v, sizeof(a.v)); }
+inline Mach1Float4 m1Set4(float f) { M1_FLOAT4_LANEWISE(f) }
+inline Mach1Float4 m1Add4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] + b.v[i]) }
+inline Mach1Float4 m1Sub4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] - b.v[i]) }
+inline Mach1Float4 m1Mul4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] * b.v[i]) }
+inline Mach1Float4 m1Div4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] / b.v[i]) }
+inline Mach1Float4 m1Min4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] < b.v[i] ? a.v[i] : b.v[i]) }
+inline Mach1Float4 m1Max4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(a.v[i] > b.v[i] ? a.v[i] : b.v[i]) }
+inline Mach1Float4 m1Sqrt4(Mach1Float4 a) { M1_FLOAT4_LANEWISE(sqrtf(a.v[i])) }
+inline Mach1Float4 m1Abs4(Mach1Float4 a) { M1_FLOAT4_LANEWISE(fabsf(a.v[i])) }
+inline Mach1Float4 m1Trunc4(Mach1Float4 a) { M1_FLOAT4_LANEWISE(truncf(a.v[i])) }
+inline Mach1Float4 m1CmpLt4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1MaskBits4(a.v[i] < b.v[i])) }
+inline Mach1Float4 m1CmpLe4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1MaskBits4(a.v[i] <= b.v[i])) }
+inline Mach1Float4 m1CmpGt4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1MaskBits4(a.v[i] > b.v[i])) }
+inline Mach1Float4 m1And4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1MaskBits4((m1LaneBits4(a.v[i]) & m1LaneBits4(b.v[i])) != 0)) }
+inline Mach1Float4 m1Or4(Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1MaskBits4((m1LaneBits4(a.v[i]) | m1LaneBits4(b.v[i])) != 0)) }
+inline Mach1Float4 m1Select4(Mach1Float4 mask, Mach1Float4 a, Mach1Float4 b) { M1_FLOAT4_LANEWISE(m1LaneBits4(mask.v[i]) ? a.v[i] : b.v[i]) }
+inline int m1MoveMask4(Mach1Float4 mask) {
+    int bits = 0;
+    for (int i = 0; i < 4; i++)
+        bits |= (m1LaneBits4(mask.v[i]) >> 31) << i;
+    return bits;
+}
+
+#    undef M1_FLOAT4_LANEWISE
+
+#endif
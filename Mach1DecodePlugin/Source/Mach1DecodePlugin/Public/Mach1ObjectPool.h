@@ -0,0 +1,87 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+Fixed capacity pool of decoder objects.
+
+All slots are constructed once, in one contiguous allocation, when the pool is created.
+acquire()/release() only move indices on a free list, so handing out and returning
+decoders never touches the general purpose heap. A released slot is put back to its
+constructed state with T::reset(), which reinitializes the object in place and keeps the
+capacity of any internal buffers the slot already grew.
+
+Indices are stable for the lifetime of the pool. The pool is not thread safe.
+*/
+
+#pragma once
+
+#include <vector>
+
+template <typename T>
+class Mach1ObjectPool {
+  public:
+    explicit Mach1ObjectPool(int capacity) {
+        if (capacity < 0)
+            capacity = 0;
+
+        objects.resize(capacity);
+        active.assign(capacity, 0);
+
+        freeIndices.reserve(capacity);
+        for (int i = capacity - 1; i >= 0; i--) {
+            freeIndices.push_back(i);
+        }
+    }
+
+    // Returns the index of a slot in its constructed state, or -1 if the pool is exhausted
+    int acquire() {
+        if (freeIndices.empty())
+            return -1;
+
+        int index = freeIndices.back();
+        freeIndices.pop_back();
+        active[index] = 1;
+
+        return index;
+    }
+
+    bool release(int index) {
+        if (!isActive(index))
+            return false;
+
+        objects[index].reset();
+        active[index] = 0;
+        freeIndices.push_back(index);
+        return true;
+    }
+
+    T *get(int index) {
+        return isActive(index) ? &objects[index] : nullptr;
+    }
+
+    // Returns the slot index of an object handed out by this pool, or -1
+    int indexOf(const void *obj) const {
+        if (objects.empty() || obj < (const void *)objects.data() || obj >= (const void *)(objects.data() + objects.size()))
+            return -1;
+
+        int index = (int)((const T *)obj - objects.data());
+        return active[index] ? index : -1;
+    }
+
+    bool isActive(int index) const {
+        return index >= 0 && index < (int)objects.size() && active[index];
+    }
+
+    int getCapacity() const {
+        return (int)objects.size();
+    }
+
+    int getActiveCount() const {
+        return (int)(objects.size() - freeIndices.size());
+    }
+
+  private:
+    std::vector<T> objects;
+    std::vector<unsigned char> active;
+    std::vector<int> freeIndices;
+};
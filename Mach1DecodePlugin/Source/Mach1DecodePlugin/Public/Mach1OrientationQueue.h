@@ -0,0 +1,95 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+Single producer, single consumer queue of timestamped orientations.
+
+A head tracker or game thread push()es samples as they arrive, an audio thread pops them
+inside Mach1Decode<PCM>::decodeBuffer to place gain breakpoints at the sample offset each
+orientation belongs to. Neither side locks or allocates: the ring is sized once on
+construction (rounded up to a power of two) and the two indices are only advanced by
+their owning thread.
+
+Times are in seconds on a clock shared by the producer and the decodeBuffer start time.
+push() fails when the consumer has fallen a full ring behind; the newest sample is dropped
+rather than overwriting one the consumer may be reading.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "Mach1Point3D.h"
+
+struct Mach1OrientationSample {
+    double time;
+    Mach1Point3D rotationDegrees;
+};
+
+class Mach1OrientationQueue {
+  public:
+    explicit Mach1OrientationQueue(int capacity = 1024) {
+        int size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        samples.resize(size);
+        mask = size - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    // Producer thread only
+    bool push(const Mach1OrientationSample &sample) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) > mask)
+            return false;
+
+        samples[currentTail & mask] = sample;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(double time, Mach1Point3D rotationDegrees) {
+        Mach1OrientationSample sample;
+        sample.time = time;
+        sample.rotationDegrees = rotationDegrees;
+        return push(sample);
+    }
+
+    // Consumer thread only: look at the oldest sample without removing it
+    bool peek(Mach1OrientationSample &sample) const {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+            return false;
+
+        sample = samples[currentHead & mask];
+        return true;
+    }
+
+    // Consumer thread only
+    bool pop(Mach1OrientationSample &sample) {
+        if (!peek(sample))
+            return false;
+
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    void clear() {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    int getCapacity() const {
+        return (int)samples.size();
+    }
+
+  private:
+    std::vector<Mach1OrientationSample> samples;
+    size_t mask;
+
+    std::atomic<size_t> head; // next sample to read, written by the consumer
+    std::atomic<size_t> tail; // next slot to write, written by the producer
+};
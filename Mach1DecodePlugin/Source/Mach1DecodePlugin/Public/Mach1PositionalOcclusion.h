@@ -0,0 +1,52 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This header file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+/*
+Occlusion stage for positional decoders.
+
+Occluders are oriented boxes with a transmission factor (0 blocks, 1 passes). Each
+listener->emitter segment gathers candidate occluders from a Mach1PositionalSpatialIndex
+and clips against all of them at once with Mach1DecodePositionalCore::ClipSegmentAgainstBoxes().
+The product of the transmissions of every box the segment crosses is the emitter's
+occlusion factor, to be passed to Mach1DecodePositional::setOcclusionGain().
+*/
+
+#pragma once
+
+#include "Mach1DecodePositionalCore.h"
+#include "Mach1PositionalSpatialIndex.h"
+#include <vector>
+
+class Mach1PositionalOcclusion {
+
+  private:
+    Mach1PositionalSpatialIndex index;
+    Mach1OrientedBoxArray occluders;
+    std::vector<float> transmissions;
+
+    // scratch reused between segments
+    std::vector<int> candidates;
+    Mach1OrientedBoxArray candidateBoxes;
+    std::vector<unsigned char> hits;
+
+  public:
+    // cellSize of the occluder index in world units, see Mach1PositionalSpatialIndex
+    explicit Mach1PositionalOcclusion(float cellSize);
+
+    int addOccluder(glm::vec3 center, glm::quat rotation, glm::vec3 scale, float transmission);
+    void updateOccluder(int handle, glm::vec3 center, glm::quat rotation, glm::vec3 scale);
+    void setOccluderTransmission(int handle, float transmission);
+    void removeOccluder(int handle);
+    void clear();
+
+    int getOccluderCount() const;
+
+    float evaluate(glm::vec3 listener, glm::vec3 emitter);
+    void evaluate(glm::vec3 listener, const glm::vec3 *emitters, int count, float *occlusionFactors);
+};
@@ -0,0 +1,81 @@
+//  Mach1 Spatial SDK
+//  Copyright © 2017 Mach1. All rights reserved.
+
+/*
+DISCLAIMER:
+This header file is not an example of use but an decoder that will require periodic
+updates and should not be integrated in sections but remain as an update-able factored file.
+*/
+
+/*
+Loose uniform grid over positional emitter bounds.
+
+Every emitter is bucketed by the cell containing its center; a cell's loose bounds are the
+cell grown by half a cell on each side, so any emitter whose half extents fit in half a cell
+never spans more than one bucket. Larger emitters are kept in a separate list and tested
+linearly. Moving an emitter only touches its own bucket(s), and a query only visits cells
+that overlap the listener's audible radius.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/common.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/vec3.hpp>
+
+class Mach1PositionalSpatialIndex {
+
+  private:
+    struct Entry {
+        glm::vec3 center;
+        glm::vec3 halfExtents;
+        int64_t cell;
+        int slot;
+        bool oversized;
+        bool active;
+    };
+
+    float cellSize;
+    std::vector<Entry> entries;
+    std::vector<int> freeHandles;
+    std::unordered_map<int64_t, std::vector<int>> cells;
+    std::vector<int> oversized;
+    int activeCount;
+
+    int64_t cellKey(int x, int y, int z) const;
+    glm::ivec3 cellCoord(glm::vec3 position) const;
+    bool fitsCell(glm::vec3 halfExtents) const;
+
+    void link(int handle);
+    void unlink(int handle);
+
+    static bool overlapsSphere(const Entry &entry, glm::vec3 position, float radiusSquared);
+
+  public:
+    // Cell edge in world units, no default since scenes range from meters to centimeters; pick it about the
+    // query radius. Emitters with half extents above cellSize / 2 are kept in the oversized list
+    explicit Mach1PositionalSpatialIndex(float cellSize);
+
+    void setCellSize(float cellSize);
+    float getCellSize() const;
+
+    // returns a handle that stays valid until remove()
+    int insert(glm::vec3 center, glm::vec3 halfExtents);
+    void update(int handle, glm::vec3 center, glm::vec3 halfExtents);
+    void remove(int handle);
+    void clear();
+
+    // Appends the handles of every emitter whose bounds are within `radius` of `position`, returns the count appended
+    int query(glm::vec3 position, float radius, std::vector<int> &results) const;
+
+    int getCount() const;
+    int getOversizedCount() const;
+
+    // world-space half extents of a box with the given rotation and full scale, as used by Mach1DecodePositional
+    static glm::vec3 OrientedBoxHalfExtents(glm::quat rotation, glm::vec3 scale);
+};